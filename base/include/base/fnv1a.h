@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+/// 64-битный FNV-1a: быстрый некриптографический хеш для ключей и
+/// отпечатков параметров.
+[[nodiscard]] constexpr std::uint64_t Fnv1a(std::string_view data) noexcept {
+  constexpr std::uint64_t kOffsetBasis = 14695981039346656037ULL;
+  constexpr std::uint64_t kPrime = 1099511628211ULL;
+
+  auto hash = kOffsetBasis;
+  for (const auto c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= kPrime;
+  }
+  return hash;
+}
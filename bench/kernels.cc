@@ -0,0 +1,197 @@
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <format>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/config/float.h"
+#include "base/erase_remove_if.h"
+#include "math/fast_pow.h"
+#include "math/linalg/vector.h"
+#include "modeling/fibonacci_sphere.h"
+#include "modeling/hollow_cylinder.h"
+#include "modeling/solid_cylinder.h"
+#include "perf_counters.h"
+#include "physics/params/air.h"
+#include "physics/params/plasma.h"
+#include "physics/params/quartz.h"
+#include "physics/params/xenon_absorption_coefficient.h"
+#include "physics/plancks_law.h"
+#include "ray_tracing/cylinder_z_infinite.h"
+
+namespace {
+
+constexpr auto kR = 0.35_F;
+constexpr auto kDelta = 0.1_F;
+constexpr std::size_t kNPlasma = 40;
+constexpr std::size_t kNQuartz = 15;
+constexpr auto kT0 = 10000.0_F;
+constexpr auto kTW = 2000.0_F;
+constexpr auto kT1 = 700.0_F;
+constexpr std::size_t kBand = 169;
+
+struct Args {
+  std::size_t n = 100;  ///< Сетка направлений n x n.
+  std::size_t repeats = 5;
+};
+
+class Kernels {
+ public:
+  explicit Kernels(const Args& args)
+      : args_{args}, counters_{PerfCounters::FromEnv()} {
+    std::cout << std::format("# n {}x{}, best of {}\n", args.n, args.n,
+                             args.repeats);
+    std::cout << std::format("{:<20} {:>10} {:>11} {:>9}", "kernel", "calls",
+                             "total_s", "ns/call");
+    if (counters_) {
+      std::cout << PerfCounters::Header();
+    }
+    std::cout << '\n';
+  }
+
+  /// Замеряет func() лучший из repeats раз; func возвращает число вызовов.
+  template <typename Func>
+  void Measure(std::string_view name, Func&& func) {
+    auto best = std::numeric_limits<double>::infinity();
+    std::size_t calls{};
+    PerfCounters::Sample best_sample;
+    for (std::size_t i = 0; i < args_.repeats; ++i) {
+      if (counters_) {
+        counters_->Start();
+      }
+      const auto start = std::chrono::steady_clock::now();
+      calls = func();
+      const auto total = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+      const auto sample =
+          counters_ ? counters_->Stop() : PerfCounters::Sample{};
+      if (total < best) {
+        best = total;
+        best_sample = sample;
+      }
+    }
+
+    std::cout << std::format("{:<20} {:>10} {:>11.6f} {:>9.1f}", name, calls,
+                             best,
+                             best * 1e9 / static_cast<double>(calls));
+    if (counters_) {
+      std::cout << PerfCounters::Format(best_sample);
+    }
+    std::cout << '\n';
+  }
+
+ private:
+  Args args_;
+  std::unique_ptr<PerfCounters> counters_;
+};
+
+/// Не даёт компилятору выбросить замеряемый цикл.
+void Sink(Float value) {
+  [[maybe_unused]] volatile auto sink = value;
+}
+
+[[nodiscard]] Float Temperature(Float z) {
+  assert(0 <= z && z <= 1);
+  return kT0 + (kTW - kT0) * FastPow(z, 4);
+}
+
+}  // namespace
+
+// Usage: kernels [n] [repeats]
+//
+// Замеряет горячие участки по отдельности: CylinderZInfinite::Intersect
+// и полные циклы SolveDir плазмы и кварца по n x n направлениям
+// (полоса 169, геометрия по умолчанию). Счётчики — см. perf_counters.h.
+int main(int argc, char* argv[]) {
+  Args args;
+  try {
+    if (argc > 1) {
+      args.n = std::stoul(argv[1]);  // NOLINT
+    }
+    if (argc > 2) {
+      args.repeats = std::stoul(argv[2]);  // NOLINT
+    }
+  } catch (const std::exception&) {
+    std::cerr << "Usage: " << argv[0] << " [n] [repeats]\n";  // NOLINT
+    return 1;
+  }
+  if (args.n < 5 || args.repeats == 0) {
+    std::cerr << "Bad arguments\n";
+    return 1;
+  }
+
+  const auto nu_min = kXenonFrequency[kBand];
+  const auto nu_max = kXenonFrequency[kBand + 1];
+  const auto nu = (nu_min + nu_max) / 2;
+  const auto d_nu = nu_max - nu_min;
+
+  auto dirs = FibonacciSphere(args.n * args.n);
+  EraseRemoveIf(dirs, [](Vec3 dir) { return dir.x() <= 0; });
+
+  const SolidCylinder plasma{
+      {.center = {},
+       .radius = kR,
+       .steps = kNPlasma,
+       .refractive_index = params::plasma::kEta,
+       .refractive_index_external = params::quartz::kEta,
+       .mirror = kZero},
+      Temperature,
+      [&](Float t) { return func::I(nu, d_nu, t); },
+      [&](Float t) { return params::plasma::AbsorptionCoefficient(nu, t); }};
+
+  const HollowCylinder quartz{
+      {.center = {},
+       .radius_min = kR,
+       .radius_max = kR + kDelta,
+       .steps = kNQuartz,
+       .refractive_index = params::quartz::kEta,
+       .refractive_index_internal = params::plasma::kEta,
+       .refractive_index_external = params::air::kEta,
+       .mirror_internal = kZero,
+       .mirror_external = 0.95_F},
+      [](Float z) { return z <= 1 ? kTW : kT1; },
+      [&](Float t) { return func::I(nu, d_nu, t); },
+      [&](Float t) { return params::quartz::AbsorptionCoefficient(nu, t); }};
+
+  Kernels kernels{args};
+
+  kernels.Measure("Intersect", [&] {
+    constexpr std::size_t kRounds = 16;
+    Float checksum{};
+    for (std::size_t round = 0; round < kRounds; ++round) {
+      for (std::size_t j = 0; j < dirs.size(); ++j) {
+        const auto frac = static_cast<Float>(j % 97) / 97;
+        const auto pos = Vec3{kR * frac, 0, 0};
+        for (const auto& cylinder : plasma.cylinders) {
+          checksum += cylinder.Intersect(pos, dirs[j]);
+        }
+      }
+    }
+    Sink(checksum);
+    return kRounds * dirs.size() * plasma.cylinders.size();
+  });
+
+  kernels.Measure("SolveDir plasma", [&] {
+    for (const auto dir : dirs) {
+      const auto res = plasma.SolveDir(
+          {Vec3{kR, 0, 0}, Vec3{-dir.x(), dir.y(), dir.z()}, kOne, 1e-6_F});
+      Sink(res.absorbed_at_the_border);
+    }
+    return dirs.size();
+  });
+
+  kernels.Measure("SolveDir quartz", [&] {
+    for (const auto dir : dirs) {
+      const auto res = quartz.SolveDir({Vec3{kR, 0, 0}, dir, kOne, 1e-6_F});
+      Sink(res.absorbed_at_the_border);
+    }
+    return dirs.size();
+  });
+}
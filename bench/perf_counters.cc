@@ -0,0 +1,174 @@
+#include "perf_counters.h"
+
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <string_view>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::array<std::string_view, PerfCounters::kCount> kNames = {
+    "cycles", "instr", "cache_miss", "branch_miss", "vector",
+};
+
+// FP_ARITH_INST_RETIRED, все упакованные варианты (Intel Skylake+).
+constexpr std::uint64_t kIntelVectorEvent = 0xfcc7;
+
+[[nodiscard]] bool IsIntel() {
+  std::ifstream cpuinfo{"/proc/cpuinfo"};
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.starts_with("vendor_id")) {
+      return line.find("GenuineIntel") != std::string::npos;
+    }
+  }
+  return false;
+}
+
+[[nodiscard]] std::optional<std::uint64_t> VectorEvent() {
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  if (const auto* event = std::getenv("MT_PERF_VECTOR_EVENT")) {
+    return std::strtoull(event, nullptr, 16);
+  }
+  if (IsIntel()) {
+    return kIntelVectorEvent;
+  }
+  return std::nullopt;
+}
+
+#ifdef __linux__
+
+[[nodiscard]] int Open(std::uint32_t type, std::uint64_t config) {
+  perf_event_attr attr{};
+  attr.size = sizeof attr;
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+[[nodiscard]] PerfCounters::Reading Read(int fd) {
+  PerfCounters::Reading reading{};
+  if (read(fd, &reading, sizeof reading) != sizeof reading) {
+    return {};
+  }
+  return reading;
+}
+
+#endif
+
+}  // namespace
+
+std::optional<double> PerfCounters::Sample::Ipc() const {
+  const auto& cycles = values[kCycles];
+  const auto& instructions = values[kInstructions];
+  if (!cycles || !instructions || *cycles == 0) {
+    return std::nullopt;
+  }
+  return static_cast<double>(*instructions) / static_cast<double>(*cycles);
+}
+
+std::unique_ptr<PerfCounters> PerfCounters::FromEnv() {
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  const auto* perf = std::getenv("MT_PERF");
+  if (perf == nullptr || std::string_view{perf} == "0") {
+    return nullptr;
+  }
+  return std::make_unique<PerfCounters>();
+}
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+#ifdef __linux__
+  fds_[kCycles] = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  fds_[kInstructions] = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  fds_[kCacheMisses] = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  fds_[kBranchMisses] = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  if (const auto event = VectorEvent()) {
+    fds_[kVector] = Open(PERF_TYPE_RAW, *event);
+  }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+  for (const auto fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+void PerfCounters::Start() {
+#ifdef __linux__
+  // RESET не обнуляет счёт завершившихся дочерних потоков (inherit),
+  // поэтому Stop считает разность с показаниями на старте.
+  for (std::size_t i = 0; i < kCount; ++i) {
+    if (fds_[i] >= 0) {
+      start_[i] = Read(fds_[i]);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+      ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+auto PerfCounters::Stop() -> Sample {
+  Sample sample;
+#ifdef __linux__
+  for (std::size_t i = 0; i < kCount; ++i) {
+    if (fds_[i] >= 0) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+      ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+      const auto stop = Read(fds_[i]);
+      const auto value = stop.value - start_[i].value;
+      const auto enabled = stop.enabled - start_[i].enabled;
+      const auto running = stop.running - start_[i].running;
+      if (running == 0) {
+        continue;
+      }
+      // Поправка на мультиплексирование счётчиков ядром.
+      sample.values[i] =
+          running < enabled
+              ? static_cast<std::uint64_t>(static_cast<double>(value) *
+                                           static_cast<double>(enabled) /
+                                           static_cast<double>(running))
+              : value;
+    }
+  }
+#endif
+  return sample;
+}
+
+std::string PerfCounters::Header() {
+  std::string header;
+  for (const auto name : kNames) {
+    header += std::format(" {:>14}", name);
+  }
+  return header + std::format(" {:>6}", "ipc");
+}
+
+std::string PerfCounters::Format(const Sample& sample) {
+  std::string row;
+  for (const auto& value : sample.values) {
+    row += value ? std::format(" {:>14}", *value)
+                 : std::format(" {:>14}", "-");
+  }
+  const auto ipc = sample.Ipc();
+  return row +
+         (ipc ? std::format(" {:>6.2f}", *ipc) : std::format(" {:>6}", "-"));
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+/// Аппаратные счётчики Linux perf_event_open вокруг измеряемого участка.
+///
+/// Включаются переменной окружения MT_PERF=1. Считаются только события
+/// пользовательского режима этого процесса и потоков, созданных после
+/// открытия счётчиков. Недоступное событие (нет поддержки процессора,
+/// perf_event_paranoid, seccomp) выводится как "-".
+///
+/// Число векторных инструкций берётся из сырого события
+/// MT_PERF_VECTOR_EVENT (hex, например 0xfcc7 — FP_ARITH_INST_RETIRED.*
+/// упакованные на Intel Skylake+). По умолчанию на Intel используется
+/// 0xfcc7, на остальных процессорах счётчик выключен.
+class PerfCounters {
+ public:
+  enum Counter : std::size_t {
+    kCycles,
+    kInstructions,
+    kCacheMisses,
+    kBranchMisses,
+    kVector,
+    kCount,
+  };
+
+  struct Sample {
+    std::array<std::optional<std::uint64_t>, kCount> values;
+
+    /// @returns Инструкций за такт, если доступны оба счётчика.
+    [[nodiscard]] std::optional<double> Ipc() const;
+  };
+
+  /// @returns nullptr, если MT_PERF не задана.
+  [[nodiscard]] static std::unique_ptr<PerfCounters> FromEnv();
+
+  PerfCounters();
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters(PerfCounters&&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  PerfCounters& operator=(PerfCounters&&) = delete;
+  ~PerfCounters();
+
+  void Start();
+  [[nodiscard]] Sample Stop();
+
+  /// Заголовок и строка значений для таблиц бенчмарков.
+  [[nodiscard]] static std::string Header();
+  [[nodiscard]] static std::string Format(const Sample& sample);
+
+  /// Формат read() при PERF_FORMAT_TOTAL_TIME_ENABLED | _RUNNING.
+  struct Reading {
+    std::uint64_t value;
+    std::uint64_t enabled;
+    std::uint64_t running;
+  };
+
+ private:
+  std::array<int, kCount> fds_{};
+  std::array<Reading, kCount> start_{};
+};
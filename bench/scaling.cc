@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <format>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "base/config/float.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/result_cache.h"
+#include "modeling/solve_batch.h"
+#include "perf_counters.h"
+#include "physics/params/xenon_absorption_coefficient.h"
+
+namespace {
+
+struct Args {
+  std::size_t max_threads = std::max(std::thread::hardware_concurrency(), 1U);
+  std::size_t n = 50;  ///< Базовая сетка направлений n x n.
+  std::size_t band = 169;
+  std::size_t repeats = 3;
+};
+
+struct Sample {
+  double total{};
+  double post{};
+  PerfCounters::Sample counters;
+};
+
+[[nodiscard]] Sample Run(CylinderPlasmaQuartz::Params params,
+                         std::size_t repeats,
+                         PerfCounters* counters) {
+  Sample best{
+      .total = std::numeric_limits<double>::infinity(),
+      .post = 0,
+      .counters = {},
+  };
+  for (std::size_t i = 0; i < repeats; ++i) {
+    CylinderPlasmaQuartz solver{params};
+    // Иначе повторы берут излучение из кеша и меряют одну трассировку.
+    EmissionCache::Default().Clear();
+
+    if (counters != nullptr) {
+      counters->Start();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const auto r = solver.Solve();
+    const auto total = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+    const auto sample =
+        counters != nullptr ? counters->Stop() : PerfCounters::Sample{};
+
+    if (total < best.total) {
+      best = {.total = total, .post = r.timings.post, .counters = sample};
+    }
+  }
+  return best;
+}
+
+void PrintRow(std::string_view mode,
+              std::size_t threads,
+              std::size_t points,
+              const Sample& sample,
+              double speedup,
+              double efficiency,
+              bool counters) {
+  std::cout << std::format("{:<6} {:>7} {:>10} {:>11.6f} {:>11.6f} {:>8.3f} "
+                           "{:>10.3f}",
+                           mode, threads, points, sample.total, sample.post,
+                           speedup, efficiency);
+  if (counters) {
+    std::cout << PerfCounters::Format(sample.counters);
+  }
+  std::cout << '\n';
+}
+
+}  // namespace
+
+// Usage: scaling [max_threads] [n] [band] [repeats]
+//
+// strong: одна задача n x n направлений на 1..max_threads потоках;
+//         speedup = T1 / Tp, efficiency = speedup / p.
+// weak:   p * n x n направлений на p потоках;
+//         speedup = p * T1 / Tp, efficiency = T1 / Tp.
+// post_s — последовательная постобработка Solve (absorbed_*3, поправки).
+// Счётчики процессора вокруг Solve — см. perf_counters.h.
+int main(int argc, char* argv[]) {
+  Args args;
+  try {
+    const auto arg = [&](int i, std::size_t& value) {
+      if (argc > i) {
+        value = std::stoul(argv[i]);  // NOLINT
+      }
+    };
+    arg(1, args.max_threads);
+    arg(2, args.n);
+    arg(3, args.band);
+    arg(4, args.repeats);
+  } catch (const std::exception&) {
+    std::cerr << "Usage: " << argv[0]  // NOLINT
+              << " [max_threads] [n] [band] [repeats]\n";
+    return 1;
+  }
+  if (args.max_threads == 0 || args.n == 0 || args.repeats == 0 ||
+      args.band >= kXenonTableRanges) {
+    std::cerr << "Bad arguments\n";
+    return 1;
+  }
+
+  ResultCache::DisableDefault();  // Меряется расчёт, а не чтение кеша.
+  const auto nu_min = kXenonFrequency[args.band];
+  const auto nu_max = kXenonFrequency[args.band + 1];
+  CylinderPlasmaQuartz::Params params;
+  params.nu = (nu_min + nu_max) / 2;
+  params.d_nu = nu_max - nu_min;
+  params.n_meridian = args.n;
+  params.n_latitude = args.n;
+
+  std::cout << std::format(
+      "# CylinderPlasmaQuartz band {} sizeof(Float) {} hardware_threads {}\n"
+      "# base {}x{} directions, best of {}, emission pass included\n",
+      args.band, sizeof(Float), std::thread::hardware_concurrency(), args.n,
+      args.n, args.repeats);
+  const auto counters = PerfCounters::FromEnv();
+  std::cout << "mode   threads     points     total_s      post_s  speedup "
+               "efficiency";
+  if (counters) {
+    std::cout << PerfCounters::Header();
+  }
+  std::cout << '\n';
+
+  Sample strong_base;
+  for (std::size_t p = 1; p <= args.max_threads; ++p) {
+    params.n_threads = p;
+    const auto sample = Run(params, args.repeats, counters.get());
+    if (p == 1) {
+      strong_base = sample;
+    }
+    const auto speedup = strong_base.total / sample.total;
+    PrintRow("strong", p, args.n * args.n, sample, speedup,
+             speedup / static_cast<double>(p), counters != nullptr);
+  }
+
+  Sample weak_base;
+  for (std::size_t p = 1; p <= args.max_threads; ++p) {
+    params.n_threads = p;
+    params.n_meridian = args.n * p;
+    const auto sample = Run(params, args.repeats, counters.get());
+    if (p == 1) {
+      weak_base = sample;
+    }
+    const auto efficiency = weak_base.total / sample.total;
+    PrintRow("weak", p, args.n * args.n * p, sample,
+             efficiency * static_cast<double>(p), efficiency,
+             counters != nullptr);
+  }
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+/* C ABI библиотеки libmt: решатели CylinderPlasma и CylinderPlasmaQuartz
+ * для встраивания в программы на C.
+ *
+ * Решатель — непрозрачный дескриптор: create строит геометрию и набор
+ * направлений по параметрам, solve считает и пишет результат в буферы
+ * вызывающего, destroy освобождает. Сама библиотека результат не выделяет.
+ *
+ * Разные дескрипторы можно решать одновременно из разных потоков; вызовы
+ * solve одного дескриптора выполняются по очереди.
+ *
+ * Совместимость: структуры начинаются с struct_size и только дополняются
+ * в конце; *_init заполняет struct_size и значения по умолчанию. Структура
+ * от более старого заголовка (struct_size меньше, но не меньше размера в
+ * первой версии) принимается: недостающие в конце поля берутся по
+ * умолчанию. При несовместимом изменении растёт MT_ABI_VERSION (и
+ * SOVERSION библиотеки).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#ifdef MT_CAPI_BUILD
+#define MT_API __declspec(dllexport)
+#else
+#define MT_API __declspec(dllimport)
+#endif
+#else
+#define MT_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* NOLINTBEGIN(modernize-use-using, readability-identifier-naming) */
+
+#define MT_ABI_VERSION 1
+
+typedef enum mt_status {
+  MT_OK = 0,
+  /* NULL, неверный struct_size, недопустимый параметр, малый буфер. */
+  MT_INVALID_ARGUMENT = 1,
+  /* Результат записан, но |residual| > energy_tolerance * intensity_all. */
+  MT_ENERGY_BALANCE = 2,
+  MT_ERROR = 3,
+} mt_status;
+
+typedef struct mt_plasma_params {
+  uint32_t struct_size;
+  int32_t m;
+  double r;
+  uint64_t n_plasma;
+  double t0;
+  double tw;
+  double rho;
+  double nu; /* Гц, внутри таблицы поглощения; см. mt_band. */
+  double d_nu;
+  uint64_t n_meridian;
+  uint64_t n_latitude;
+  uint64_t n_threads;
+  double i_crit;
+  double energy_tolerance; /* 0 — не проверять. */
+  /* Дополнено после первой версии. */
+  double plasma_grading; /* Ширина внешнего слоя к внутреннему; 1 — равные. */
+  /* Не 0 — слои плазмы по профилю температуры и поглощения вместо
+   * plasma_grading. */
+  int32_t adaptive_plasma;
+} mt_plasma_params;
+
+typedef struct mt_plasma_quartz_params {
+  uint32_t struct_size;
+  int32_t m;
+  double r;
+  uint64_t n_plasma;
+  double delta;
+  uint64_t n_quartz;
+  double t0;
+  double tw;
+  double t1;
+  double eta_plasma;
+  double eta_quartz;
+  double rho;
+  double nu;
+  double d_nu;
+  uint64_t n_meridian;
+  uint64_t n_latitude;
+  uint64_t n_threads;
+  double i_crit;
+  double energy_tolerance;
+  /* Дополнено после первой версии. */
+  double plasma_grading;
+  double quartz_grading;
+  int32_t adaptive_plasma;
+} mt_plasma_quartz_params;
+
+/* Результат решения. Массивы выделяет вызывающий: absorbed_plasma* не
+ * меньше n_plasma элементов, absorbed_quartz* не меньше n_quartz + 1
+ * (узлы сетки кварца; первый всегда 0); NULL — массив не нужен. Для
+ * mt_plasma массивы кварца не используются. */
+typedef struct mt_result {
+  uint32_t struct_size;
+  uint32_t reserved;
+  uint64_t n_plasma; /* Вместимость массивов плазмы. */
+  uint64_t n_quartz; /* Вместимость массивов кварца: n_quartz + 1. */
+  double intensity_all;
+  double absorbed_mirror;
+  double residual;
+  double* absorbed_plasma;
+  double* absorbed_plasma3;
+  double* absorbed_quartz;
+  double* absorbed_quartz3;
+} mt_result;
+
+typedef struct mt_plasma mt_plasma;
+typedef struct mt_plasma_quartz mt_plasma_quartz;
+
+MT_API uint32_t mt_abi_version(void);
+
+/* Сообщение последней ошибки этого потока; "" — ошибок не было. */
+MT_API const char* mt_last_error(void);
+
+/* Число полос таблицы поглощения и середина/ширина полосы band. */
+MT_API size_t mt_n_bands(void);
+MT_API mt_status mt_band(size_t band, double* nu, double* d_nu);
+
+MT_API void mt_plasma_params_init(mt_plasma_params* params);
+MT_API void mt_plasma_quartz_params_init(mt_plasma_quartz_params* params);
+MT_API void mt_result_init(mt_result* result);
+
+MT_API mt_status mt_plasma_create(const mt_plasma_params* params,
+                                  mt_plasma** solver);
+MT_API mt_status mt_plasma_solve(mt_plasma* solver, mt_result* result);
+MT_API void mt_plasma_destroy(mt_plasma* solver);
+
+MT_API mt_status mt_plasma_quartz_create(const mt_plasma_quartz_params* params,
+                                         mt_plasma_quartz** solver);
+MT_API mt_status mt_plasma_quartz_solve(mt_plasma_quartz* solver,
+                                        mt_result* result);
+MT_API void mt_plasma_quartz_destroy(mt_plasma_quartz* solver);
+
+/* NOLINTEND(modernize-use-using, readability-identifier-naming) */
+
+#ifdef __cplusplus
+}
+#endif
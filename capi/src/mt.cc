@@ -0,0 +1,390 @@
+#include "capi/mt.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/config/float.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "physics/absorption_table.h"
+
+// NOLINTBEGIN(readability-identifier-naming)
+
+/// Дескриптор: solve одного решателя выполняется по очереди.
+struct mt_plasma {
+  explicit mt_plasma(const CylinderPlasma::Params& params)
+      : solver{params}, n_plasma{params.n_plasma}, tolerance{} {}
+
+  std::mutex mutex;
+  CylinderPlasma solver;
+  std::size_t n_plasma;
+  Float tolerance;
+};
+
+struct mt_plasma_quartz {
+  explicit mt_plasma_quartz(const CylinderPlasmaQuartz::Params& params)
+      : solver{params},
+        n_plasma{params.n_plasma},
+        n_quartz{params.n_quartz + 1},
+        tolerance{} {}
+
+  std::mutex mutex;
+  CylinderPlasmaQuartz solver;
+  std::size_t n_plasma;
+  std::size_t n_quartz;  ///< Элементов absorbed_quartz*.
+  Float tolerance;
+};
+
+// NOLINTEND(readability-identifier-naming)
+
+namespace {
+
+thread_local std::string g_last_error;
+
+[[nodiscard]] mt_status Error(mt_status status, std::string message) {
+  g_last_error = std::move(message);
+  return status;
+}
+
+/// Исключения не пересекают границу C: код ошибки и mt_last_error().
+template <typename Func>
+[[nodiscard]] mt_status Guard(Func&& func) noexcept {
+  try {
+    g_last_error.clear();
+    return func();
+  } catch (const std::invalid_argument& e) {
+    return Error(MT_INVALID_ARGUMENT, e.what());
+  } catch (const std::out_of_range& e) {
+    return Error(MT_INVALID_ARGUMENT, e.what());
+  } catch (const std::bad_alloc&) {
+    return Error(MT_ERROR, "out of memory");
+  } catch (const std::exception& e) {
+    return Error(MT_ERROR, e.what());
+  } catch (...) {
+    return Error(MT_ERROR, "unknown error");
+  }
+}
+
+/// Размеры структур первой версии заголовка: меньший struct_size не
+/// принимается.
+constexpr std::size_t kPlasmaParamsV1 =
+    offsetof(mt_plasma_params, plasma_grading);
+constexpr std::size_t kPlasmaQuartzParamsV1 =
+    offsetof(mt_plasma_quartz_params, plasma_grading);
+constexpr std::size_t kResultV1 = sizeof(mt_result);
+
+void CheckSize(std::uint32_t struct_size,
+               std::size_t v1_size,
+               std::size_t size,
+               const char* name) {
+  if (struct_size < v1_size || struct_size > size) {
+    throw std::invalid_argument(
+        std::format("{} struct_size {} is outside [{}, {}]", name,
+                    struct_size, v1_size, size));
+  }
+}
+
+/// Копия *params, в которой поля за struct_size (структура от более
+/// старого заголовка) заполнены init.
+template <typename CParams>
+[[nodiscard]] CParams ReadParams(const CParams* params,
+                                 std::size_t v1_size,
+                                 void (*init)(CParams*)) {
+  if (params == nullptr) {
+    throw std::invalid_argument("params is NULL");
+  }
+  CheckSize(params->struct_size, v1_size, sizeof(CParams), "params");
+  CParams full;
+  init(&full);
+  std::memcpy(&full, params, params->struct_size);
+  full.struct_size = sizeof(CParams);
+  return full;
+}
+
+void CheckPositive(double value, const char* name) {
+  if (!(value > 0)) {
+    throw std::invalid_argument(std::format("{} must be > 0", name));
+  }
+}
+
+void CheckNonZero(std::uint64_t value, const char* name) {
+  if (value == 0) {
+    throw std::invalid_argument(std::format("{} must be > 0", name));
+  }
+}
+
+/// Общие поля обеих моделей; решатели сами их не проверяют.
+template <typename CParams>
+void CheckCommon(const CParams& params) {
+  CheckPositive(params.r, "r");
+  CheckNonZero(params.n_plasma, "n_plasma");
+  CheckPositive(params.t0, "t0");
+  CheckPositive(params.tw, "tw");
+  CheckPositive(params.d_nu, "d_nu");
+  CheckPositive(params.plasma_grading, "plasma_grading");
+  CheckNonZero(params.n_meridian, "n_meridian");
+  CheckNonZero(params.n_latitude, "n_latitude");
+  if (!(params.rho >= 0 && params.rho <= 1)) {
+    throw std::invalid_argument("rho must be in [0, 1]");
+  }
+  if (!(params.energy_tolerance >= 0)) {
+    throw std::invalid_argument("energy_tolerance must be >= 0");
+  }
+  if (!AbsorptionTable::Default().Band(static_cast<Float>(params.nu))) {
+    throw std::invalid_argument(
+        std::format("nu {:g} is outside the absorption table", params.nu));
+  }
+}
+
+template <typename Params, typename CParams>
+void CopyCommon(Params& to, const CParams& from) {
+  to.r = static_cast<Float>(from.r);
+  to.n_plasma = static_cast<std::size_t>(from.n_plasma);
+  to.t0 = static_cast<Float>(from.t0);
+  to.tw = static_cast<Float>(from.tw);
+  to.m = from.m;
+  to.rho = static_cast<Float>(from.rho);
+  to.nu = static_cast<Float>(from.nu);
+  to.d_nu = static_cast<Float>(from.d_nu);
+  to.n_meridian = static_cast<std::size_t>(from.n_meridian);
+  to.n_latitude = static_cast<std::size_t>(from.n_latitude);
+  to.n_threads = static_cast<std::size_t>(from.n_threads);
+  to.i_crit = static_cast<Float>(from.i_crit);
+  to.plasma_grading = static_cast<Float>(from.plasma_grading);
+  to.adaptive_plasma = from.adaptive_plasma != 0;
+  // Баланс проверяет Write: результат отдаётся и при нарушении.
+  to.energy_tolerance = 0;
+}
+
+template <typename CParams, typename Params>
+void InitCommon(CParams& to, const Params& from) {
+  to.struct_size = sizeof(CParams);
+  to.m = from.m;
+  to.r = from.r;
+  to.n_plasma = from.n_plasma;
+  to.t0 = from.t0;
+  to.tw = from.tw;
+  to.rho = from.rho;
+  to.nu = from.nu;
+  to.d_nu = from.d_nu;
+  to.n_meridian = from.n_meridian;
+  to.n_latitude = from.n_latitude;
+  to.n_threads = from.n_threads;
+  to.i_crit = from.i_crit;
+  to.energy_tolerance = from.energy_tolerance;
+  to.plasma_grading = from.plasma_grading;
+  to.adaptive_plasma = from.adaptive_plasma ? 1 : 0;
+}
+
+void CheckResult(const mt_result* result,
+                 std::size_t n_plasma,
+                 std::size_t n_quartz) {
+  if (result == nullptr) {
+    throw std::invalid_argument("result is NULL");
+  }
+  // Пока mt_result не дополнялась, все версии пишутся целиком.
+  CheckSize(result->struct_size, kResultV1, sizeof(mt_result), "result");
+  const auto plasma = result->absorbed_plasma != nullptr ||
+                      result->absorbed_plasma3 != nullptr;
+  if (plasma && result->n_plasma < n_plasma) {
+    throw std::invalid_argument(std::format(
+        "result n_plasma {} < {}", result->n_plasma, n_plasma));
+  }
+  const auto quartz = result->absorbed_quartz != nullptr ||
+                      result->absorbed_quartz3 != nullptr;
+  if (quartz && result->n_quartz < n_quartz) {
+    throw std::invalid_argument(std::format(
+        "result n_quartz {} < {}", result->n_quartz, n_quartz));
+  }
+}
+
+void Copy(const std::vector<Float>& from, double* to, std::size_t size) {
+  if (to == nullptr) {
+    return;
+  }
+  if (from.size() > size) {
+    throw std::logic_error("result does not fit the buffer");
+  }
+  std::ranges::copy(from, to);
+}
+
+/// Пишет результат в буферы вызывающего и проверяет баланс.
+template <typename Result>
+[[nodiscard]] mt_status Write(const Result& from,
+                              Float tolerance,
+                              mt_result& to) {
+  to.intensity_all = from.intensity_all;
+  to.absorbed_mirror = from.absorbed_mirror;
+  to.residual = from.balance.residual;
+  Copy(from.absorbed_plasma, to.absorbed_plasma, to.n_plasma);
+  Copy(from.absorbed_plasma3, to.absorbed_plasma3, to.n_plasma);
+  if constexpr (requires { from.absorbed_quartz; }) {
+    Copy(from.absorbed_quartz, to.absorbed_quartz, to.n_quartz);
+    Copy(from.absorbed_quartz3, to.absorbed_quartz3, to.n_quartz);
+  }
+
+  // NaN в невязке тоже нарушение, как в CheckEnergyBalance.
+  if (tolerance > 0 && !(std::abs(from.balance.residual) <=
+                         tolerance * from.intensity_all)) {
+    return Error(MT_ENERGY_BALANCE,
+                 std::format("Energy balance violated: emitted {:g}, "
+                             "residual {:g}",
+                             from.intensity_all, from.balance.residual));
+  }
+  return MT_OK;
+}
+
+}  // namespace
+
+extern "C" {
+
+uint32_t mt_abi_version(void) {
+  return MT_ABI_VERSION;
+}
+
+const char* mt_last_error(void) {
+  return g_last_error.c_str();
+}
+
+size_t mt_n_bands(void) {
+  try {
+    return AbsorptionTable::Default().n_bands();
+  } catch (const std::exception& e) {
+    g_last_error = e.what();
+    return 0;
+  }
+}
+
+mt_status mt_band(size_t band, double* nu, double* d_nu) {
+  return Guard([&] {
+    const auto center = AbsorptionTable::Default().BandCenter(band);
+    if (nu != nullptr) {
+      *nu = center.nu;
+    }
+    if (d_nu != nullptr) {
+      *d_nu = center.d_nu;
+    }
+    return MT_OK;
+  });
+}
+
+void mt_plasma_params_init(mt_plasma_params* params) {
+  if (params != nullptr) {
+    *params = {};
+    InitCommon(*params, CylinderPlasma::Params{});
+  }
+}
+
+void mt_plasma_quartz_params_init(mt_plasma_quartz_params* params) {
+  if (params != nullptr) {
+    const CylinderPlasmaQuartz::Params defaults;
+    *params = {};
+    InitCommon(*params, defaults);
+    params->delta = defaults.delta;
+    params->n_quartz = defaults.n_quartz;
+    params->t1 = defaults.t1;
+    params->eta_plasma = defaults.eta_plasma;
+    params->eta_quartz = defaults.eta_quartz;
+    params->quartz_grading = defaults.quartz_grading;
+  }
+}
+
+void mt_result_init(mt_result* result) {
+  if (result != nullptr) {
+    *result = {};
+    result->struct_size = sizeof(mt_result);
+  }
+}
+
+mt_status mt_plasma_create(const mt_plasma_params* params,
+                           mt_plasma** solver) {
+  return Guard([&] {
+    if (solver == nullptr) {
+      throw std::invalid_argument("solver is NULL");
+    }
+    *solver = nullptr;
+    const auto c = ReadParams(params, kPlasmaParamsV1, mt_plasma_params_init);
+    CheckCommon(c);
+
+    CylinderPlasma::Params p;
+    CopyCommon(p, c);
+    auto* handle = new mt_plasma{p};  // NOLINT(cppcoreguidelines-owning-memory)
+    handle->tolerance = static_cast<Float>(c.energy_tolerance);
+    *solver = handle;
+    return MT_OK;
+  });
+}
+
+mt_status mt_plasma_solve(mt_plasma* solver, mt_result* result) {
+  return Guard([&] {
+    if (solver == nullptr) {
+      throw std::invalid_argument("solver is NULL");
+    }
+    CheckResult(result, solver->n_plasma, 0);
+    const std::lock_guard lock{solver->mutex};
+    return Write(solver->solver.Solve(), solver->tolerance, *result);
+  });
+}
+
+void mt_plasma_destroy(mt_plasma* solver) {
+  delete solver;  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+mt_status mt_plasma_quartz_create(const mt_plasma_quartz_params* params,
+                                  mt_plasma_quartz** solver) {
+  return Guard([&] {
+    if (solver == nullptr) {
+      throw std::invalid_argument("solver is NULL");
+    }
+    *solver = nullptr;
+    const auto c = ReadParams(params, kPlasmaQuartzParamsV1,
+                              mt_plasma_quartz_params_init);
+    CheckCommon(c);
+    CheckPositive(c.delta, "delta");
+    CheckNonZero(c.n_quartz, "n_quartz");
+    CheckPositive(c.t1, "t1");
+    CheckPositive(c.quartz_grading, "quartz_grading");
+
+    CylinderPlasmaQuartz::Params p;
+    CopyCommon(p, c);
+    p.delta = static_cast<Float>(c.delta);
+    p.n_quartz = static_cast<std::size_t>(c.n_quartz);
+    p.t1 = static_cast<Float>(c.t1);
+    p.eta_plasma = static_cast<Float>(c.eta_plasma);
+    p.eta_quartz = static_cast<Float>(c.eta_quartz);
+    p.quartz_grading = static_cast<Float>(c.quartz_grading);
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    auto* handle = new mt_plasma_quartz{p};
+    handle->tolerance = static_cast<Float>(c.energy_tolerance);
+    *solver = handle;
+    return MT_OK;
+  });
+}
+
+mt_status mt_plasma_quartz_solve(mt_plasma_quartz* solver, mt_result* result) {
+  return Guard([&] {
+    if (solver == nullptr) {
+      throw std::invalid_argument("solver is NULL");
+    }
+    CheckResult(result, solver->n_plasma, solver->n_quartz);
+    const std::lock_guard lock{solver->mutex};
+    return Write(solver->solver.Solve(), solver->tolerance, *result);
+  });
+}
+
+void mt_plasma_quartz_destroy(mt_plasma_quartz* solver) {
+  delete solver;  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+}  // extern "C"
@@ -0,0 +1,38 @@
+/* Заголовок capi/mt.h собирается компилятором C; решение из C. */
+
+#include <stdlib.h>
+
+#include "capi/mt.h"
+
+double mt_test_solve_from_c(uint64_t n_plasma) {
+  mt_plasma_params params;
+  mt_plasma* solver = NULL;
+  mt_result result;
+  double* absorbed = NULL;
+  double sum = -1;
+
+  mt_plasma_params_init(&params);
+  params.n_plasma = n_plasma;
+  params.n_meridian = 20;
+  params.n_latitude = 20;
+  params.n_threads = 1;
+  if (mt_plasma_create(&params, &solver) != MT_OK) {
+    return sum;
+  }
+
+  absorbed = (double*)calloc(n_plasma, sizeof(double));
+  mt_result_init(&result);
+  result.n_plasma = n_plasma;
+  result.absorbed_plasma = absorbed;
+  if (absorbed != NULL && mt_plasma_solve(solver, &result) == MT_OK) {
+    uint64_t i = 0;
+    sum = result.absorbed_mirror;
+    for (; i < n_plasma; ++i) {
+      sum += absorbed[i];
+    }
+  }
+
+  free(absorbed);
+  mt_plasma_destroy(solver);
+  return sum;
+}
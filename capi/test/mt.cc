@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/config/float.h"
+#include "capi/mt.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "physics/absorption_table.h"
+
+extern "C" double mt_test_solve_from_c(uint64_t n_plasma);
+
+namespace {
+
+[[nodiscard]] mt_plasma_params SmallPlasma() {
+  mt_plasma_params params;
+  mt_plasma_params_init(&params);
+  params.n_plasma = 10;
+  params.n_meridian = 20;
+  params.n_latitude = 20;
+  params.n_threads = 2;
+  return params;
+}
+
+[[nodiscard]] CylinderPlasma::Params ToCxx(const mt_plasma_params& params) {
+  return {.r = static_cast<Float>(params.r),
+          .n_plasma = params.n_plasma,
+          .plasma_grading = static_cast<Float>(params.plasma_grading),
+          .t0 = static_cast<Float>(params.t0),
+          .tw = static_cast<Float>(params.tw),
+          .m = params.m,
+          .rho = static_cast<Float>(params.rho),
+          .nu = static_cast<Float>(params.nu),
+          .d_nu = static_cast<Float>(params.d_nu),
+          .n_meridian = params.n_meridian,
+          .n_latitude = params.n_latitude,
+          .n_threads = params.n_threads,
+          .i_crit = static_cast<Float>(params.i_crit)};
+}
+
+struct Output {
+  mt_result result{};
+  std::vector<double> plasma;
+  std::vector<double> plasma3;
+  std::vector<double> quartz;
+  std::vector<double> quartz3;
+};
+
+[[nodiscard]] Output MakeOutput(std::size_t n_plasma, std::size_t n_quartz) {
+  Output output{.plasma = std::vector<double>(n_plasma),
+                .plasma3 = std::vector<double>(n_plasma),
+                .quartz = std::vector<double>(n_quartz),
+                .quartz3 = std::vector<double>(n_quartz)};
+  mt_result_init(&output.result);
+  output.result.n_plasma = n_plasma;
+  output.result.n_quartz = n_quartz;
+  output.result.absorbed_plasma = output.plasma.data();
+  output.result.absorbed_plasma3 = output.plasma3.data();
+  output.result.absorbed_quartz = output.quartz.data();
+  output.result.absorbed_quartz3 = output.quartz3.data();
+  return output;
+}
+
+void ExpectEqual(const std::vector<Float>& expected,
+                 const std::vector<double>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(static_cast<double>(expected[i]), actual[i]) << i;
+  }
+}
+
+TEST(CapiTest, Version) {
+  EXPECT_EQ(mt_abi_version(), MT_ABI_VERSION);
+}
+
+TEST(CapiTest, Bands) {
+  const auto n_bands = mt_n_bands();
+  ASSERT_GT(n_bands, 0U);
+
+  double nu = 0;
+  double d_nu = 0;
+  EXPECT_EQ(mt_band(0, &nu, &d_nu), MT_OK);
+  EXPECT_GT(nu, 0);
+  EXPECT_GT(d_nu, 0);
+  // Та же полоса, что у band= в конфигах cli и Python.
+  const auto center = AbsorptionTable::Default().BandCenter(0);
+  EXPECT_EQ(nu, center.nu);
+  EXPECT_EQ(d_nu, center.d_nu);
+
+  EXPECT_EQ(mt_band(n_bands, &nu, &d_nu), MT_INVALID_ARGUMENT);
+  EXPECT_NE(std::string{mt_last_error()}, "");
+}
+
+TEST(CapiTest, ParamsDefaults) {
+  mt_plasma_quartz_params params;
+  mt_plasma_quartz_params_init(&params);
+  const CylinderPlasmaQuartz::Params defaults;
+  EXPECT_EQ(params.struct_size, sizeof params);
+  EXPECT_EQ(params.n_plasma, defaults.n_plasma);
+  EXPECT_EQ(params.n_quartz, defaults.n_quartz);
+  EXPECT_EQ(params.t1, static_cast<double>(defaults.t1));
+  EXPECT_EQ(params.eta_quartz, static_cast<double>(defaults.eta_quartz));
+}
+
+TEST(CapiTest, PlasmaMatchesSolver) {
+  const auto params = SmallPlasma();
+  mt_plasma* solver = nullptr;
+  ASSERT_EQ(mt_plasma_create(&params, &solver), MT_OK) << mt_last_error();
+
+  auto output = MakeOutput(params.n_plasma, 0);
+  EXPECT_EQ(mt_plasma_solve(solver, &output.result), MT_OK);
+  mt_plasma_destroy(solver);
+
+  const auto expected = CylinderPlasma{ToCxx(params)}.Solve();
+  ExpectEqual(expected.absorbed_plasma, output.plasma);
+  ExpectEqual(expected.absorbed_plasma3, output.plasma3);
+  EXPECT_EQ(output.result.intensity_all,
+            static_cast<double>(expected.intensity_all));
+  EXPECT_EQ(output.result.absorbed_mirror,
+            static_cast<double>(expected.absorbed_mirror));
+}
+
+TEST(CapiTest, PlasmaQuartzMatchesSolver) {
+  mt_plasma_quartz_params params;
+  mt_plasma_quartz_params_init(&params);
+  params.n_plasma = 8;
+  params.n_quartz = 4;
+  params.n_meridian = 20;
+  params.n_latitude = 20;
+  params.n_threads = 1;
+  params.energy_tolerance = 1e-3;
+  ASSERT_EQ(mt_band(169, &params.nu, &params.d_nu), MT_OK);
+  mt_plasma_quartz* solver = nullptr;
+  ASSERT_EQ(mt_plasma_quartz_create(&params, &solver), MT_OK)
+      << mt_last_error();
+
+  auto output = MakeOutput(params.n_plasma, params.n_quartz + 1);
+  EXPECT_EQ(mt_plasma_quartz_solve(solver, &output.result), MT_OK);
+  mt_plasma_quartz_destroy(solver);
+
+  const auto expected =
+      CylinderPlasmaQuartz{{.n_plasma = 8,
+                            .n_quartz = 4,
+                            .nu = static_cast<Float>(params.nu),
+                            .d_nu = static_cast<Float>(params.d_nu),
+                            .n_meridian = 20,
+                            .n_latitude = 20,
+                            .n_threads = 1}}
+          .Solve();
+  ExpectEqual(expected.absorbed_plasma, output.plasma);
+  ExpectEqual(expected.absorbed_quartz, output.quartz);
+  ExpectEqual(expected.absorbed_quartz3, output.quartz3);
+}
+
+TEST(CapiTest, InvalidArguments) {
+  auto params = SmallPlasma();
+  mt_plasma* solver = nullptr;
+  EXPECT_EQ(mt_plasma_create(nullptr, &solver), MT_INVALID_ARGUMENT);
+  EXPECT_EQ(mt_plasma_create(&params, nullptr), MT_INVALID_ARGUMENT);
+
+  params.struct_size = 8;
+  EXPECT_EQ(mt_plasma_create(&params, &solver), MT_INVALID_ARGUMENT);
+  EXPECT_EQ(solver, nullptr);
+
+  params = SmallPlasma();
+  params.nu = 1;
+  EXPECT_EQ(mt_plasma_create(&params, &solver), MT_INVALID_ARGUMENT);
+  EXPECT_NE(std::string{mt_last_error()}.find("nu"), std::string::npos);
+
+  params = SmallPlasma();
+  params.n_plasma = 0;
+  EXPECT_EQ(mt_plasma_create(&params, &solver), MT_INVALID_ARGUMENT);
+
+  // Буфер меньше n_plasma не пишется.
+  params = SmallPlasma();
+  ASSERT_EQ(mt_plasma_create(&params, &solver), MT_OK);
+  auto output = MakeOutput(params.n_plasma - 1, 0);
+  EXPECT_EQ(mt_plasma_solve(solver, &output.result), MT_INVALID_ARGUMENT);
+  EXPECT_EQ(mt_plasma_solve(solver, nullptr), MT_INVALID_ARGUMENT);
+  mt_plasma_destroy(solver);
+  mt_plasma_destroy(nullptr);
+}
+
+TEST(CapiTest, AcceptsFirstVersionStructs) {
+  // Вызывающий собран с заголовком первой версии: plasma_grading у него
+  // нет, за struct_size — чужая память.
+  auto params = SmallPlasma();
+  params.struct_size =
+      static_cast<std::uint32_t>(offsetof(mt_plasma_params, plasma_grading));
+  params.plasma_grading = -1;
+  mt_plasma* solver = nullptr;
+  ASSERT_EQ(mt_plasma_create(&params, &solver), MT_OK) << mt_last_error();
+  auto output = MakeOutput(params.n_plasma, 0);
+  EXPECT_EQ(mt_plasma_solve(solver, &output.result), MT_OK);
+  mt_plasma_destroy(solver);
+  ExpectEqual(CylinderPlasma{ToCxx(SmallPlasma())}.Solve().absorbed_plasma,
+              output.plasma);
+
+  mt_plasma_quartz_params quartz;
+  mt_plasma_quartz_params_init(&quartz);
+  quartz.struct_size = static_cast<std::uint32_t>(
+      offsetof(mt_plasma_quartz_params, plasma_grading));
+  quartz.plasma_grading = 0;
+  quartz.quartz_grading = 0;
+  mt_plasma_quartz* quartz_solver = nullptr;
+  EXPECT_EQ(mt_plasma_quartz_create(&quartz, &quartz_solver), MT_OK)
+      << mt_last_error();
+  mt_plasma_quartz_destroy(quartz_solver);
+
+  // Новое поле читается, если struct_size его покрывает.
+  params = SmallPlasma();
+  params.plasma_grading = -1;
+  EXPECT_EQ(mt_plasma_create(&params, &solver), MT_INVALID_ARGUMENT);
+  EXPECT_NE(std::string{mt_last_error()}.find("plasma_grading"),
+            std::string::npos);
+
+  params = SmallPlasma();
+  params.struct_size = sizeof params + 8;  // Заголовок новее библиотеки.
+  EXPECT_EQ(mt_plasma_create(&params, &solver), MT_INVALID_ARGUMENT);
+  EXPECT_EQ(solver, nullptr);
+}
+
+TEST(CapiTest, ConcurrentHandles) {
+  constexpr std::size_t kThreads = 4;
+  auto params = SmallPlasma();
+  params.n_threads = 1;
+  std::vector<Output> outputs;
+  for (std::size_t i = 0; i < kThreads; ++i) {
+    outputs.push_back(MakeOutput(params.n_plasma, 0));
+  }
+
+  {
+    std::vector<std::jthread> threads;
+    for (auto& output : outputs) {
+      threads.emplace_back([&params, &output] {
+        mt_plasma* solver = nullptr;
+        if (mt_plasma_create(&params, &solver) == MT_OK) {
+          EXPECT_EQ(mt_plasma_solve(solver, &output.result), MT_OK);
+        }
+        mt_plasma_destroy(solver);
+      });
+    }
+  }
+
+  for (const auto& output : outputs) {
+    EXPECT_EQ(output.plasma, outputs.front().plasma);
+  }
+}
+
+TEST(CapiTest, FromC) {
+  EXPECT_GT(mt_test_solve_from_c(10), 0);
+}
+
+}  // namespace
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace cli {
+
+/// Контрольная точка перебора полос (MT sweep --checkpoint): отпечаток
+/// параметров и полные результаты завершённых полос. Каждая добавленная
+/// полоса сразу дописывается в конец файла, поэтому после прерывания
+/// повторный запуск пропускает уже посчитанные полосы. Запись, оборванную
+/// сбоем, Load отбрасывает, и первый Add переписывает файл атомарно.
+///
+/// Result — CylinderPlasma::Result или CylinderPlasmaQuartz::Result.
+template <typename Result>
+class Checkpoint {
+ public:
+  /// Загружает path, если он есть.
+  /// @throws std::runtime_error, если заголовок файла повреждён или файл
+  /// сделан для другой модели или других параметров.
+  Checkpoint(std::filesystem::path path,
+             std::string_view model,
+             std::uint64_t params_hash);
+
+  [[nodiscard]] std::size_t size() const;
+
+  /// @returns Сохранённый результат полосы.
+  [[nodiscard]] std::optional<Result> Find(std::size_t band) const;
+
+  /// Потокобезопасно.
+  /// @throws std::runtime_error при ошибке записи.
+  void Add(std::size_t band, const Result& result);
+
+ private:
+  void Load();
+  void Save() const;
+
+  std::filesystem::path path_;
+  std::string model_;
+  std::uint64_t params_hash_;
+  mutable std::mutex mutex_;
+  std::map<std::size_t, Result> bands_;
+  /// Файл цел и кончается полной записью: полосы можно дописывать.
+  bool append_ = false;
+};
+
+}  // namespace cli
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <span>
+
+namespace cli {
+
+/// Точка входа MT: MT <xe|xe-sio2|sweep|tau> [--option=value ...].
+/// Описание команд и ключей — kUsage в commands.cc и README.
+///
+/// @returns Код завершения процесса.
+[[nodiscard]] int Main(std::span<char* const> args);
+
+}  // namespace cli
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+
+namespace cli {
+
+/// Пары key=value в порядке задания; более поздняя перекрывает раннюю.
+/// Ключи — имена полей Params и band (номер полосы
+/// AbsorptionTable::Default(), задаёт nu и d_nu).
+using Settings = std::vector<std::pair<std::string, std::string>>;
+
+/// Разбирает "key=value" (пробелы вокруг key и value отбрасываются).
+/// @throws std::invalid_argument
+[[nodiscard]] std::pair<std::string, std::string> ParseSetting(
+    std::string_view text);
+
+/// Файл конфигурации: строка "key = value" на параметр, '#' — комментарий.
+/// @throws std::invalid_argument с номером строки.
+[[nodiscard]] Settings ReadConfig(std::istream& in);
+
+/// Список заданий: строка на задание, "key=value" через пробелы;
+/// пустые строки и '#' — комментарии.
+/// @throws std::invalid_argument с номером строки.
+[[nodiscard]] std::vector<Settings> ReadJobs(std::istream& in);
+
+/// @returns Последний band из settings.
+/// @throws std::invalid_argument, если band вне таблицы.
+[[nodiscard]] std::optional<std::size_t> Band(const Settings& settings);
+
+/// @throws std::invalid_argument при неизвестном ключе или плохом значении.
+void Apply(CylinderPlasma::Params& params,
+           std::string_view key,
+           std::string_view value);
+void Apply(CylinderPlasmaQuartz::Params& params,
+           std::string_view key,
+           std::string_view value);
+
+/// Канонический вид параметров: строки "key=value" по всем полям в порядке
+/// объявления, кроме n_threads и energy_tolerance (на результат не влияют).
+/// Значения — кратчайшая точная запись.
+[[nodiscard]] std::string Describe(const CylinderPlasma::Params& params);
+[[nodiscard]] std::string Describe(const CylinderPlasmaQuartz::Params& params);
+
+template <typename Params>
+[[nodiscard]] Params MakeParams(Params params, const Settings& settings) {
+  for (const auto& [key, value] : settings) {
+    Apply(params, key, value);
+  }
+  return params;
+}
+
+}  // namespace cli
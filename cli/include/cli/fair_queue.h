@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <utility>
+
+namespace cli {
+
+/// Очередь с круговым обходом клиентов: Pop берёт по одному элементу у
+/// каждого клиента с непустой очередью по очереди, поэтому клиент с
+/// тысячей запросов не задерживает клиента с одним больше чем на одну
+/// задачу на поток. Внутри клиента порядок FIFO. Не потокобезопасна.
+template <typename T>
+class FairQueue {
+ public:
+  void Push(std::uint64_t client, T item) {
+    auto& queue = queues_[client];
+    if (queue.empty()) {
+      ring_.push_back(client);
+    }
+    queue.push_back(std::move(item));
+    ++size_;
+  }
+
+  [[nodiscard]] std::optional<T> Pop() {
+    if (ring_.empty()) {
+      return std::nullopt;
+    }
+    const auto client = ring_.front();
+    ring_.pop_front();
+    const auto it = queues_.find(client);
+    auto item = std::move(it->second.front());
+    it->second.pop_front();
+    if (it->second.empty()) {
+      queues_.erase(it);
+    } else {
+      ring_.push_back(client);
+    }
+    --size_;
+    return item;
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+ private:
+  std::map<std::uint64_t, std::deque<T>> queues_;
+  std::deque<std::uint64_t> ring_;  ///< Клиенты с непустой очередью.
+  std::size_t size_{};
+};
+
+}  // namespace cli
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+
+namespace cli {
+
+/// Протокол MT serve поверх потокового Unix-сокета. Числа little-endian.
+/// Кадр — u32 длина тела и тело. Клиент может отправить несколько запросов
+/// подряд, не дожидаясь ответов; ответы приходят по готовности и
+/// сопоставляются с запросами по id.
+///
+/// Запрос: u32 id, u8 Model, параметры текстом "key=value ..." (как строка
+/// --jobs, в том числе band=I).
+///
+/// Ответ: u32 id, u8 статус (0 — решено, 1 — ошибка). При ошибке — текст
+/// сообщения. Иначе f64 intensity_all, absorbed_mirror, residual,
+/// u32 n_plasma, u32 n_quartz и массивы f64 absorbed_plasma[n_plasma],
+/// absorbed_plasma3[n_plasma], absorbed_quartz[n_quartz],
+/// absorbed_quartz3[n_quartz] (для xe n_quartz = 0).
+enum class Model : std::uint8_t {
+  kXe,
+  kXeSiO2,
+};
+
+struct Request {
+  std::uint32_t id{};
+  Model model{};
+  std::string settings{};
+};
+
+struct Reply {
+  std::uint32_t id{};
+  std::string error{};  ///< Пусто, если решено.
+  double intensity_all{};
+  double absorbed_mirror{};
+  double residual{};
+  std::vector<double> absorbed_plasma{};
+  std::vector<double> absorbed_plasma3{};
+  std::vector<double> absorbed_quartz{};
+  std::vector<double> absorbed_quartz3{};
+};
+
+/// Наибольшая длина тела кадра.
+inline constexpr std::size_t kMaxFrameSize = std::size_t{64} << 20;
+
+[[nodiscard]] Reply ToReply(std::uint32_t id, const CylinderPlasma::Result& r);
+[[nodiscard]] Reply ToReply(std::uint32_t id,
+                            const CylinderPlasmaQuartz::Result& r);
+
+/// @returns Кадр целиком, с длиной.
+[[nodiscard]] std::string Encode(const Request& request);
+[[nodiscard]] std::string Encode(const Reply& reply);
+
+/// Разбирают тело кадра.
+/// @throws std::runtime_error
+[[nodiscard]] Request DecodeRequest(std::string_view body);
+[[nodiscard]] Reply DecodeReply(std::string_view body);
+
+/// @returns Тело очередного кадра; nullopt, если соединение закрыто.
+/// @throws std::runtime_error при ошибке чтения, обрыве внутри кадра или
+/// слишком длинном кадре.
+[[nodiscard]] std::optional<std::string> ReadFrame(int fd);
+
+/// @returns false, если записать не удалось (например, клиент ушёл).
+bool WriteFrame(int fd, std::string_view frame);
+
+}  // namespace cli
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+namespace cli {
+
+/// Демон MT serve: принимает запросы protocol.h на Unix-сокете и решает их
+/// на общем пуле потоков, не перезапуская процесс. Между запросами живут
+/// пул, таблица поглощения и память результатов (LRU по CacheKey и
+/// energy_tolerance). Дисковый кеш MT_CACHE_DIR тоже работает.
+///
+/// У каждого клиента своя очередь; потоки берут запросы клиентов по кругу
+/// (FairQueue). Трассировку задания помогают выполнять свободные потоки
+/// пула.
+class Server {
+ public:
+  struct Options {
+    std::filesystem::path socket;
+    std::size_t threads = 1;  ///< Потоков пула.
+    std::size_t memo = 4096;  ///< Результатов в памяти, 0 — не хранить.
+  };
+
+  /// Создаёт сокет (старый файл по этому пути удаляется) и слушает его.
+  /// @throws std::runtime_error
+  explicit Server(const Options& options);
+  Server(const Server&) = delete;
+  Server(Server&&) = delete;
+  Server& operator=(const Server&) = delete;
+  Server& operator=(Server&&) = delete;
+  /// Удаляет файл сокета.
+  ~Server();
+
+  /// Принимает клиентов до Stop(); перед возвратом дожидается ответов на
+  /// все принятые запросы.
+  void Run();
+
+  /// Можно вызывать из другого потока и из обработчика сигнала.
+  void Stop() noexcept;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace cli
@@ -0,0 +1,248 @@
+#include "cli/checkpoint.h"
+
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/config/float.h"
+#include "io/atomic_file.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+
+namespace cli {
+
+namespace {
+
+/// Формат файла:
+///   mt-checkpoint <version>
+///   model <model> params <hash hex>
+///   band <i>
+///   intensity_all <v>
+///   absorbed_mirror <v>
+///   balance <7 полей EnergyBalance>
+///   absorbed_plasma <n> <v...> (и остальные массивы Result)
+///   end
+///   ...
+/// Полосы дописываются в конец по одной; запись без end оборвана сбоем.
+constexpr std::string_view kMagic = "mt-checkpoint";
+constexpr int kVersion = 2;
+
+void WriteVector(std::string& out,
+                 std::string_view key,
+                 const std::vector<Float>& values) {
+  out += std::format("{} {}", key, values.size());
+  for (const auto value : values) {
+    out += std::format(" {}", value);
+  }
+  out += '\n';
+}
+
+void ReadKey(std::istream& in, std::string_view key) {
+  std::string word;
+  if (!(in >> word) || word != key) {
+    throw std::runtime_error(
+        std::format("expected '{}', got '{}'", key, word));
+  }
+}
+
+[[nodiscard]] Float ReadValue(std::istream& in) {
+  double value{};
+  if (!(in >> value)) {
+    throw std::runtime_error("bad value");
+  }
+  return static_cast<Float>(value);
+}
+
+void ReadVector(std::istream& in,
+                std::string_view key,
+                std::vector<Float>& values) {
+  ReadKey(in, key);
+  std::size_t n{};
+  if (!(in >> n)) {
+    throw std::runtime_error(std::format("bad size of '{}'", key));
+  }
+  values.resize(n);
+  for (auto& value : values) {
+    value = ReadValue(in);
+  }
+}
+
+void WriteCommon(std::string& out,
+                 Float intensity_all,
+                 Float absorbed_mirror,
+                 const EnergyBalance& b) {
+  out += std::format("intensity_all {}\nabsorbed_mirror {}\n", intensity_all,
+                     absorbed_mirror);
+  out += std::format("balance {} {} {} {} {} {} {}\n", b.absorbed_plasma,
+                     b.absorbed_quartz, b.absorbed_mirror, b.truncated_plasma,
+                     b.truncated_quartz, b.truncated_mirror, b.residual);
+}
+
+void ReadCommon(std::istream& in,
+                Float& intensity_all,
+                Float& absorbed_mirror,
+                EnergyBalance& b) {
+  ReadKey(in, "intensity_all");
+  intensity_all = ReadValue(in);
+  ReadKey(in, "absorbed_mirror");
+  absorbed_mirror = ReadValue(in);
+  ReadKey(in, "balance");
+  for (auto* value :
+       {&b.absorbed_plasma, &b.absorbed_quartz, &b.absorbed_mirror,
+        &b.truncated_plasma, &b.truncated_quartz, &b.truncated_mirror,
+        &b.residual}) {
+    *value = ReadValue(in);
+  }
+}
+
+void Write(std::string& out, const CylinderPlasma::Result& r) {
+  WriteCommon(out, r.intensity_all, r.absorbed_mirror, r.balance);
+  WriteVector(out, "absorbed_plasma", r.absorbed_plasma);
+  WriteVector(out, "absorbed_plasma3", r.absorbed_plasma3);
+}
+
+void Read(std::istream& in, CylinderPlasma::Result& r) {
+  ReadCommon(in, r.intensity_all, r.absorbed_mirror, r.balance);
+  ReadVector(in, "absorbed_plasma", r.absorbed_plasma);
+  ReadVector(in, "absorbed_plasma3", r.absorbed_plasma3);
+}
+
+void Write(std::string& out, const CylinderPlasmaQuartz::Result& r) {
+  WriteCommon(out, r.intensity_all, r.absorbed_mirror, r.balance);
+  WriteVector(out, "absorbed_plasma", r.absorbed_plasma);
+  WriteVector(out, "absorbed_plasma3", r.absorbed_plasma3);
+  WriteVector(out, "absorbed_quartz", r.absorbed_quartz);
+  WriteVector(out, "absorbed_quartz3", r.absorbed_quartz3);
+}
+
+void Read(std::istream& in, CylinderPlasmaQuartz::Result& r) {
+  ReadCommon(in, r.intensity_all, r.absorbed_mirror, r.balance);
+  ReadVector(in, "absorbed_plasma", r.absorbed_plasma);
+  ReadVector(in, "absorbed_plasma3", r.absorbed_plasma3);
+  ReadVector(in, "absorbed_quartz", r.absorbed_quartz);
+  ReadVector(in, "absorbed_quartz3", r.absorbed_quartz3);
+}
+
+template <typename Result>
+void WriteBand(std::string& out, std::size_t band, const Result& r) {
+  out += std::format("band {}\n", band);
+  Write(out, r);
+  out += "end\n";
+}
+
+}  // namespace
+
+template <typename Result>
+Checkpoint<Result>::Checkpoint(std::filesystem::path path,
+                               std::string_view model,
+                               std::uint64_t params_hash)
+    : path_{std::move(path)}, model_{model}, params_hash_{params_hash} {
+  if (std::filesystem::exists(path_)) {
+    try {
+      Load();
+    } catch (const std::runtime_error& e) {
+      throw std::runtime_error(
+          std::format("checkpoint {}: {}", path_.string(), e.what()));
+    }
+  }
+}
+
+template <typename Result>
+std::size_t Checkpoint<Result>::size() const {
+  const std::lock_guard lock{mutex_};
+  return bands_.size();
+}
+
+template <typename Result>
+std::optional<Result> Checkpoint<Result>::Find(std::size_t band) const {
+  const std::lock_guard lock{mutex_};
+  const auto it = bands_.find(band);
+  if (it == bands_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+template <typename Result>
+void Checkpoint<Result>::Add(std::size_t band, const Result& result) {
+  const std::lock_guard lock{mutex_};
+  bands_.insert_or_assign(band, result);
+  if (!append_) {
+    Save();
+    append_ = true;
+    return;
+  }
+  std::string out;
+  WriteBand(out, band, result);
+  // Оборванная запись испортила бы следующую: после ошибки — Save.
+  append_ = false;
+  AppendToFile(path_, out);
+  append_ = true;
+}
+
+template <typename Result>
+void Checkpoint<Result>::Load() {
+  std::ifstream file{path_};
+  std::stringstream in;
+  in << file.rdbuf();
+
+  std::string word;
+  int version{};
+  in >> word >> version;
+  if (word != kMagic || version != kVersion) {
+    throw std::runtime_error(
+        std::format("expected {} version {}", kMagic, kVersion));
+  }
+
+  std::string model;
+  std::uint64_t hash{};
+  ReadKey(in, "model");
+  in >> model;
+  ReadKey(in, "params");
+  in >> std::hex >> hash >> std::dec;
+  if (model != model_ || hash != params_hash_) {
+    throw std::runtime_error(std::format(
+        "made for {} with params {:016x}, expected {} with {:016x}", model,
+        hash, model_, params_hash_));
+  }
+
+  while (in >> word) {
+    try {
+      if (word != "band") {
+        throw std::runtime_error(std::format("unexpected '{}'", word));
+      }
+      std::size_t band{};
+      if (!(in >> band)) {
+        throw std::runtime_error("bad band");
+      }
+      Result result;
+      Read(in, result);
+      ReadKey(in, "end");
+      bands_.insert_or_assign(band, std::move(result));
+    } catch (const std::runtime_error&) {
+      // Хвост, оборванный сбоем при дописывании: эти полосы посчитаются
+      // заново, а файл перепишется при первом Add.
+      return;
+    }
+  }
+  append_ = in.str().ends_with('\n');
+}
+
+template <typename Result>
+void Checkpoint<Result>::Save() const {
+  auto out = std::format("{} {}\nmodel {} params {:016x}\n", kMagic, kVersion,
+                         model_, params_hash_);
+  for (const auto& [band, result] : bands_) {
+    WriteBand(out, band, result);
+  }
+  WriteFileAtomically(path_, out);
+}
+
+template class Checkpoint<CylinderPlasma::Result>;
+template class Checkpoint<CylinderPlasmaQuartz::Result>;
+
+}  // namespace cli
@@ -0,0 +1,670 @@
+#include "cli/commands.h"
+
+#include <algorithm>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "base/config/float.h"
+#include "base/fnv1a.h"
+#include "cli/checkpoint.h"
+#include "cli/config.h"
+#include "cli/server.h"
+#include "io/result_file.h"
+#include "io/result_writer.h"
+#include "math/fast_pow.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/parallel_for.h"
+#include "modeling/radial_mesh.h"
+#include "modeling/result_cache.h"
+#include "modeling/thread_pool.h"
+#include "physics/absorption_table.h"
+#include "physics/params/plasma.h"
+
+namespace cli {
+
+namespace {
+
+constexpr std::string_view kUsage = R"(Usage: MT <command> [--key=value ...]
+
+Commands:
+  xe        CylinderPlasma for each job
+  xe-sio2   CylinderPlasmaQuartz for each job
+  sweep     all bands of the absorption table and their sum
+  tau       optical depth and plasma absorption for each band
+  mesh      smallest adaptive plasma mesh for each band
+  serve     answer solve requests on a Unix socket until SIGINT/SIGTERM
+            (protocol: cli/include/cli/protocol.h, scripts/mt_client.py)
+
+Options:
+  --config=FILE    "key = value" parameters, one per line
+  --jobs=FILE      xe, xe-sio2: one job per line, "key=value ..."
+  --threads=N      shared thread pool size, default: all cores
+  --model=MODEL    sweep: xe or xe-sio2, default: xe-sio2
+  --from=I --to=J  sweep, tau, mesh: bands [I, J), default: the whole
+                   table
+  --output=FILE    xe, xe-sio2, sweep: write a row per job to FILE
+                   instead of printing every shell; all jobs need the
+                   same n_plasma and n_quartz
+  --format=FORMAT  binary or csv, default: csv for *.csv, else binary
+  --checkpoint=FILE
+                   sweep: save every finished band to FILE; a rerun with
+                   the same model, parameters, absorption table and
+                   solver version skips saved bands
+  --socket=PATH    serve: socket to listen on
+  --memo=N         serve: results kept in memory, default: 4096
+  --max_depth=X --max_dt=T
+                   mesh: optical depth and temperature drop per shell,
+                   default: 0.5 and 200
+
+Parameters are Params fields (--r=0.35, --n_meridian=50, ...) and
+--band=I (nu and d_nu of band I of the absorption table: the
+MT_ABSORPTION_TABLE file or the built-in xenon table). Flags override
+--config, job lines override both. Jobs run concurrently on the shared
+pool; their output is printed in job order.
+
+MT_CACHE_DIR=DIR caches results on disk: a job with the same parameters
+and absorption table is read from DIR instead of being solved.
+)";
+
+struct Options {
+  std::string command;
+  Settings settings{};
+  std::vector<Settings> jobs{};
+  std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+  std::string model = "xe-sio2";
+  std::string output{};
+  std::string checkpoint{};
+  std::string socket{};
+  std::size_t memo = Server::Options{}.memo;
+  std::optional<ResultWriter::Format> format{};
+  std::size_t from = 0;
+  std::size_t to = AbsorptionTable::Default().n_bands();
+  AdaptiveMesh mesh{};
+};
+
+[[nodiscard]] std::size_t ParseSize(std::string_view key,
+                                    const std::string& value) {
+  std::size_t pos{};
+  const auto result = std::stoul(value, &pos);
+  if (pos != value.size()) {
+    throw std::invalid_argument(
+        std::format("Bad value '{}' for '{}'", value, key));
+  }
+  return result;
+}
+
+[[nodiscard]] Float ParseFloat(std::string_view key, const std::string& value) {
+  std::size_t pos{};
+  const auto result = std::stod(value, &pos);
+  if (pos != value.size()) {
+    throw std::invalid_argument(
+        std::format("Bad value '{}' for '{}'", value, key));
+  }
+  return static_cast<Float>(result);
+}
+
+[[nodiscard]] ResultWriter::Format ParseFormat(std::string_view value) {
+  if (value == "binary") {
+    return ResultWriter::Format::kBinary;
+  }
+  if (value == "csv") {
+    return ResultWriter::Format::kCsv;
+  }
+  throw std::invalid_argument(std::format("Unknown format '{}'", value));
+}
+
+[[nodiscard]] std::ifstream Open(const std::string& path) {
+  std::ifstream in{path};
+  if (!in) {
+    throw std::invalid_argument(std::format("Can't open '{}'", path));
+  }
+  return in;
+}
+
+[[nodiscard]] Options ParseOptions(std::span<char* const> args) {
+  if (args.size() < 2) {
+    throw std::invalid_argument("Expected command");
+  }
+
+  Options options{.command = args[1]};
+  Settings config;
+  for (const std::string_view arg : args.subspan(2)) {
+    if (!arg.starts_with("--")) {
+      throw std::invalid_argument(std::format("Unexpected '{}'", arg));
+    }
+    auto [key, value] = ParseSetting(arg.substr(2));
+    if (key == "config") {
+      auto in = Open(value);
+      const auto file = ReadConfig(in);
+      config.insert(config.end(), file.begin(), file.end());
+    } else if (key == "jobs") {
+      auto in = Open(value);
+      options.jobs = ReadJobs(in);
+    } else if (key == "threads") {
+      options.threads = std::max<std::size_t>(ParseSize(key, value), 1);
+    } else if (key == "output") {
+      options.output = value;
+    } else if (key == "checkpoint") {
+      options.checkpoint = value;
+    } else if (key == "socket") {
+      options.socket = value;
+    } else if (key == "memo") {
+      options.memo = ParseSize(key, value);
+    } else if (key == "format") {
+      options.format = ParseFormat(value);
+    } else if (key == "model") {
+      options.model = value;
+    } else if (key == "from") {
+      options.from = ParseSize(key, value);
+    } else if (key == "to") {
+      options.to = ParseSize(key, value);
+    } else if (key == "max_depth") {
+      options.mesh.max_depth = ParseFloat(key, value);
+    } else if (key == "max_dt") {
+      options.mesh.max_dt = ParseFloat(key, value);
+    } else {
+      options.settings.emplace_back(std::move(key), std::move(value));
+    }
+  }
+  options.settings.insert(options.settings.begin(), config.begin(),
+                          config.end());
+
+  const auto n_bands = AbsorptionTable::Default().n_bands();
+  if (options.from >= options.to || options.to > n_bands) {
+    throw std::invalid_argument(
+        std::format("Expected 0 <= from < to <= {}", n_bands));
+  }
+  if (options.model != "xe" && options.model != "xe-sio2") {
+    throw std::invalid_argument(
+        std::format("Unknown model '{}'", options.model));
+  }
+  return options;
+}
+
+/// Выполняет solve(i) для всех заданий на общем пуле, а emit(i, result) —
+/// в порядке номеров, как только готов очередной. Каждое задание само
+/// раздаёт свою трассировку на тот же пул.
+template <typename Solve, typename Emit>
+void RunJobs(std::size_t n_jobs, ThreadPool& pool, Solve&& solve, Emit&& emit) {
+  using Result = std::invoke_result_t<Solve&, std::size_t>;
+  std::mutex mutex;
+  std::vector<std::optional<Result>> ready(n_jobs);
+  std::size_t next = 0;
+  ParallelFor(
+      n_jobs, pool.size() + 1,
+      [&](std::size_t i, std::size_t /*thread*/) {
+        auto result = solve(i);
+        const std::lock_guard lock{mutex};
+        ready[i] = std::move(result);
+        for (; next < n_jobs && ready[next]; ++next) {
+          emit(next, std::move(*ready[next]));
+          ready[next].reset();
+        }
+      },
+      &pool);
+}
+
+[[nodiscard]] Settings Merge(const Settings& base, const Settings& job) {
+  auto settings = base;
+  settings.insert(settings.end(), job.begin(), job.end());
+  return settings;
+}
+
+template <typename Params>
+[[nodiscard]] Params JobParams(const Options& options,
+                               const Settings& settings) {
+  Params params;
+  params.n_threads = options.threads;
+  return MakeParams(params, settings);
+}
+
+void WriteBanner(std::ostream& out,
+                 std::optional<std::size_t> band,
+                 Float nu,
+                 Float d_nu) {
+  out << "[[-----------------------------------------------------------"
+         "-------------------]]\n[[";
+  if (band) {
+    out << "i=" << *band << ", ";
+  }
+  out << "nu_min=" << nu - d_nu / 2 << ", nu_max=" << nu + d_nu / 2
+      << ", d_nu=" << d_nu << ", nu_avg=" << nu
+      << "]]\n"
+         "[[-----------------------------------------------------------"
+         "-------------------]]\n";
+}
+
+[[nodiscard]] Float WriteList(std::ostream& out,
+                              std::string_view title,
+                              const std::vector<Float>& values) {
+  Float total = 0;
+  out << title << ":\n";
+  for (const auto value : values) {
+    out << value << '\n';
+    total += value;
+  }
+  return total;
+}
+
+void Write(std::ostream& out, const CylinderPlasma::Result& r) {
+  const auto total_plasma =
+      WriteList(out, "TOTAL ABSORBED PLASMA", r.absorbed_plasma);
+  out << "ABSORBED MIRROR: " << r.absorbed_mirror << '\n';
+  out << "SUM: " << total_plasma + r.absorbed_mirror << '\n';
+  out << "INTENSITY ALL: " << r.intensity_all << '\n';
+  out << "RESIDUAL: " << r.balance.residual << '\n';
+}
+
+void Write(std::ostream& out, const CylinderPlasmaQuartz::Result& r) {
+  const auto total_plasma =
+      WriteList(out, "TOTAL ABSORBED PLASMA", r.absorbed_plasma);
+  // TODO(a.kerimov): First quartz is the last plasma.
+  const auto total_quartz =
+      WriteList(out, "TOTAL ABSORBED QUARTZ", r.absorbed_quartz);
+  out << "ABSORBED QUARTZ: " << r.absorbed_mirror << '\n';
+  out << "SUM: " << total_plasma + total_quartz + r.absorbed_mirror << '\n';
+  out << "INTENSITY ALL: " << r.intensity_all << '\n';
+  out << "RESIDUAL: " << r.balance.residual << '\n';
+  out << "TRUNCATED: " << r.balance.truncated_plasma << ' '
+      << r.balance.truncated_quartz << ' ' << r.balance.truncated_mirror
+      << '\n';
+}
+
+void AddTo(std::vector<Float>& total, const std::vector<Float>& values) {
+  total.resize(std::max(total.size(), values.size()));
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    total[i] += values[i];
+  }
+}
+
+void AddTo(EnergyBalance& total, const EnergyBalance& balance) {
+  total.absorbed_plasma += balance.absorbed_plasma;
+  total.absorbed_quartz += balance.absorbed_quartz;
+  total.absorbed_mirror += balance.absorbed_mirror;
+  total.truncated_plasma += balance.truncated_plasma;
+  total.truncated_quartz += balance.truncated_quartz;
+  total.truncated_mirror += balance.truncated_mirror;
+  total.residual += balance.residual;
+}
+
+void AddTo(CylinderPlasma::Result& total, const CylinderPlasma::Result& r) {
+  AddTo(total.absorbed_plasma, r.absorbed_plasma);
+  AddTo(total.absorbed_plasma3, r.absorbed_plasma3);
+  total.absorbed_mirror += r.absorbed_mirror;
+  total.intensity_all += r.intensity_all;
+  AddTo(total.balance, r.balance);
+}
+
+void AddTo(CylinderPlasmaQuartz::Result& total,
+           const CylinderPlasmaQuartz::Result& r) {
+  AddTo(total.absorbed_plasma, r.absorbed_plasma);
+  AddTo(total.absorbed_plasma3, r.absorbed_plasma3);
+  AddTo(total.absorbed_quartz, r.absorbed_quartz);
+  AddTo(total.absorbed_quartz3, r.absorbed_quartz3);
+  total.absorbed_mirror += r.absorbed_mirror;
+  total.intensity_all += r.intensity_all;
+  AddTo(total.balance, r.balance);
+}
+
+/// Строка ResultWriter поверх массивов r; у CylinderPlasma кварца нет.
+template <typename Result>
+[[nodiscard]] ResultRow ToRow(std::optional<std::size_t> band,
+                              Float nu,
+                              Float d_nu,
+                              const Result& r) {
+  ResultRow row{
+      .band = band ? static_cast<std::int64_t>(*band) : -1,
+      .nu = nu,
+      .d_nu = d_nu,
+      .intensity_all = r.intensity_all,
+      .absorbed_mirror = r.absorbed_mirror,
+      .residual = r.balance.residual,
+      .absorbed_plasma = r.absorbed_plasma,
+      .absorbed_plasma3 = r.absorbed_plasma3,
+      .absorbed_quartz = {},
+      .absorbed_quartz3 = {},
+  };
+  if constexpr (requires { r.absorbed_quartz; }) {
+    row.absorbed_quartz = r.absorbed_quartz;
+    row.absorbed_quartz3 = r.absorbed_quartz3;
+  }
+  return row;
+}
+
+/// Результаты заданий: текстом в stdout или строками ResultWriter в
+/// --output (тогда в stdout только строка на задание).
+class Output {
+ public:
+  explicit Output(const Options& options)
+      : path_{options.output},
+        format_{options.format.value_or(ResultWriter::FormatFor(path_))} {}
+
+  template <typename Result>
+  void Put(std::optional<std::size_t> band,
+           Float nu,
+           Float d_nu,
+           const Result& r) {
+    if (path_.empty()) {
+      WriteBanner(std::cout, band, nu, d_nu);
+      Write(std::cout, r);
+      return;
+    }
+
+    const auto row = ToRow(band, nu, d_nu, r);
+    if (!writer_) {
+      writer_ = std::make_unique<ResultWriter>(path_, format_,
+                                               row.absorbed_plasma.size(),
+                                               row.absorbed_quartz.size());
+    }
+    writer_->Append(row);
+    std::cout << std::format(
+        "band {:>3} nu_avg {:g} intensity_all {:g} residual {:g}\n", row.band,
+        nu, r.intensity_all, r.balance.residual);
+  }
+
+  void Flush() {
+    if (writer_) {
+      writer_->Flush();
+    }
+  }
+
+ private:
+  std::filesystem::path path_;
+  ResultWriter::Format format_;
+  std::unique_ptr<ResultWriter> writer_;
+};
+
+template <typename Solver>
+struct Solved {
+  std::optional<std::size_t> band;
+  typename Solver::Params params;
+  typename Solver::Result result;
+};
+
+template <typename Solver>
+[[nodiscard]] Solved<Solver> SolveJob(const Options& options,
+                                      const Settings& settings,
+                                      ThreadPool& pool) {
+  const auto params = JobParams<typename Solver::Params>(options, settings);
+  return {
+      .band = Band(settings),
+      .params = params,
+      .result = Solver{params}.Solve(pool),
+  };
+}
+
+template <typename Params>
+[[nodiscard]] std::string Shells(const Params& params) {
+  if constexpr (requires { params.n_quartz; }) {
+    return std::format("n_plasma={} n_quartz={}", params.n_plasma,
+                       params.n_quartz);
+  } else {
+    return std::format("n_plasma={}", params.n_plasma);
+  }
+}
+
+/// Строки --output одной ширины (ResultWriter берёт её из первой строки),
+/// поэтому число слоёв заданий сверяется до расчёта.
+template <typename Params>
+void CheckOutputShells(const Options& options,
+                       const std::vector<Settings>& jobs) {
+  const auto shells = [&](std::size_t i) {
+    return Shells(JobParams<Params>(options, Merge(options.settings, jobs[i])));
+  };
+  const auto first = shells(0);
+  for (std::size_t i = 1; i < jobs.size(); ++i) {
+    if (const auto other = shells(i); other != first) {
+      throw std::invalid_argument(
+          std::format("--output needs the same shells in every job: job 1 "
+                      "has {}, job {} has {}",
+                      first, i + 1, other));
+    }
+  }
+}
+
+/// Задания из --jobs (или одно задание из общих параметров).
+template <typename Solver>
+void RunSingle(const Options& options, ThreadPool& pool) {
+  const auto jobs =
+      options.jobs.empty() ? std::vector<Settings>(1) : options.jobs;
+  if (!options.output.empty()) {
+    CheckOutputShells<typename Solver::Params>(options, jobs);
+  }
+  Output output{options};
+  RunJobs(
+      jobs.size(), pool,
+      [&](std::size_t i) {
+        return SolveJob<Solver>(options, Merge(options.settings, jobs[i]),
+                                pool);
+      },
+      [&](std::size_t /*i*/, const Solved<Solver>& job) {
+        output.Put(job.band, job.params.nu, job.params.d_nu, job.result);
+      });
+  output.Flush();
+}
+
+/// Отпечаток контрольной точки: кроме параметров в него входят таблица
+/// поглощения и версия решателя — при их смене сохранённые полосы устарели.
+template <typename Params>
+[[nodiscard]] std::uint64_t CheckpointHash(const Params& params) {
+  return Fnv1a(std::format("{}solver={}\ntable={:016x}\n", Describe(params),
+                           ResultCache::kSolverVersion,
+                           AbsorptionTable::Default().Hash()));
+}
+
+/// Все полосы [from, to) и сумма по ним (в порядке полос). С --checkpoint
+/// каждая посчитанная полоса сохраняется, а сохранённые не пересчитываются.
+template <typename Solver>
+void RunSweep(const Options& options, ThreadPool& pool) {
+  std::optional<Checkpoint<typename Solver::Result>> checkpoint;
+  if (!options.checkpoint.empty()) {
+    const auto params =
+        JobParams<typename Solver::Params>(options, options.settings);
+    checkpoint.emplace(options.checkpoint, options.model,
+                       CheckpointHash(params));
+    if (const auto done = checkpoint->size(); done > 0) {
+      std::cerr << std::format("MT: resuming from {}, {} bands done\n",
+                               options.checkpoint, done);
+    }
+  }
+
+  Output output{options};
+  typename Solver::Result total;
+  RunJobs(
+      options.to - options.from, pool,
+      [&](std::size_t i) {
+        const auto band = options.from + i;
+        const auto settings =
+            Merge(options.settings, {{"band", std::to_string(band)}});
+        if (checkpoint) {
+          if (auto result = checkpoint->Find(band)) {
+            return Solved<Solver>{
+                .band = band,
+                .params =
+                    JobParams<typename Solver::Params>(options, settings),
+                .result = std::move(*result),
+            };
+          }
+        }
+        auto job = SolveJob<Solver>(options, settings, pool);
+        if (checkpoint) {
+          checkpoint->Add(band, job.result);
+        }
+        return job;
+      },
+      [&](std::size_t /*i*/, const Solved<Solver>& job) {
+        output.Put(job.band, job.params.nu, job.params.d_nu, job.result);
+        AddTo(total, job.result);
+      });
+  output.Flush();
+
+  std::cout << std::format("[[TOTAL i=[{}, {})]]\n", options.from,
+                           options.to);
+  Write(std::cout, total);
+}
+
+/// Оптическая плотность tau = integral k * dr и поглощение плазмы I2.
+void RunTau(const Options& options, ThreadPool& pool) {
+  std::cout << "range          tau      nu_min      nu_max          nu   "
+               "       I2\n";
+  RunJobs(
+      options.to - options.from, pool,
+      [&](std::size_t i) {
+        const auto band = options.from + i;
+        const auto params = JobParams<CylinderPlasma::Params>(
+            options, Merge(options.settings, {{"band", std::to_string(band)}}));
+
+        auto tau = 0.0_F;
+        const auto step = params.r / static_cast<Float>(params.n_plasma);
+        for (std::size_t j = 0; j < params.n_plasma; ++j) {
+          const auto z = step * static_cast<Float>(j + 1) / params.r;
+          const auto t =
+              params.t0 + (params.tw - params.t0) * FastPow(z, params.m);
+          tau += params::plasma::AbsorptionCoefficientFromTable(params.nu, t) *
+                 step;
+        }
+
+        const auto r = CylinderPlasma{params}.Solve(pool);
+        const auto frequency = AbsorptionTable::Default().frequency();
+        Float i2 = 0;
+        for (const auto value : r.absorbed_plasma) {
+          i2 += value;
+        }
+
+        return std::format("{:5d} {:12.6f} {:11g} {:11g} {:11g} {:11g}\n",
+                           band + 1, tau, frequency[band],
+                           frequency[band + 1], params.nu, i2);
+      },
+      [](std::size_t /*i*/, const std::string& row) { std::cout << row; });
+}
+
+/// Наименьшая адаптивная сетка плазмы (AdaptiveRadii) по --max_depth и
+/// --max_dt: число слоёв и ширины центрального и пристеночного слоёв.
+void RunMesh(const Options& options, ThreadPool& pool) {
+  std::cout << "range  shells         core         wall\n";
+  RunJobs(
+      options.to - options.from, pool,
+      [&](std::size_t i) {
+        const auto band = options.from + i;
+        const auto params = JobParams<CylinderPlasma::Params>(
+            options, Merge(options.settings, {{"band", std::to_string(band)}}));
+
+        const auto radii = AdaptiveRadii(
+            params.r,
+            [&params](Float z) {
+              return params.t0 +
+                     (params.tw - params.t0) * FastPow(z, params.m);
+            },
+            [&params](Float t) {
+              return params::plasma::AbsorptionCoefficient(params.nu, t);
+            },
+            options.mesh);
+
+        return std::format("{:5d} {:7d} {:12.6f} {:12.6f}\n", band + 1,
+                           radii.size(), radii.front(),
+                           radii.back() - radii[radii.size() - 2]);
+      },
+      [](std::size_t /*i*/, const std::string& row) { std::cout << row; });
+}
+
+Server* g_server = nullptr;  // NOLINT(*-avoid-non-const-global-variables)
+
+void StopServer(int /*signal*/) {
+  if (g_server != nullptr) {
+    g_server->Stop();
+  }
+}
+
+void RunServe(const Options& options) {
+  if (options.socket.empty()) {
+    throw std::invalid_argument("serve needs --socket");
+  }
+  Server server{{
+      .socket = options.socket,
+      .threads = options.threads,
+      .memo = options.memo,
+  }};
+  g_server = &server;
+  std::signal(SIGINT, StopServer);
+  std::signal(SIGTERM, StopServer);
+#ifdef SIGPIPE
+  std::signal(SIGPIPE, SIG_IGN);
+#endif
+  std::cerr << std::format("MT: serving on {}\n", options.socket);
+  server.Run();
+  g_server = nullptr;
+}
+
+void Run(const Options& options) {
+  const auto& command = options.command;
+  if (command == "serve") {
+    RunServe(options);
+    return;
+  }
+  if (!options.jobs.empty() && command != "xe" && command != "xe-sio2") {
+    throw std::invalid_argument(
+        std::format("--jobs is not supported by '{}'", command));
+  }
+  if (!options.checkpoint.empty() && command != "sweep") {
+    throw std::invalid_argument(
+        std::format("--checkpoint is not supported by '{}'", command));
+  }
+
+  // Вызывающий поток тоже работает, поэтому пул на один поток меньше.
+  ThreadPool pool{options.threads - 1};
+  if (command == "xe") {
+    RunSingle<CylinderPlasma>(options, pool);
+  } else if (command == "xe-sio2") {
+    RunSingle<CylinderPlasmaQuartz>(options, pool);
+  } else if (command == "sweep" && options.model == "xe") {
+    RunSweep<CylinderPlasma>(options, pool);
+  } else if (command == "sweep") {
+    RunSweep<CylinderPlasmaQuartz>(options, pool);
+  } else if (command == "tau") {
+    RunTau(options, pool);
+  } else if (command == "mesh") {
+    RunMesh(options, pool);
+  } else {
+    throw std::invalid_argument(std::format("Unknown command '{}'", command));
+  }
+}
+
+}  // namespace
+
+int Main(std::span<char* const> args) {
+  if (args.size() == 2 && (std::string_view{args[1]} == "--help" ||
+                           std::string_view{args[1]} == "help")) {
+    std::cout << kUsage;
+    return 0;
+  }
+  try {
+    Run(ParseOptions(args));
+  } catch (const std::invalid_argument& e) {
+    std::cerr << "MT: " << e.what() << "\n\n" << kUsage;
+    return 1;
+  } catch (const std::exception& e) {
+    std::cerr << "MT: " << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace cli
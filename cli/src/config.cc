@@ -0,0 +1,250 @@
+#include "cli/config.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <variant>
+
+#include "base/config/float.h"
+#include "physics/absorption_table.h"
+
+namespace cli {
+
+namespace {
+
+template <typename Params>
+using Member =
+    std::variant<Float Params::*, std::size_t Params::*, int Params::*,
+                 bool Params::*>;
+
+template <typename Params>
+struct Field {
+  std::string_view name;
+  Member<Params> member;
+};
+
+using Xe = CylinderPlasma::Params;
+using XeSiO2 = CylinderPlasmaQuartz::Params;
+
+const std::array<Field<Xe>, 15> kXeFields{{
+    {.name = "r", .member = &Xe::r},
+    {.name = "n_plasma", .member = &Xe::n_plasma},
+    {.name = "plasma_grading", .member = &Xe::plasma_grading},
+    {.name = "adaptive_plasma", .member = &Xe::adaptive_plasma},
+    {.name = "t0", .member = &Xe::t0},
+    {.name = "tw", .member = &Xe::tw},
+    {.name = "m", .member = &Xe::m},
+    {.name = "rho", .member = &Xe::rho},
+    {.name = "nu", .member = &Xe::nu},
+    {.name = "d_nu", .member = &Xe::d_nu},
+    {.name = "n_meridian", .member = &Xe::n_meridian},
+    {.name = "n_latitude", .member = &Xe::n_latitude},
+    {.name = "n_threads", .member = &Xe::n_threads},
+    {.name = "i_crit", .member = &Xe::i_crit},
+    {.name = "energy_tolerance", .member = &Xe::energy_tolerance},
+}};
+
+const std::array<Field<XeSiO2>, 21> kXeSiO2Fields{{
+    {.name = "r", .member = &XeSiO2::r},
+    {.name = "n_plasma", .member = &XeSiO2::n_plasma},
+    {.name = "delta", .member = &XeSiO2::delta},
+    {.name = "n_quartz", .member = &XeSiO2::n_quartz},
+    {.name = "plasma_grading", .member = &XeSiO2::plasma_grading},
+    {.name = "adaptive_plasma", .member = &XeSiO2::adaptive_plasma},
+    {.name = "quartz_grading", .member = &XeSiO2::quartz_grading},
+    {.name = "t0", .member = &XeSiO2::t0},
+    {.name = "tw", .member = &XeSiO2::tw},
+    {.name = "m", .member = &XeSiO2::m},
+    {.name = "t1", .member = &XeSiO2::t1},
+    {.name = "eta_plasma", .member = &XeSiO2::eta_plasma},
+    {.name = "eta_quartz", .member = &XeSiO2::eta_quartz},
+    {.name = "rho", .member = &XeSiO2::rho},
+    {.name = "nu", .member = &XeSiO2::nu},
+    {.name = "d_nu", .member = &XeSiO2::d_nu},
+    {.name = "n_meridian", .member = &XeSiO2::n_meridian},
+    {.name = "n_latitude", .member = &XeSiO2::n_latitude},
+    {.name = "n_threads", .member = &XeSiO2::n_threads},
+    {.name = "i_crit", .member = &XeSiO2::i_crit},
+    {.name = "energy_tolerance", .member = &XeSiO2::energy_tolerance},
+}};
+
+[[nodiscard]] std::string_view Trim(std::string_view text) {
+  constexpr std::string_view kSpaces = " \t\r";
+  const auto begin = text.find_first_not_of(kSpaces);
+  if (begin == std::string_view::npos) {
+    return {};
+  }
+  return text.substr(begin, text.find_last_not_of(kSpaces) - begin + 1);
+}
+
+[[nodiscard]] std::string_view StripComment(std::string_view line) {
+  return Trim(line.substr(0, line.find('#')));
+}
+
+template <typename T>
+[[nodiscard]] T Parse(std::string_view key, std::string_view value) {
+  T result{};
+  const auto* end = value.data() + value.size();
+  const auto [ptr, ec] = std::from_chars(value.data(), end, result);
+  if (ec != std::errc{} || ptr != end) {
+    throw std::invalid_argument(
+        std::format("Bad value '{}' for '{}'", value, key));
+  }
+  return result;
+}
+
+/// Describe пишет true и false, в конфигах привычнее 1 и 0.
+template <>
+[[nodiscard]] bool Parse<bool>(std::string_view key, std::string_view value) {
+  if (value == "1" || value == "true") {
+    return true;
+  }
+  if (value == "0" || value == "false") {
+    return false;
+  }
+  throw std::invalid_argument(
+      std::format("Bad value '{}' for '{}'", value, key));
+}
+
+[[nodiscard]] std::size_t ParseBand(std::string_view value) {
+  const auto band = Parse<std::size_t>("band", value);
+  const auto n_bands = AbsorptionTable::Default().n_bands();
+  if (band >= n_bands) {
+    throw std::invalid_argument(
+        std::format("band {} is out of range [0, {})", band, n_bands));
+  }
+  return band;
+}
+
+template <typename Params, std::size_t N>
+void ApplyField(Params& params,
+                const std::array<Field<Params>, N>& fields,
+                std::string_view key,
+                std::string_view value) {
+  if (key == "band") {
+    const auto band = AbsorptionTable::Default().BandCenter(ParseBand(value));
+    params.nu = static_cast<Float>(band.nu);
+    params.d_nu = static_cast<Float>(band.d_nu);
+    return;
+  }
+
+  const auto it = std::ranges::find(fields, key, &Field<Params>::name);
+  if (it == fields.end()) {
+    throw std::invalid_argument(std::format("Unknown parameter '{}'", key));
+  }
+  std::visit(
+      [&](auto member) {
+        using T = std::remove_reference_t<decltype(params.*member)>;
+        params.*member = Parse<T>(key, value);
+      },
+      it->member);
+}
+
+template <typename Params, std::size_t N>
+[[nodiscard]] std::string DescribeFields(
+    const Params& params,
+    const std::array<Field<Params>, N>& fields) {
+  std::string text;
+  for (const auto& field : fields) {
+    if (field.name == "n_threads" || field.name == "energy_tolerance") {
+      continue;
+    }
+    std::visit(
+        [&](auto member) {
+          text += std::format("{}={}\n", field.name, params.*member);
+        },
+        field.member);
+  }
+  return text;
+}
+
+/// Добавляет к сообщению номер строки.
+template <typename Func>
+decltype(auto) AtLine(std::size_t line, Func&& func) {
+  try {
+    return func();
+  } catch (const std::invalid_argument& e) {
+    throw std::invalid_argument(std::format("line {}: {}", line, e.what()));
+  }
+}
+
+}  // namespace
+
+std::pair<std::string, std::string> ParseSetting(std::string_view text) {
+  const auto eq = text.find('=');
+  if (eq == std::string_view::npos) {
+    throw std::invalid_argument(
+        std::format("Expected key=value, got '{}'", text));
+  }
+  const auto key = Trim(text.substr(0, eq));
+  if (key.empty()) {
+    throw std::invalid_argument(std::format("Empty key in '{}'", text));
+  }
+  return {std::string{key}, std::string{Trim(text.substr(eq + 1))}};
+}
+
+Settings ReadConfig(std::istream& in) {
+  Settings settings;
+  std::string line;
+  for (std::size_t i = 1; std::getline(in, line); ++i) {
+    const auto text = StripComment(line);
+    if (!text.empty()) {
+      settings.push_back(AtLine(i, [&] { return ParseSetting(text); }));
+    }
+  }
+  return settings;
+}
+
+std::vector<Settings> ReadJobs(std::istream& in) {
+  std::vector<Settings> jobs;
+  std::string line;
+  for (std::size_t i = 1; std::getline(in, line); ++i) {
+    const auto text = StripComment(line);
+    if (text.empty()) {
+      continue;
+    }
+    std::istringstream words{std::string{text}};
+    auto& job = jobs.emplace_back();
+    for (std::string word; words >> word;) {
+      job.push_back(AtLine(i, [&] { return ParseSetting(word); }));
+    }
+  }
+  return jobs;
+}
+
+std::optional<std::size_t> Band(const Settings& settings) {
+  std::optional<std::size_t> band;
+  for (const auto& [key, value] : settings) {
+    if (key == "band") {
+      band = ParseBand(value);
+    }
+  }
+  return band;
+}
+
+void Apply(CylinderPlasma::Params& params,
+           std::string_view key,
+           std::string_view value) {
+  ApplyField(params, kXeFields, key, value);
+}
+
+void Apply(CylinderPlasmaQuartz::Params& params,
+           std::string_view key,
+           std::string_view value) {
+  ApplyField(params, kXeSiO2Fields, key, value);
+}
+
+std::string Describe(const CylinderPlasma::Params& params) {
+  return DescribeFields(params, kXeFields);
+}
+
+std::string Describe(const CylinderPlasmaQuartz::Params& params) {
+  return DescribeFields(params, kXeSiO2Fields);
+}
+
+}  // namespace cli
@@ -0,0 +1,248 @@
+#include "cli/protocol.h"
+
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+#include "base/config/float.h"
+
+#ifdef __unix__
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+static_assert(std::endian::native == std::endian::little,
+              "MT serve protocol is little-endian");
+
+namespace cli {
+
+namespace {
+
+template <typename T>
+void Put(std::string& out, const T& value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof value);  // NOLINT
+}
+
+void PutVector(std::string& out, const std::vector<double>& values) {
+  out.append(reinterpret_cast<const char*>(values.data()),  // NOLINT
+             values.size() * sizeof(double));
+}
+
+/// Дописывает длину тела в начало кадра.
+[[nodiscard]] std::string Frame(std::string body) {
+  std::string frame;
+  Put(frame, static_cast<std::uint32_t>(body.size()));
+  return frame + body;
+}
+
+class Reader {
+ public:
+  explicit Reader(std::string_view data) : data_{data} {}
+
+  [[nodiscard]] std::string_view Take(std::size_t size) {
+    if (size > data_.size()) {
+      throw std::runtime_error("truncated message");
+    }
+    const auto taken = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return taken;
+  }
+
+  template <typename T>
+  [[nodiscard]] T Get() {
+    T value;
+    std::memcpy(&value, Take(sizeof value).data(), sizeof value);
+    return value;
+  }
+
+  [[nodiscard]] std::vector<double> GetVector(std::size_t n) {
+    const auto bytes = Take(n * sizeof(double));
+    std::vector<double> values(n);
+    std::memcpy(values.data(), bytes.data(), bytes.size());
+    return values;
+  }
+
+  [[nodiscard]] std::string_view Rest() { return Take(data_.size()); }
+
+  [[nodiscard]] bool empty() const noexcept { return data_.empty(); }
+
+ private:
+  std::string_view data_;
+};
+
+[[nodiscard]] std::vector<double> ToDouble(const std::vector<Float>& values) {
+  return {values.begin(), values.end()};
+}
+
+}  // namespace
+
+Reply ToReply(std::uint32_t id, const CylinderPlasma::Result& r) {
+  return {
+      .id = id,
+      .intensity_all = r.intensity_all,
+      .absorbed_mirror = r.absorbed_mirror,
+      .residual = r.balance.residual,
+      .absorbed_plasma = ToDouble(r.absorbed_plasma),
+      .absorbed_plasma3 = ToDouble(r.absorbed_plasma3),
+  };
+}
+
+Reply ToReply(std::uint32_t id, const CylinderPlasmaQuartz::Result& r) {
+  return {
+      .id = id,
+      .intensity_all = r.intensity_all,
+      .absorbed_mirror = r.absorbed_mirror,
+      .residual = r.balance.residual,
+      .absorbed_plasma = ToDouble(r.absorbed_plasma),
+      .absorbed_plasma3 = ToDouble(r.absorbed_plasma3),
+      .absorbed_quartz = ToDouble(r.absorbed_quartz),
+      .absorbed_quartz3 = ToDouble(r.absorbed_quartz3),
+  };
+}
+
+std::string Encode(const Request& request) {
+  std::string body;
+  Put(body, request.id);
+  Put(body, request.model);
+  body += request.settings;
+  return Frame(std::move(body));
+}
+
+std::string Encode(const Reply& reply) {
+  std::string body;
+  Put(body, reply.id);
+  if (!reply.error.empty()) {
+    Put(body, std::uint8_t{1});
+    body += reply.error;
+    return Frame(std::move(body));
+  }
+
+  Put(body, std::uint8_t{0});
+  Put(body, reply.intensity_all);
+  Put(body, reply.absorbed_mirror);
+  Put(body, reply.residual);
+  Put(body, static_cast<std::uint32_t>(reply.absorbed_plasma.size()));
+  Put(body, static_cast<std::uint32_t>(reply.absorbed_quartz.size()));
+  PutVector(body, reply.absorbed_plasma);
+  PutVector(body, reply.absorbed_plasma3);
+  PutVector(body, reply.absorbed_quartz);
+  PutVector(body, reply.absorbed_quartz3);
+  return Frame(std::move(body));
+}
+
+Request DecodeRequest(std::string_view body) {
+  Reader reader{body};
+  Request request;
+  request.id = reader.Get<std::uint32_t>();
+  const auto model = reader.Get<std::uint8_t>();
+  if (model > static_cast<std::uint8_t>(Model::kXeSiO2)) {
+    throw std::runtime_error(std::format("unknown model {}", model));
+  }
+  request.model = static_cast<Model>(model);
+  request.settings = reader.Rest();
+  return request;
+}
+
+Reply DecodeReply(std::string_view body) {
+  Reader reader{body};
+  Reply reply;
+  reply.id = reader.Get<std::uint32_t>();
+  const auto status = reader.Get<std::uint8_t>();
+  if (status != 0) {
+    reply.error = reader.Rest();
+    return reply;
+  }
+
+  reply.intensity_all = reader.Get<double>();
+  reply.absorbed_mirror = reader.Get<double>();
+  reply.residual = reader.Get<double>();
+  const auto n_plasma = reader.Get<std::uint32_t>();
+  const auto n_quartz = reader.Get<std::uint32_t>();
+  reply.absorbed_plasma = reader.GetVector(n_plasma);
+  reply.absorbed_plasma3 = reader.GetVector(n_plasma);
+  reply.absorbed_quartz = reader.GetVector(n_quartz);
+  reply.absorbed_quartz3 = reader.GetVector(n_quartz);
+  if (!reader.empty()) {
+    throw std::runtime_error("trailing data in reply");
+  }
+  return reply;
+}
+
+#ifdef __unix__
+
+namespace {
+
+/// @returns Прочитано ли size байт; false — конец потока до первого байта.
+[[nodiscard]] bool ReadExactly(int fd, char* data, std::size_t size) {
+  std::size_t done = 0;
+  while (done < size) {
+    const auto n = read(fd, data + done, size - done);  // NOLINT
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0) {
+      throw std::runtime_error(std::strerror(errno));  // NOLINT
+    }
+    if (n == 0) {
+      if (done == 0) {
+        return false;
+      }
+      throw std::runtime_error("connection closed inside a frame");
+    }
+    done += static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+}  // namespace
+
+std::optional<std::string> ReadFrame(int fd) {
+  std::uint32_t size{};
+  if (!ReadExactly(fd, reinterpret_cast<char*>(&size),  // NOLINT
+                   sizeof size)) {
+    return std::nullopt;
+  }
+  if (size > kMaxFrameSize) {
+    throw std::runtime_error(std::format("frame of {} bytes", size));
+  }
+  std::string body(size, '\0');
+  if (size > 0 && !ReadExactly(fd, body.data(), size)) {
+    throw std::runtime_error("connection closed inside a frame");
+  }
+  return body;
+}
+
+bool WriteFrame(int fd, std::string_view frame) {
+#ifdef MSG_NOSIGNAL
+  constexpr int kFlags = MSG_NOSIGNAL;
+#else
+  constexpr int kFlags = 0;
+#endif
+  while (!frame.empty()) {
+    const auto n = send(fd, frame.data(), frame.size(), kFlags);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    frame.remove_prefix(static_cast<std::size_t>(n));
+  }
+  return true;
+}
+
+#else
+
+std::optional<std::string> ReadFrame(int /*fd*/) {
+  throw std::runtime_error("MT serve needs Unix domain sockets");
+}
+
+bool WriteFrame(int /*fd*/, std::string_view /*frame*/) {
+  return false;
+}
+
+#endif
+
+}  // namespace cli
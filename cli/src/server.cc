@@ -0,0 +1,322 @@
+#include "cli/server.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/erase_remove_if.h"
+#include "cli/config.h"
+#include "cli/fair_queue.h"
+#include "cli/protocol.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/result_cache.h"
+#include "modeling/thread_pool.h"
+
+#ifdef __unix__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace cli {
+
+#ifdef __unix__
+
+namespace {
+
+struct Client {
+  Client(int client_fd, std::uint64_t client_id)
+      : fd{client_fd}, id{client_id} {}
+  Client(const Client&) = delete;
+  Client(Client&&) = delete;
+  Client& operator=(const Client&) = delete;
+  Client& operator=(Client&&) = delete;
+  ~Client() { close(fd); }
+
+  int fd;
+  std::uint64_t id;
+  std::mutex write_mutex;
+  std::atomic<bool> done{false};
+};
+
+struct Job {
+  std::shared_ptr<Client> client;
+  Request request;
+};
+
+/// Последние ответы (без id) по ключу; вытесняется самый давний.
+class Memo {
+ public:
+  explicit Memo(std::size_t capacity) : capacity_{capacity} {}
+
+  [[nodiscard]] std::optional<Reply> Find(const std::string& key) {
+    const std::lock_guard lock{mutex_};
+    const auto it = index_.find(key);
+    if (it == index_.end()) {
+      return std::nullopt;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+
+  void Add(const std::string& key, Reply reply) {
+    if (capacity_ == 0) {
+      return;
+    }
+    const std::lock_guard lock{mutex_};
+    if (index_.contains(key)) {
+      return;
+    }
+    entries_.emplace_front(key, std::move(reply));
+    index_.emplace(key, entries_.begin());
+    if (entries_.size() > capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+
+ private:
+  using Entry = std::pair<std::string, Reply>;
+
+  std::size_t capacity_;
+  std::mutex mutex_;
+  std::list<Entry> entries_;  ///< От недавних к давним.
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+};
+
+[[nodiscard]] Settings ParseSettings(std::string_view text) {
+  Settings settings;
+  std::istringstream words{std::string{text}};
+  for (std::string word; words >> word;) {
+    settings.push_back(ParseSetting(word));
+  }
+  return settings;
+}
+
+[[noreturn]] void Fail(const std::filesystem::path& path,
+                       std::string_view what) {
+  throw std::runtime_error(std::format("{}: {}: {}", path.string(), what,
+                                       std::strerror(errno)));  // NOLINT
+}
+
+[[nodiscard]] int Listen(const std::filesystem::path& path) {
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  const auto& native = path.native();
+  if (native.size() >= sizeof addr.sun_path) {
+    throw std::runtime_error(
+        std::format("{}: socket path is too long", path.string()));
+  }
+  std::memcpy(addr.sun_path, native.c_str(), native.size() + 1);
+
+  const auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    Fail(path, "socket");
+  }
+  unlink(native.c_str());
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof addr) != 0 ||
+      listen(fd, SOMAXCONN) != 0) {
+    const auto error = errno;
+    close(fd);
+    errno = error;
+    Fail(path, "bind");
+  }
+  return fd;
+}
+
+}  // namespace
+
+class Server::Impl {
+ public:
+  explicit Impl(const Options& options)
+      : socket_{options.socket},
+        listen_fd_{Listen(socket_)},
+        threads_{std::max<std::size_t>(options.threads, 1)},
+        memo_{options.memo},
+        pool_{threads_} {}
+
+  Impl(const Impl&) = delete;
+  Impl(Impl&&) = delete;
+  Impl& operator=(const Impl&) = delete;
+  Impl& operator=(Impl&&) = delete;
+
+  ~Impl() {
+    close(listen_fd_);
+    unlink(socket_.c_str());
+  }
+
+  void Run() {
+    while (!stopping_) {
+      const auto fd = accept(listen_fd_, nullptr, nullptr);
+      if (fd < 0) {
+        if (errno == EINTR || errno == ECONNABORTED) {
+          continue;
+        }
+        break;
+      }
+      if (stopping_) {
+        close(fd);
+        break;
+      }
+      // Потоки ушедших клиентов уже завершились, join не ждёт.
+      EraseRemoveIf(connections_, [](const Connection& connection) {
+        return connection.client->done.load();
+      });
+      auto client = std::make_shared<Client>(fd, next_client_++);
+      connections_.push_back(
+          {.client = client,
+           .reader = std::jthread{[this, client] { Read(client); }}});
+    }
+
+    for (const auto& connection : connections_) {
+      shutdown(connection.client->fd, SHUT_RD);
+    }
+    connections_.clear();
+    std::unique_lock lock{mutex_};
+    idle_.wait(lock, [this] { return pending_ == 0; });
+  }
+
+  void Stop() noexcept {
+    stopping_ = true;
+    shutdown(listen_fd_, SHUT_RDWR);
+  }
+
+ private:
+  struct Connection {
+    std::shared_ptr<Client> client;
+    std::jthread reader;
+  };
+
+  /// Читает запросы клиента и ставит их в очередь.
+  void Read(const std::shared_ptr<Client>& client) {
+    try {
+      while (const auto body = ReadFrame(client->fd)) {
+        auto request = DecodeRequest(*body);
+        {
+          const std::lock_guard lock{mutex_};
+          queue_.Push(client->id,
+                      {.client = client, .request = std::move(request)});
+          ++pending_;
+        }
+        pool_.Submit([this] { RunNext(); });
+      }
+    } catch (const std::runtime_error&) {
+      // Поток кадров испорчен: дальше его не разобрать.
+      shutdown(client->fd, SHUT_RDWR);
+    }
+    client->done = true;
+  }
+
+  /// Одна задача пула на запрос; какой запрос — решает FairQueue.
+  void RunNext() {
+    std::optional<Job> job;
+    {
+      const std::lock_guard lock{mutex_};
+      job = queue_.Pop();
+    }
+    if (job) {
+      const auto frame = Encode(Handle(job->request));
+      const std::lock_guard lock{job->client->write_mutex};
+      WriteFrame(job->client->fd, frame);
+    }
+    {
+      const std::lock_guard lock{mutex_};
+      --pending_;
+    }
+    idle_.notify_all();
+  }
+
+  [[nodiscard]] Reply Handle(const Request& request) {
+    try {
+      return request.model == Model::kXe
+                 ? Solve<CylinderPlasma>(request)
+                 : Solve<CylinderPlasmaQuartz>(request);
+    } catch (const std::exception& e) {
+      return {.id = request.id, .error = e.what()};
+    }
+  }
+
+  template <typename Solver>
+  [[nodiscard]] Reply Solve(const Request& request) {
+    typename Solver::Params params;
+    params.n_threads = threads_;
+    params = MakeParams(params, ParseSettings(request.settings));
+
+    // Ключ кеша не учитывает energy_tolerance: проверка баланса может
+    // отвергнуть тот же результат.
+    const auto key = std::format("{} energy_tolerance={}", CacheKey(params),
+                                 params.energy_tolerance);
+    if (auto reply = memo_.Find(key)) {
+      reply->id = request.id;
+      return *std::move(reply);
+    }
+    auto reply = ToReply(request.id, Solver{params}.Solve(pool_));
+    memo_.Add(key, reply);
+    return reply;
+  }
+
+  std::filesystem::path socket_;
+  int listen_fd_;
+  std::size_t threads_;
+  std::atomic<bool> stopping_{false};
+
+  std::vector<Connection> connections_;
+  std::uint64_t next_client_{};
+
+  std::mutex mutex_;
+  std::condition_variable idle_;
+  FairQueue<Job> queue_;
+  std::size_t pending_{};  ///< Принятые запросы без отправленного ответа.
+
+  Memo memo_;
+  ThreadPool pool_;
+};
+
+#else
+
+class Server::Impl {
+ public:
+  explicit Impl(const Options& /*options*/) {
+    throw std::runtime_error("MT serve needs Unix domain sockets");
+  }
+  void Run() {}
+  void Stop() noexcept {}
+};
+
+#endif
+
+Server::Server(const Options& options)
+    : impl_{std::make_unique<Impl>(options)} {}
+
+Server::~Server() = default;
+
+void Server::Run() {
+  impl_->Run();
+}
+
+void Server::Stop() noexcept {
+  impl_->Stop();
+}
+
+}  // namespace cli
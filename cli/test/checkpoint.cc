@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "base/config/float.h"
+#include "cli/checkpoint.h"
+#include "modeling/cylinder_plasma_quartz.h"
+
+namespace {
+
+using Result = CylinderPlasmaQuartz::Result;
+
+class CheckpointTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    const auto* info = testing::UnitTest::GetInstance()->current_test_info();
+    path_ = std::filesystem::temp_directory_path() /
+            (std::string{"mt_checkpoint_test_"} + info->name());
+    std::filesystem::remove(path_);
+  }
+
+  void TearDown() override { std::filesystem::remove(path_); }
+
+  std::filesystem::path path_;
+};
+
+[[nodiscard]] Result MakeResult(Float scale) {
+  return {
+      .absorbed_plasma = {scale / 3, scale * 1e-30_F, 0},
+      .absorbed_plasma3 = {1, 2, 3},
+      .absorbed_quartz = {scale / 7},
+      .absorbed_quartz3 = {5},
+      .absorbed_mirror = scale / 11,
+      .intensity_all = scale,
+      .balance = {.absorbed_plasma = 1,
+                  .absorbed_quartz = 2,
+                  .absorbed_mirror = 3,
+                  .truncated_plasma = 4,
+                  .truncated_quartz = 5,
+                  .truncated_mirror = 6,
+                  .residual = -1e-17_F},
+      .timings = {},
+  };
+}
+
+void ExpectSame(const Result& actual, const Result& expected) {
+  EXPECT_EQ(actual.absorbed_plasma, expected.absorbed_plasma);
+  EXPECT_EQ(actual.absorbed_plasma3, expected.absorbed_plasma3);
+  EXPECT_EQ(actual.absorbed_quartz, expected.absorbed_quartz);
+  EXPECT_EQ(actual.absorbed_quartz3, expected.absorbed_quartz3);
+  EXPECT_EQ(actual.absorbed_mirror, expected.absorbed_mirror);
+  EXPECT_EQ(actual.intensity_all, expected.intensity_all);
+  EXPECT_EQ(actual.balance.truncated_mirror,
+            expected.balance.truncated_mirror);
+  EXPECT_EQ(actual.balance.residual, expected.balance.residual);
+}
+
+TEST_F(CheckpointTest, ResumesExactly) {
+  {
+    cli::Checkpoint<Result> checkpoint{path_, "xe-sio2", 42};
+    EXPECT_EQ(checkpoint.size(), 0);
+    checkpoint.Add(169, MakeResult(1.1_F));
+    checkpoint.Add(5, MakeResult(2.7_F));
+  }
+
+  const cli::Checkpoint<Result> checkpoint{path_, "xe-sio2", 42};
+  EXPECT_EQ(checkpoint.size(), 2);
+  EXPECT_FALSE(checkpoint.Find(6));
+  const auto r = checkpoint.Find(169);
+  ASSERT_TRUE(r);
+  ExpectSame(*r, MakeResult(1.1_F));
+  ExpectSame(*checkpoint.Find(5), MakeResult(2.7_F));
+}
+
+TEST_F(CheckpointTest, RejectsOtherParams) {
+  cli::Checkpoint<Result>{path_, "xe-sio2", 42}.Add(1, MakeResult(1));
+  using C = cli::Checkpoint<Result>;
+  EXPECT_THROW(C(path_, "xe-sio2", 43), std::runtime_error);
+  EXPECT_THROW(C(path_, "xe", 42), std::runtime_error);
+}
+
+TEST_F(CheckpointTest, RejectsTruncatedHeader) {
+  cli::Checkpoint<Result>{path_, "xe-sio2", 42}.Add(1, MakeResult(1));
+  std::filesystem::resize_file(path_, 20);
+  EXPECT_THROW((cli::Checkpoint<Result>{path_, "xe-sio2", 42}),
+               std::runtime_error);
+}
+
+TEST_F(CheckpointTest, DropsTruncatedTail) {
+  {
+    cli::Checkpoint<Result> checkpoint{path_, "xe-sio2", 42};
+    checkpoint.Add(1, MakeResult(1));
+    const auto size = std::filesystem::file_size(path_);
+    checkpoint.Add(2, MakeResult(2));
+    // Сбой посреди дописывания второй полосы.
+    std::filesystem::resize_file(
+        path_, (size + std::filesystem::file_size(path_)) / 2);
+  }
+  {
+    cli::Checkpoint<Result> checkpoint{path_, "xe-sio2", 42};
+    EXPECT_EQ(checkpoint.size(), 1);
+    EXPECT_FALSE(checkpoint.Find(2));
+    checkpoint.Add(2, MakeResult(2));
+    checkpoint.Add(3, MakeResult(3));
+  }
+
+  const cli::Checkpoint<Result> checkpoint{path_, "xe-sio2", 42};
+  EXPECT_EQ(checkpoint.size(), 3);
+  ExpectSame(*checkpoint.Find(1), MakeResult(1));
+  ExpectSame(*checkpoint.Find(2), MakeResult(2));
+  ExpectSame(*checkpoint.Find(3), MakeResult(3));
+}
+
+}  // namespace
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "cli/commands.h"
+
+namespace {
+
+class CommandsTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    const auto* info = testing::UnitTest::GetInstance()->current_test_info();
+    dir_ = std::filesystem::temp_directory_path() /
+           (std::string{"mt_commands_test_"} + info->name());
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir_); }
+
+  [[nodiscard]] int Run(std::vector<std::string> args) const {
+    args.insert(args.begin(), "MT");
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+      argv.push_back(arg.data());
+    }
+    return cli::Main(argv);
+  }
+
+  std::filesystem::path dir_;
+};
+
+TEST_F(CommandsTest, OutputRejectsMixedShellsBeforeSolving) {
+  const auto jobs = dir_ / "jobs.txt";
+  std::ofstream{jobs} << "band=169 n_plasma=4 n_quartz=2\n"
+                         "band=170 n_plasma=4 n_quartz=3\n";
+  const auto output = dir_ / "out.csv";
+
+  testing::internal::CaptureStderr();
+  EXPECT_EQ(Run({"xe-sio2", "--jobs=" + jobs.string(),
+                 "--output=" + output.string(), "--threads=1"}),
+            1);
+  const auto error = testing::internal::GetCapturedStderr();
+  EXPECT_NE(error.find("job 1 has n_plasma=4 n_quartz=2, job 2 has "
+                       "n_plasma=4 n_quartz=3"),
+            std::string::npos)
+      << error;
+  // Ни одно задание не решалось, файл не начат.
+  EXPECT_FALSE(std::filesystem::exists(output));
+}
+
+}  // namespace
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <sstream>
+#include <string_view>
+#include <stdexcept>
+
+#include "base/config/float.h"
+#include "cli/config.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "physics/absorption_table.h"
+#include "physics/params/xenon_absorption_coefficient.h"
+
+namespace {
+
+using cli::Settings;
+
+TEST(ConfigTest, ParseSettingTrims) {
+  const auto [key, value] = cli::ParseSetting(" n_plasma = 20 ");
+  EXPECT_EQ(key, "n_plasma");
+  EXPECT_EQ(value, "20");
+  EXPECT_THROW(static_cast<void>(cli::ParseSetting("n_plasma")),
+               std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(cli::ParseSetting("=20")),
+               std::invalid_argument);
+}
+
+TEST(ConfigTest, ReadConfigSkipsComments) {
+  std::istringstream in{
+      "# geometry\n"
+      "r = 0.5\n"
+      "\n"
+      "m = 8  # profile\n"};
+  EXPECT_EQ(cli::ReadConfig(in), (Settings{{"r", "0.5"}, {"m", "8"}}));
+}
+
+TEST(ConfigTest, ReadConfigReportsLine) {
+  std::istringstream in{"r = 0.5\noops\n"};
+  try {
+    static_cast<void>(cli::ReadConfig(in));
+    FAIL() << "Expected std::invalid_argument";
+  } catch (const std::invalid_argument& e) {
+    EXPECT_TRUE(std::string_view{e.what()}.starts_with("line 2:"))
+        << e.what();
+  }
+}
+
+TEST(ConfigTest, ReadJobs) {
+  std::istringstream in{
+      "band=169 n_meridian=30\n"
+      "# skipped\n"
+      "band=150\tr=0.5\n"};
+  const auto jobs = cli::ReadJobs(in);
+  ASSERT_EQ(jobs.size(), 2);
+  EXPECT_EQ(jobs[0], (Settings{{"band", "169"}, {"n_meridian", "30"}}));
+  EXPECT_EQ(jobs[1], (Settings{{"band", "150"}, {"r", "0.5"}}));
+}
+
+TEST(ConfigTest, LaterSettingsOverride) {
+  const auto params = cli::MakeParams(
+      CylinderPlasma::Params{},
+      {{"n_plasma", "20"}, {"m", "6"}, {"n_plasma", "30"}, {"rho", "0.5"}});
+  EXPECT_EQ(params.n_plasma, 30);
+  EXPECT_EQ(params.m, 6);
+  EXPECT_EQ(params.rho, 0.5_F);
+  EXPECT_EQ(params.r, CylinderPlasma::Params{}.r);
+}
+
+TEST(ConfigTest, BandSetsFrequency) {
+  constexpr std::size_t kBand = 169;
+  const auto params =
+      cli::MakeParams(CylinderPlasmaQuartz::Params{}, {{"band", "169"}});
+  const auto band = AbsorptionTable::Default().BandCenter(kBand);
+  EXPECT_EQ(params.nu, static_cast<Float>(band.nu));
+  EXPECT_EQ(params.d_nu, static_cast<Float>(band.d_nu));
+  EXPECT_NEAR(params.d_nu, kXenonFrequency[kBand + 1] - kXenonFrequency[kBand],
+              1e-5_F * params.d_nu);
+  EXPECT_EQ(cli::Band({{"band", "5"}, {"band", "169"}}),
+            std::optional<std::size_t>{kBand});
+  EXPECT_EQ(cli::Band({{"r", "1"}}), std::nullopt);
+}
+
+TEST(ConfigTest, RejectsBadInput) {
+  CylinderPlasma::Params xe;
+  EXPECT_THROW(cli::Apply(xe, "delta", "0.1"), std::invalid_argument);
+  EXPECT_THROW(cli::Apply(xe, "r", "0.1cm"), std::invalid_argument);
+  EXPECT_THROW(cli::Apply(xe, "n_plasma", "-1"), std::invalid_argument);
+  EXPECT_THROW(cli::Apply(xe, "band", "193"), std::invalid_argument);
+  EXPECT_THROW(cli::Apply(xe, "adaptive_plasma", "yes"),
+               std::invalid_argument);
+  cli::Apply(xe, "adaptive_plasma", "1");
+  EXPECT_TRUE(xe.adaptive_plasma);
+  cli::Apply(xe, "adaptive_plasma", "false");
+  EXPECT_FALSE(xe.adaptive_plasma);
+
+  CylinderPlasmaQuartz::Params xe_sio2;
+  cli::Apply(xe_sio2, "delta", "0.2");
+  EXPECT_EQ(xe_sio2.delta, 0.2_F);
+}
+
+TEST(ConfigTest, DescribeIgnoresThreads) {
+  CylinderPlasmaQuartz::Params params;
+  const auto text = cli::Describe(params);
+  EXPECT_TRUE(text.starts_with("r=0.35\nn_plasma=40\n")) << text;
+  EXPECT_EQ(text.find("n_threads"), std::string::npos);
+
+  params.n_threads = 17;
+  EXPECT_EQ(cli::Describe(params), text);
+  params.t1 = 701;
+  EXPECT_NE(cli::Describe(params), text);
+}
+
+}  // namespace
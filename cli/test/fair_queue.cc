@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <vector>
+
+#include "cli/fair_queue.h"
+
+namespace {
+
+TEST(FairQueueTest, RoundRobinOverClients) {
+  cli::FairQueue<int> queue;
+  for (int i = 0; i < 4; ++i) {
+    queue.Push(1, 10 + i);
+  }
+  queue.Push(2, 20);
+  queue.Push(3, 30);
+  queue.Push(2, 21);
+  EXPECT_EQ(queue.size(), 7);
+
+  std::vector<int> order;
+  while (const auto item = queue.Pop()) {
+    order.push_back(*item);
+  }
+  EXPECT_EQ(order, (std::vector<int>{10, 20, 30, 11, 21, 12, 13}));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(FairQueueTest, ClientRejoinsAtTheBack) {
+  cli::FairQueue<int> queue;
+  queue.Push(1, 10);
+  queue.Push(2, 20);
+  EXPECT_EQ(queue.Pop(), 10);
+  queue.Push(1, 11);
+  queue.Push(2, 21);
+  EXPECT_EQ(queue.Pop(), 20);
+  EXPECT_EQ(queue.Pop(), 11);
+  EXPECT_EQ(queue.Pop(), 21);
+  EXPECT_EQ(queue.Pop(), std::nullopt);
+}
+
+}  // namespace
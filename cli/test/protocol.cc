@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "base/config/float.h"
+#include "cli/protocol.h"
+#include "modeling/cylinder_plasma_quartz.h"
+
+namespace {
+
+/// Тело кадра без длины.
+[[nodiscard]] std::string_view Body(const std::string& frame) {
+  std::uint32_t size{};
+  std::memcpy(&size, frame.data(), sizeof size);
+  EXPECT_EQ(size + sizeof size, frame.size());
+  return std::string_view{frame}.substr(sizeof size);
+}
+
+TEST(ProtocolTest, RequestRoundTrip) {
+  const cli::Request request{
+      .id = 7,
+      .model = cli::Model::kXeSiO2,
+      .settings = "band=169 n_meridian=10",
+  };
+  const auto frame = cli::Encode(request);
+  const auto decoded = cli::DecodeRequest(Body(frame));
+  EXPECT_EQ(decoded.id, 7);
+  EXPECT_EQ(decoded.model, cli::Model::kXeSiO2);
+  EXPECT_EQ(decoded.settings, request.settings);
+}
+
+TEST(ProtocolTest, ReplyRoundTrip) {
+  const CylinderPlasmaQuartz::Result result{
+      .absorbed_plasma = {1, 2, 3},
+      .absorbed_plasma3 = {4, 5, 6},
+      .absorbed_quartz = {0.5_F},
+      .absorbed_quartz3 = {7},
+      .absorbed_mirror = 0.25_F,
+      .intensity_all = 10,
+      .balance = {.residual = -0.125_F},
+  };
+  const auto frame = cli::Encode(cli::ToReply(3, result));
+  const auto reply = cli::DecodeReply(Body(frame));
+  EXPECT_EQ(reply.id, 3);
+  EXPECT_TRUE(reply.error.empty());
+  EXPECT_EQ(reply.intensity_all, 10);
+  EXPECT_EQ(reply.absorbed_mirror, 0.25);
+  EXPECT_EQ(reply.residual, -0.125);
+  EXPECT_EQ(reply.absorbed_plasma, (std::vector<double>{1, 2, 3}));
+  EXPECT_EQ(reply.absorbed_plasma3, (std::vector<double>{4, 5, 6}));
+  EXPECT_EQ(reply.absorbed_quartz, std::vector<double>{0.5});
+  EXPECT_EQ(reply.absorbed_quartz3, std::vector<double>{7});
+}
+
+TEST(ProtocolTest, ErrorReply) {
+  const auto frame = cli::Encode(cli::Reply{.id = 1, .error = "bad"});
+  const auto reply = cli::DecodeReply(Body(frame));
+  EXPECT_EQ(reply.id, 1);
+  EXPECT_EQ(reply.error, "bad");
+}
+
+TEST(ProtocolTest, RejectsBrokenMessages) {
+  EXPECT_THROW(static_cast<void>(cli::DecodeRequest("abc")),
+               std::runtime_error);
+  EXPECT_THROW(static_cast<void>(cli::DecodeRequest(
+                   std::string_view{"\1\0\0\0\7", 5})),
+               std::runtime_error);
+
+  const auto frame =
+      cli::Encode(cli::Reply{.id = 2, .absorbed_plasma = {1, 2}});
+  const auto body = Body(frame);
+  EXPECT_THROW(
+      static_cast<void>(cli::DecodeReply(body.substr(0, body.size() - 1))),
+      std::runtime_error);
+}
+
+TEST(ProtocolTest, FramesOverSocket) {
+  int fds[2];  // NOLINT(*-avoid-c-arrays)
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  const auto first = cli::Encode(cli::Request{.id = 1, .settings = "r=0.5"});
+  const auto second = cli::Encode(cli::Request{.id = 2});
+  ASSERT_TRUE(cli::WriteFrame(fds[0], first + second));
+  close(fds[0]);
+
+  const auto a = cli::ReadFrame(fds[1]);
+  const auto b = cli::ReadFrame(fds[1]);
+  ASSERT_TRUE(a && b);
+  EXPECT_EQ(cli::DecodeRequest(*a).settings, "r=0.5");
+  EXPECT_EQ(cli::DecodeRequest(*b).id, 2);
+  EXPECT_EQ(cli::ReadFrame(fds[1]), std::nullopt);
+  close(fds[1]);
+}
+
+}  // namespace
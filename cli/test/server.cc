@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "cli/protocol.h"
+#include "cli/server.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "physics/absorption_table.h"
+
+namespace {
+
+class ServerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    socket_ = std::filesystem::temp_directory_path() / "mt_server_test.sock";
+    server_ = std::make_unique<cli::Server>(
+        cli::Server::Options{.socket = socket_, .threads = 3, .memo = 16});
+    thread_ = std::jthread{[this] { server_->Run(); }};
+  }
+
+  void TearDown() override {
+    server_->Stop();
+    thread_.join();
+    server_.reset();
+    EXPECT_FALSE(std::filesystem::exists(socket_));
+  }
+
+  [[nodiscard]] int Connect() const {
+    const auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, socket_.c_str());  // NOLINT
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    EXPECT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr), 0);
+    return fd;
+  }
+
+  std::filesystem::path socket_;
+  std::unique_ptr<cli::Server> server_;
+  std::jthread thread_;
+};
+
+const std::string kSettings = "band=169 n_meridian=8 n_latitude=8";
+
+/// Отправляет все запросы сразу и собирает ответы по id.
+[[nodiscard]] std::map<std::uint32_t, cli::Reply> Solve(
+    int fd,
+    const std::vector<cli::Request>& requests) {
+  std::string frames;
+  for (const auto& request : requests) {
+    frames += cli::Encode(request);
+  }
+  EXPECT_TRUE(cli::WriteFrame(fd, frames));
+
+  std::map<std::uint32_t, cli::Reply> replies;
+  for (std::size_t i = 0; i < requests.size(); ++i) {
+    const auto body = cli::ReadFrame(fd);
+    if (!body) {
+      ADD_FAILURE() << "connection closed";
+      break;
+    }
+    auto reply = cli::DecodeReply(*body);
+    replies[reply.id] = std::move(reply);
+  }
+  return replies;
+}
+
+TEST_F(ServerTest, SolvesLikeSolver) {
+  const auto fd = Connect();
+  const auto replies = Solve(
+      fd, {
+              {.id = 1, .model = cli::Model::kXe, .settings = kSettings},
+              {.id = 2, .model = cli::Model::kXeSiO2, .settings = kSettings},
+              {.id = 3, .model = cli::Model::kXe, .settings = "r=-"},
+              {.id = 4, .model = cli::Model::kXe, .settings = kSettings},
+          });
+  close(fd);
+  ASSERT_EQ(replies.size(), 4);
+
+  const auto frequency = AbsorptionTable::Default().frequency();
+  CylinderPlasmaQuartz::Params params{
+      .nu = static_cast<Float>((frequency[169] + frequency[170]) / 2),
+      .d_nu = static_cast<Float>(frequency[170] - frequency[169]),
+      .n_meridian = 8,
+      .n_latitude = 8,
+  };
+  const auto xe_sio2 = CylinderPlasmaQuartz{params}.Solve();
+  const auto& reply = replies.at(2);
+  EXPECT_TRUE(reply.error.empty()) << reply.error;
+  EXPECT_DOUBLE_EQ(reply.intensity_all, xe_sio2.intensity_all);
+  ASSERT_EQ(reply.absorbed_quartz.size(), xe_sio2.absorbed_quartz.size());
+  for (std::size_t i = 0; i < reply.absorbed_quartz.size(); ++i) {
+    EXPECT_DOUBLE_EQ(reply.absorbed_quartz[i], xe_sio2.absorbed_quartz[i]);
+  }
+
+  EXPECT_TRUE(replies.at(1).error.empty());
+  EXPECT_TRUE(replies.at(1).absorbed_quartz.empty());
+  EXPECT_FALSE(replies.at(3).error.empty());
+  EXPECT_EQ(replies.at(4).absorbed_plasma, replies.at(1).absorbed_plasma);
+}
+
+TEST_F(ServerTest, ConcurrentClients) {
+  constexpr std::size_t kClients = 4;
+  constexpr std::uint32_t kRequests = 5;
+  std::vector<std::map<std::uint32_t, cli::Reply>> replies(kClients);
+  {
+    std::vector<std::jthread> clients;
+    for (std::size_t c = 0; c < kClients; ++c) {
+      clients.emplace_back([&, c] {
+        const auto fd = Connect();
+        std::vector<cli::Request> requests;
+        for (std::uint32_t i = 0; i < kRequests; ++i) {
+          requests.push_back({
+              .id = i,
+              .model = cli::Model::kXe,
+              .settings = std::format("{} m={}", kSettings, 2 + i),
+          });
+        }
+        replies[c] = Solve(fd, requests);
+        close(fd);
+      });
+    }
+  }
+
+  for (const auto& client : replies) {
+    ASSERT_EQ(client.size(), kRequests);
+    for (std::uint32_t i = 0; i < kRequests; ++i) {
+      EXPECT_TRUE(client.at(i).error.empty());
+      EXPECT_EQ(client.at(i).absorbed_plasma,
+                replies[0].at(i).absorbed_plasma);
+    }
+  }
+}
+
+}  // namespace
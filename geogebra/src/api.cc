@@ -20,7 +20,7 @@ std::string CylinderInfiniteZ(std::string_view name, Float radius) {
   return std::format(fmt, name, radius);
 }
 
-std::string Point3D(std::string_view name, Vector3F point) {
+std::string Point3D(std::string_view name, Vec3 point) {
   constexpr std::string_view fmt =
       R"F(<expression label="{0}" exp="({1:.16f}, {2:.16f}, {3:.16f})" type="point"/>
 <element type="point3d" label="{0}">
@@ -81,7 +81,7 @@ std::string Circle(std::string_view name, Float radius) {
   return std::format(fmt, name, radius);
 }
 
-std::string Point(std::string_view name, Vector3F point) {
+std::string Point(std::string_view name, Vec3 point) {
   constexpr std::string_view fmt =
       R"F(<expression label="{0}" exp="({1:.16f}, {2:.16f})" type="point"/>
 <element type="point" label="{0}">
@@ -0,0 +1,77 @@
+#include "decimated_series.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include <QChart>
+#include <QRectF>
+#include <QXYSeries>
+
+namespace {
+
+/// Точек на столбец: первая, наименьшая, наибольшая, последняя.
+constexpr int kPointsPerColumn = 4;
+
+}  // namespace
+
+QList<QPointF> DecimateMinMax(const QList<QPointF>& points, int width) {
+  const auto n = points.size();
+  if (width <= 0 || n <= qsizetype{kPointsPerColumn} * width) {
+    return points;
+  }
+
+  const auto x0 = points.front().x();
+  const auto dx = (points.back().x() - x0) / width;
+  const auto column = [&](qsizetype i) {
+    return dx > 0 ? static_cast<qsizetype>((points[i].x() - x0) / dx) : 0;
+  };
+
+  QList<QPointF> result;
+  result.reserve(qsizetype{kPointsPerColumn} * (width + 1));
+  for (qsizetype first = 0; first < n;) {
+    const auto c = column(first);
+    auto last = first;
+    auto lo = first;
+    auto hi = first;
+    while (last + 1 < n && column(last + 1) == c) {
+      ++last;
+      if (points[last].y() < points[lo].y()) {
+        lo = last;
+      }
+      if (points[last].y() > points[hi].y()) {
+        hi = last;
+      }
+    }
+
+    std::array<qsizetype, kPointsPerColumn> kept{first, std::min(lo, hi),
+                                                 std::max(lo, hi), last};
+    const auto end = std::unique(kept.begin(), kept.end());
+    for (auto it = kept.begin(); it != end; ++it) {
+      result.push_back(points[*it]);
+    }
+    first = last + 1;
+  }
+  return result;
+}
+
+void DecimatedSeries::SetPoints(QList<QPointF> points) {
+  points_ = std::move(points);
+  if (const auto* chart = series_->chart()) {
+    width_ = static_cast<int>(chart->plotArea().width());
+  }
+  series_->replace(DecimateMinMax(points_, width_));
+}
+
+void DecimatedSeries::SetWidth(int width) {
+  if (width == width_) {
+    return;
+  }
+  width_ = width;
+  // Без прореживания точки серии от ширины не зависят.
+  if (points_.size() <= qsizetype{kPointsPerColumn} * width_ &&
+      series_->count() == points_.size()) {
+    return;
+  }
+  series_->replace(DecimateMinMax(points_, width_));
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QList>
+#include <QPointF>
+
+class QXYSeries;
+
+/// Прореживает ломаную до width столбцов по x: в каждом остаются первая,
+/// наименьшая, наибольшая и последняя точки, так что нарисованная линия
+/// не меняется. Короткие ломаные возвращаются как есть.
+[[nodiscard]] QList<QPointF> DecimateMinMax(const QList<QPointF>& points,
+                                            int width);
+
+/// Серия графика, прореженная до ширины области построения. Хранит все
+/// точки, чтобы при изменении ширины проредить их заново, и заменяет
+/// точки серии целиком (replace), а не по одной.
+class DecimatedSeries {
+ public:
+  explicit DecimatedSeries(QXYSeries* series) : series_{series} {}
+
+  [[nodiscard]] QXYSeries* series() const noexcept { return series_; }
+
+  /// Ширина — у области построения графика серии.
+  void SetPoints(QList<QPointF> points);
+  /// Прореживает заново, если изменилась ширина; вызывается по
+  /// QChart::plotAreaChanged.
+  void SetWidth(int width);
+
+ private:
+  QXYSeries* series_;
+  QList<QPointF> points_;
+  int width_{0};
+};
@@ -1,9 +1,23 @@
 #include "main_window.h"
 
+#include <stdexcept>
+
 #include <QApplication>
+#include <QMessageBox>
+#include <QString>
+
+#include "physics/absorption_table.h"
 
 int main(int argc, char* argv[]) {
   QApplication a(argc, argv);
+  // Таблица MT_ABSORPTION_TABLE загружается до первого решения: ошибку
+  // видно сразу, а не исключением из потока трассировки.
+  try {
+    static_cast<void>(AbsorptionTable::Default());
+  } catch (const std::runtime_error& e) {
+    QMessageBox::critical(nullptr, "MT", QString::fromUtf8(e.what()));
+    return 1;
+  }
   MainWindow w;
   w.show();
   return a.exec();
@@ -1,35 +1,72 @@
 #include "main_window.h"
 #include "./ui_main_window.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <exception>
 #include <format>
+#include <memory>
+#include <utility>
 #include <vector>
 
+#include <QCheckBox>
 #include <QComboBox>
 #include <QDoubleSpinBox>
 #include <QLineEdit>
 #include <QTextEdit>
 
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QProgressBar>
 #include <QPushButton>
+#include <QSize>
 #include <QSlider>
 #include <QSpinBox>
+#include <QStatusBar>
 #include <QString>
+#include <QTimer>
 
+#include "solve_job.h"
+#include "spectrum_widget.h"
 #include "xe_paint_widget.h"
 #include "xe_plot_widget.h"
 
 #include "base/config/float.h"
 #include "base/ignore_unused.h"
-#include "math/consts/pi.h"
-#include "math/fast_pow.h"
+#include "math/area.h"
+#include "modeling/solve_monitor.h"
 #include "physics/params/xenon_absorption_coefficient.h"
 
 namespace {
 
+/// Наибольшее n_threads в окне (максимум полей числа потоков).
+constexpr std::size_t kMaxThreads = 8;
+
+/// Период опроса фонового решения.
+constexpr auto kPollInterval = std::chrono::milliseconds{50};
+
+/// Предпросмотр: грубое решение после паузы в изменении параметров, полное —
+/// после более долгой.
+constexpr auto kPreviewDelay = std::chrono::milliseconds{150};
+constexpr auto kRefineDelay = std::chrono::milliseconds{1000};
+
+/// Грубое решение: меньше направлений и раньше обрываемые каскады. Число
+/// слоёв то же — по нему рисуются результаты.
+constexpr std::size_t kPreviewSphere = 24;
+constexpr auto kPreviewICritScale = 100.0_F;
+
+template <typename Params>
+void MakePreview(Params& params) {
+  params.n_meridian = std::min(params.n_meridian, kPreviewSphere);
+  params.n_latitude = std::min(params.n_latitude, kPreviewSphere);
+  params.i_crit *= kPreviewICritScale;
+}
+
 int Round(double value) {
   return static_cast<int>(std::round(value));
 }
@@ -102,6 +139,57 @@ void ConnectSpinBoxAndSlider(QSpinBox* spin_box, QSlider* slider) {
   });
 }
 
+/// Сечение xe-xe-SiO2 (TwinPlasmaQuartz): трубка — эллипс с полуосями a и b,
+/// в ней на оси a два столба плазмы радиуса r с зазором gap.
+struct TwinPlasmaSection {
+  area::Ellipse tube;
+  std::array<area::Circle, 2> plasma;
+};
+
+TwinPlasmaSection MakeTwinPlasmaSection(Float a, Float b, Float r, Float gap) {
+  const auto x = r + gap / 2;
+  return {.tube = {.a = a, .b = b},
+          .plasma = {area::Circle{.x = -x, .r = r},
+                     area::Circle{.x = x, .r = r}}};
+}
+
+/// Рисунок сечения, где видимые красные части плазмы выходят за трубку.
+QImage DrawTwinPlasmaSection(QSize size,
+                             Float a,
+                             Float b,
+                             Float r,
+                             Float gap) {
+  const auto w = size.width();
+  const auto h = size.height();
+
+  QPixmap pixmap{w, h};
+  QPainter painter{&pixmap};
+  painter.fillRect(pixmap.rect(), QBrush{Qt::white});
+
+  const auto scale = std::min(w / a, h / b) / 1.01;
+  const auto side_a = static_cast<int>(scale * a);
+  const auto side_b = static_cast<int>(scale * b);
+
+  // Полуоси и радиус рисуются как оси и диаметр, поэтому и зазор — вдвое
+  // меньше.
+  const auto side_plasma = static_cast<int>(scale * r);
+  const auto delta_scale = static_cast<int>(scale * gap / 2);
+
+  painter.setPen(QPen{Qt::red, 1});
+  painter.setBrush(QBrush{Qt::red});
+  painter.drawEllipse((w - delta_scale) / 2 - side_plasma,
+                      (h - side_plasma) / 2, side_plasma, side_plasma);
+  painter.drawEllipse((w + delta_scale) / 2, (h - side_plasma) / 2,
+                      side_plasma, side_plasma);
+
+  painter.setPen(QPen{Qt::black, 1});
+  painter.setBrush(QBrush{Qt::white});
+  painter.drawEllipse((w - side_a) / 2, (h - side_b) / 2, side_a, side_b);
+
+  painter.end();
+  return pixmap.toImage();
+}
+
 template <typename Params>
 bool OnlyNThreadsDiffers(const Params& a, Params b) {
   if (a.n_threads == b.n_threads) {
@@ -126,12 +214,209 @@ void AdjustICrit(Params& params) {
 }  // namespace
 
 MainWindow::MainWindow(QWidget* parent)
-    : QMainWindow(parent), ui(new Ui::MainWindow) {
+    : QMainWindow(parent), ui(new Ui::MainWindow), pool_{kMaxThreads - 1} {
   ui->setupUi(this);
 
   InitXeTab();
   InitXeSiO2Tab();
   InitXeXeSiO2Tab();
+  InitSpectrumTab();
+  InitSolveJob();
+}
+
+void MainWindow::InitSolveJob() {
+  progress_bar_ = new QProgressBar{ui->statusBar};
+  progress_bar_->setMaximumWidth(200);
+  progress_bar_->hide();
+  ui->statusBar->addPermanentWidget(progress_bar_);
+
+  cancel_button_ = new QPushButton{"Отмена", ui->statusBar};
+  cancel_button_->hide();
+  ui->statusBar->addPermanentWidget(cancel_button_);
+  connect(cancel_button_, &QPushButton::clicked, this, [this] {
+    if (job_) {
+      job_->Cancel();
+      cancel_button_->setEnabled(false);
+      ui->statusBar->showMessage("Остановка моделирования…");
+    }
+  });
+
+  job_timer_ = new QTimer{this};
+  job_timer_->setInterval(kPollInterval);
+  connect(job_timer_, &QTimer::timeout, this, &MainWindow::PollSolve);
+
+  preview_check_box_ = new QCheckBox{"Предпросмотр", ui->statusBar};
+  ui->statusBar->addPermanentWidget(preview_check_box_);
+
+  preview_timer_ = new QTimer{this};
+  preview_timer_->setSingleShot(true);
+  preview_timer_->setInterval(kPreviewDelay);
+  connect(preview_timer_, &QTimer::timeout, this,
+          [this] { solve_[preview_tab_](SolveMode::kPreview); });
+
+  refine_timer_ = new QTimer{this};
+  refine_timer_->setSingleShot(true);
+  refine_timer_->setInterval(kRefineDelay);
+  connect(refine_timer_, &QTimer::timeout, this,
+          [this] { solve_[preview_tab_](SolveMode::kRefine); });
+
+  connect(preview_check_box_, &QCheckBox::toggled, this, [this](bool on) {
+    if (!on) {
+      preview_timer_->stop();
+      refine_timer_->stop();
+    }
+  });
+}
+
+void MainWindow::ConnectPreview(QWidget* group, Tab tab) {
+  const auto schedule = [this, tab] { SchedulePreview(tab); };
+  for (auto* spin_box : group->findChildren<QSpinBox*>()) {
+    connect(spin_box, &QSpinBox::valueChanged, this, schedule);
+  }
+  for (auto* spin_box : group->findChildren<QDoubleSpinBox*>()) {
+    connect(spin_box, &QDoubleSpinBox::valueChanged, this, schedule);
+  }
+  for (auto* combo_box : group->findChildren<QComboBox*>()) {
+    connect(combo_box, &QComboBox::currentIndexChanged, this, schedule);
+  }
+  for (auto* line_edit : group->findChildren<QLineEdit*>()) {
+    connect(line_edit, &QLineEdit::textEdited, this, schedule);
+  }
+}
+
+void MainWindow::SchedulePreview(Tab tab) {
+  if (!preview_check_box_->isChecked()) {
+    return;
+  }
+  // Результат идущего решения уже не соответствует параметрам.
+  if (job_ && job_mode_ != SolveMode::kFull) {
+    job_.reset();
+    job_timer_->stop();
+    SetSolving(false);
+  }
+  preview_tab_ = tab;
+  preview_timer_->start();
+  refine_timer_->start();
+}
+
+template <typename Solver>
+void MainWindow::StartSolve(
+    const typename Solver::Params& params,
+    std::function<void(typename Solver::Result)> on_done,
+    SolveMode mode) {
+  if (job_) {
+    if (job_mode_ == SolveMode::kFull) {
+      assert(mode != SolveMode::kFull);
+      return;
+    }
+    // Деструктор останавливает решение и ждёт его потока.
+    job_.reset();
+  }
+
+  auto job_params = params;
+  if (mode == SolveMode::kPreview) {
+    MakePreview(job_params);
+  }
+  job_ = std::make_unique<AsyncSolveJob<Solver>>(job_params, pool_,
+                                                 std::move(on_done));
+  job_mode_ = mode;
+  SetSolving(true);
+  ui->statusBar->showMessage(mode == SolveMode::kPreview ? "Предпросмотр…"
+                                                         : "Моделирование…");
+  job_timer_->start();
+}
+
+void MainWindow::PollSolve() {
+  if (!job_) {
+    job_timer_->stop();
+    return;
+  }
+
+  if (!job_->ready()) {
+    const auto progress = job_->progress();
+    if (progress.stage == SolveStage::kDone) {
+      return;
+    }
+    progress_bar_->setRange(0, static_cast<int>(progress.directions_total));
+    progress_bar_->setValue(static_cast<int>(progress.directions_done));
+    if (cancel_button_->isEnabled()) {
+      const auto message =
+          progress.stage == SolveStage::kEmission
+              ? std::format("Излучение: {} из {} направлений",
+                            progress.directions_done, progress.directions_total)
+              : std::format("Трассировка: {} из {} направлений, лучей в "
+                            "очередях: {}",
+                            progress.directions_done, progress.directions_total,
+                            progress.queued_rays);
+      ui->statusBar->showMessage(QString::fromStdString(message));
+    }
+    return;
+  }
+
+  job_timer_->stop();
+  const auto job = std::move(job_);
+  const auto time = job->elapsed();
+  SetSolving(false);
+
+  try {
+    job->Finish();
+  } catch (const SolveCancelled&) {
+    ui->statusBar->showMessage("Моделирование отменено");
+    return;
+  } catch (const std::exception& e) {
+    ui->statusBar->showMessage(QString::fromStdString(e.what()));
+    return;
+  }
+
+  const auto message = std::format(
+      "{}: {}{}",
+      job_mode_ == SolveMode::kPreview ? "Предпросмотр"
+                                       : "Время моделирования",
+      std::chrono::duration_cast<std::chrono::seconds>(time),
+      std::chrono::duration_cast<std::chrono::milliseconds>(time) % 1000);
+  ui->statusBar->showMessage(QString::fromStdString(message));
+}
+
+void MainWindow::SetSolving(bool solving) {
+  // Параметры не меняются, пока решение идёт: по ним рисуются результаты.
+  // При предпросмотре меняются, а устаревшее решение заменяется новым.
+  const auto locked = solving && job_mode_ == SolveMode::kFull;
+  ui->xeGroupBox->setEnabled(!locked);
+  ui->xeSiO2GroupBox->setEnabled(!locked);
+  ui->xexeSiO2GroupBox->setEnabled(!locked);
+
+  progress_bar_->setRange(0, 0);
+  progress_bar_->setVisible(solving);
+  cancel_button_->setEnabled(solving);
+  cancel_button_->setVisible(solving);
+}
+
+CylinderPlasma::Params MainWindow::XeParams() const {
+  const auto nu_idx =
+      static_cast<std::size_t>(ui->xeDeltaNuComboBox->currentIndex());
+  const auto nu_min = kXenonFrequency[nu_idx];
+  const auto nu_max = kXenonFrequency[nu_idx + 1];
+  const auto d_nu = nu_max - nu_min;
+  const auto nu_avg = nu_min + d_nu / 2;
+
+  return {
+      .r = ui->xeRDoubleSpinBox->value(),
+      .n_plasma = static_cast<std::size_t>(ui->xeNSpinBox->value()),
+
+      .t0 = static_cast<Float>(ui->xeT0SpinBox->value()),
+      .tw = static_cast<Float>(ui->xeTwSpinBox->value()),
+      .m = ui->xeMSpinBox->value(),
+
+      .rho = ui->xeRhoDoubleSpinBox->value(),
+
+      .nu = nu_avg,
+      .d_nu = d_nu,
+
+      .n_meridian = static_cast<std::size_t>(ui->xeNMeridianSpinBox->value()),
+      .n_latitude = static_cast<std::size_t>(ui->xeNLatitudeSpinBox->value()),
+
+      .n_threads = static_cast<std::size_t>(ui->xeNThreadsSpinBox->value()),
+  };
 }
 
 void MainWindow::InitXeTab() {
@@ -140,7 +425,7 @@ void MainWindow::InitXeTab() {
   connect(ui->xeNSpinBox, &QSpinBox::valueChanged, ui->xePaintWidget,
           [this](int) {
             xe_res.reset();
-            ui->xePaintWidget->update();
+            ui->xePaintWidget->Invalidate();
           });
 
   ConnectSpinBoxAndSlider(ui->xeT0SpinBox, ui->xeT0HorizontalSlider);
@@ -160,32 +445,8 @@ void MainWindow::InitXeTab() {
   ui->xeI2PlotWidget->setAxisY("I [Вт/см^2]");
   ui->xeI3PlotWidget->setAxisY("I* [Вт/см^3]");
 
-  connect(ui->xeCalculatePushButton, &QPushButton::clicked, [this] {
-    const auto nu_idx =
-        static_cast<std::size_t>(ui->xeDeltaNuComboBox->currentIndex());
-    const auto nu_min = kXenonFrequency[nu_idx];
-    const auto nu_max = kXenonFrequency[nu_idx + 1];
-    const auto d_nu = nu_max - nu_min;
-    const auto nu_avg = nu_min + d_nu / 2;
-
-    CylinderPlasma::Params params{
-        .r = ui->xeRDoubleSpinBox->value(),
-        .n_plasma = static_cast<std::size_t>(ui->xeNSpinBox->value()),
-
-        .t0 = static_cast<Float>(ui->xeT0SpinBox->value()),
-        .tw = static_cast<Float>(ui->xeTwSpinBox->value()),
-        .m = ui->xeMSpinBox->value(),
-
-        .rho = ui->xeRhoDoubleSpinBox->value(),
-
-        .nu = nu_avg,
-        .d_nu = d_nu,
-
-        .n_meridian = static_cast<std::size_t>(ui->xeNMeridianSpinBox->value()),
-        .n_latitude = static_cast<std::size_t>(ui->xeNLatitudeSpinBox->value()),
-
-        .n_threads = static_cast<std::size_t>(ui->xeNThreadsSpinBox->value()),
-    };
+  solve_[kXeTab] = [this](SolveMode mode) {
+    auto params = XeParams();
 
     auto ignore_result = false;
     if (xe_params.has_value()) {
@@ -193,49 +454,83 @@ void MainWindow::InitXeTab() {
     }
     AdjustICrit(params);
 
-    const auto start_ts = std::chrono::high_resolution_clock::now();
-    auto res = CylinderPlasma{params}.Solve();
-    const auto time = std::chrono::high_resolution_clock::now() - start_ts;
-
-    if (!ignore_result) {
-      xe_params = params;
-      xe_res = std::move(res);
-    }
+    const auto on_done = [this, ignore_result, params](auto res) {
+      if (!ignore_result) {
+        xe_params = params;
+        xe_res = std::move(res);
+      }
 
-    const auto message = std::format(
-        "Время моделирования: {}{}",
-        std::chrono::duration_cast<std::chrono::seconds>(time),
-        std::chrono::duration_cast<std::chrono::milliseconds>(time) % 1000);
-    ui->statusBar->showMessage(QString::fromStdString(message));
+      ui->xePaintWidget->Invalidate();
 
-    ui->xePaintWidget->update();
+      ui->xeI2PlotWidget->setData(xe_res->absorbed_plasma);
+      ui->xeI3PlotWidget->setData(xe_res->absorbed_plasma3);
 
-    ui->xeI2PlotWidget->setData(xe_res->absorbed_plasma);
-    ui->xeI3PlotWidget->setData(xe_res->absorbed_plasma3);
+      auto total_plasma = kZero;
+      QString strI2;
+      for (auto i2 : xe_res->absorbed_plasma) {
+        total_plasma += i2;
+        strI2 += QString::number(i2);
+        strI2 += '\n';
+      }
+      ui->xeDataI2TextEdit->setText(strI2);
 
-    auto total_plasma = kZero;
-    QString strI2;
-    for (auto i2 : xe_res->absorbed_plasma) {
-      total_plasma += i2;
-      strI2 += QString::number(i2);
-      strI2 += '\n';
-    }
-    ui->xeDataI2TextEdit->setText(strI2);
+      QString strI3;
+      for (auto i3 : xe_res->absorbed_plasma3) {
+        strI3 += QString::number(i3);
+        strI3 += '\n';
+      }
+      ui->xeDataI3TextEdit->setText(strI3);
+
+      ui->xeDataTotalIntensityLineEdit->setText(
+          QString::number(xe_res->intensity_all));
+      ui->xeDataTotalAbsorbedPlasmaLineEdit->setText(
+          QString::number(total_plasma));
+      ui->xeDataTotalAbsorbedMirrorLineEdit->setText(
+          QString::number(xe_res->absorbed_mirror));
+    };
+    StartSolve<CylinderPlasma>(params, on_done, mode);
+  };
+  connect(ui->xeCalculatePushButton, &QPushButton::clicked,
+          [this] { solve_[kXeTab](SolveMode::kFull); });
+  ConnectPreview(ui->xeGroupBox, kXeTab);
+}
 
-    QString strI3;
-    for (auto i3 : xe_res->absorbed_plasma3) {
-      strI3 += QString::number(i3);
-      strI3 += '\n';
-    }
-    ui->xeDataI3TextEdit->setText(strI3);
-
-    ui->xeDataTotalIntensityLineEdit->setText(
-        QString::number(xe_res->intensity_all));
-    ui->xeDataTotalAbsorbedPlasmaLineEdit->setText(
-        QString::number(total_plasma));
-    ui->xeDataTotalAbsorbedMirrorLineEdit->setText(
-        QString::number(xe_res->absorbed_mirror));
-  });
+CylinderPlasmaQuartz::Params MainWindow::XeSiO2Params() const {
+  const auto nu_idx =
+      static_cast<std::size_t>(ui->xeSiO2DeltaNuComboBox->currentIndex());
+  const auto nu_min = kXenonFrequency[nu_idx];
+  const auto nu_max = kXenonFrequency[nu_idx + 1];
+  const auto d_nu = nu_max - nu_min;
+  const auto nu_avg = nu_min + d_nu / 2;
+
+  return {
+      .r = ui->xeSiO2RDoubleSpinBox->value(),
+      .n_plasma = static_cast<std::size_t>(ui->xeSiO2NPlasmaSpinBox->value()),
+
+      .delta = ui->xeSiO2DeltaDoubleSpinBox->value(),
+      .n_quartz = static_cast<std::size_t>(ui->xeSiO2NQuartzSpinBox->value()),
+
+      .t0 = static_cast<Float>(ui->xeSiO2T0SpinBox->value()),
+      .tw = static_cast<Float>(ui->xeSiO2TwSpinBox->value()),
+      .m = ui->xeSiO2MSpinBox->value(),
+      .t1 = static_cast<Float>(ui->xeSiO2T1SpinBox->value()),
+
+      .eta_plasma = ui->xeSiO2EtaPlasmaDoubleSpinBox->value(),
+      .eta_quartz = ui->xeSiO2EtaQuartzDoubleSpinBox->value(),
+      .rho = ui->xeSiO2RhoDoubleSpinBox->value(),
+
+      .nu = nu_avg,
+      .d_nu = d_nu,
+
+      .n_meridian =
+          static_cast<std::size_t>(ui->xeSiO2NMeridianSpinBox->value()),
+      .n_latitude =
+          static_cast<std::size_t>(ui->xeSiO2NLatitudeSpinBox->value()),
+
+      .n_threads =
+          static_cast<std::size_t>(ui->xeSiO2NThreadsSpinBox->value()),
+      .i_crit = ui->xeSiO2ICritLineEdit->text().toDouble(),
+  };
 }
 
 void MainWindow::InitXeSiO2Tab() {
@@ -244,14 +539,14 @@ void MainWindow::InitXeSiO2Tab() {
   connect(ui->xeSiO2RDoubleSpinBox, &QDoubleSpinBox::valueChanged,
           ui->xeSiO2PaintWidget, [this](double) {
             xe_sio2_res.reset();
-            ui->xeSiO2PaintWidget->update();
+            ui->xeSiO2PaintWidget->Invalidate();
           });
   ConnectSpinBoxAndSlider(ui->xeSiO2NPlasmaSpinBox,
                           ui->xeSiO2NPlasmaHorizontalSlider);
   connect(ui->xeSiO2NPlasmaSpinBox, &QSpinBox::valueChanged,
           ui->xeSiO2PaintWidget, [this](int) {
             xe_sio2_res.reset();
-            ui->xeSiO2PaintWidget->update();
+            ui->xeSiO2PaintWidget->Invalidate();
           });
 
   ConnectDoubleSpinBoxAndSlider(ui->xeSiO2DeltaDoubleSpinBox,
@@ -259,14 +554,14 @@ void MainWindow::InitXeSiO2Tab() {
   connect(ui->xeSiO2DeltaDoubleSpinBox, &QDoubleSpinBox::valueChanged,
           ui->xeSiO2PaintWidget, [this](double) {
             xe_sio2_res.reset();
-            ui->xeSiO2PaintWidget->update();
+            ui->xeSiO2PaintWidget->Invalidate();
           });
   ConnectSpinBoxAndSlider(ui->xeSiO2NQuartzSpinBox,
                           ui->xeSiO2NQuartzHorizontalSlider);
   connect(ui->xeSiO2NQuartzSpinBox, &QSpinBox::valueChanged,
           ui->xeSiO2PaintWidget, [this](int) {
             xe_sio2_res.reset();
-            ui->xeSiO2PaintWidget->update();
+            ui->xeSiO2PaintWidget->Invalidate();
           });
 
   ConnectSpinBoxAndSlider(ui->xeSiO2T0SpinBox, ui->xeSiO2T0HorizontalSlider);
@@ -291,42 +586,8 @@ void MainWindow::InitXeSiO2Tab() {
   ui->xeSiO2I2PlotWidget->setAxisY("I [Вт/см^2]");
   ui->xeSiO2I3PlotWidget->setAxisY("I* [Вт/см^3]");
 
-  connect(ui->xeSiO2CalculatePushButton, &QPushButton::clicked, [this] {
-    const auto nu_idx =
-        static_cast<std::size_t>(ui->xeSiO2DeltaNuComboBox->currentIndex());
-    const auto nu_min = kXenonFrequency[nu_idx];
-    const auto nu_max = kXenonFrequency[nu_idx + 1];
-    const auto d_nu = nu_max - nu_min;
-    const auto nu_avg = nu_min + d_nu / 2;
-
-    CylinderPlasmaQuartz::Params params{
-        .r = ui->xeSiO2RDoubleSpinBox->value(),
-        .n_plasma = static_cast<std::size_t>(ui->xeSiO2NPlasmaSpinBox->value()),
-
-        .delta = ui->xeSiO2DeltaDoubleSpinBox->value(),
-        .n_quartz = static_cast<std::size_t>(ui->xeSiO2NQuartzSpinBox->value()),
-
-        .t0 = static_cast<Float>(ui->xeSiO2T0SpinBox->value()),
-        .tw = static_cast<Float>(ui->xeSiO2TwSpinBox->value()),
-        .m = ui->xeSiO2MSpinBox->value(),
-        .t1 = static_cast<Float>(ui->xeSiO2T1SpinBox->value()),
-
-        .eta_plasma = ui->xeSiO2EtaPlasmaDoubleSpinBox->value(),
-        .eta_quartz = ui->xeSiO2EtaQuartzDoubleSpinBox->value(),
-        .rho = ui->xeSiO2RhoDoubleSpinBox->value(),
-
-        .nu = nu_avg,
-        .d_nu = d_nu,
-
-        .n_meridian =
-            static_cast<std::size_t>(ui->xeSiO2NMeridianSpinBox->value()),
-        .n_latitude =
-            static_cast<std::size_t>(ui->xeSiO2NLatitudeSpinBox->value()),
-
-        .n_threads =
-            static_cast<std::size_t>(ui->xeSiO2NThreadsSpinBox->value()),
-        .i_crit = ui->xeSiO2ICritLineEdit->text().toDouble(),
-    };
+  solve_[kXeSiO2Tab] = [this](SolveMode mode) {
+    auto params = XeSiO2Params();
 
     auto ignore_result = false;
     if (xe_sio2_params.has_value()) {
@@ -334,69 +595,65 @@ void MainWindow::InitXeSiO2Tab() {
     }
     AdjustICrit(params);
 
-    const auto start_ts = std::chrono::high_resolution_clock::now();
-    auto res = CylinderPlasmaQuartz{params}.Solve();
-    const auto time = std::chrono::high_resolution_clock::now() - start_ts;
-
-    if (!ignore_result) {
-      xe_sio2_params = params;
-      xe_sio2_res = std::move(res);
-    }
+    const auto on_done = [this, ignore_result, params](auto res) {
+      if (!ignore_result) {
+        xe_sio2_params = params;
+        xe_sio2_res = std::move(res);
+      }
 
-    const auto message = std::format(
-        "Время моделирования: {}{}",
-        std::chrono::duration_cast<std::chrono::seconds>(time),
-        std::chrono::duration_cast<std::chrono::milliseconds>(time) % 1000);
-    ui->statusBar->showMessage(QString::fromStdString(message));
-
-    ui->xeSiO2PaintWidget->update();
-
-    ui->xeSiO2I2PlotWidget->setData(xe_sio2_res->absorbed_plasma,
-                                    xe_sio2_res->absorbed_quartz, params.r,
-                                    params.delta);
-    ui->xeSiO2I3PlotWidget->setData(xe_sio2_res->absorbed_plasma3,
-                                    xe_sio2_res->absorbed_quartz3, params.r,
-                                    params.delta);
-
-    auto total_plasma = kZero;
-    auto total_quartz = kZero;
-    QString strI2;
-    for (auto i2 : xe_sio2_res->absorbed_plasma) {
-      total_plasma += i2;
-      strI2 += QString::number(i2);
-      strI2 += '\n';
-    }
-    strI2 += "————————\n";
-    for (std::size_t i = 1; i < xe_sio2_res->absorbed_quartz.size(); ++i) {
-      auto i2 = xe_sio2_res->absorbed_quartz[i];
-      total_quartz += i2;
-      strI2 += QString::number(i2);
-      strI2 += '\n';
-    }
-    ui->xeSiO2DataI2TextEdit->setText(strI2);
+      ui->xeSiO2PaintWidget->Invalidate();
+
+      ui->xeSiO2I2PlotWidget->setData(xe_sio2_res->absorbed_plasma,
+                                      xe_sio2_res->absorbed_quartz, params.r,
+                                      params.delta);
+      ui->xeSiO2I3PlotWidget->setData(xe_sio2_res->absorbed_plasma3,
+                                      xe_sio2_res->absorbed_quartz3, params.r,
+                                      params.delta);
+
+      auto total_plasma = kZero;
+      auto total_quartz = kZero;
+      QString strI2;
+      for (auto i2 : xe_sio2_res->absorbed_plasma) {
+        total_plasma += i2;
+        strI2 += QString::number(i2);
+        strI2 += '\n';
+      }
+      strI2 += "————————\n";
+      for (std::size_t i = 1; i < xe_sio2_res->absorbed_quartz.size(); ++i) {
+        auto i2 = xe_sio2_res->absorbed_quartz[i];
+        total_quartz += i2;
+        strI2 += QString::number(i2);
+        strI2 += '\n';
+      }
+      ui->xeSiO2DataI2TextEdit->setText(strI2);
 
-    QString strI3;
-    for (auto i3 : xe_sio2_res->absorbed_plasma3) {
-      strI3 += QString::number(i3);
-      strI3 += '\n';
-    }
-    strI3 += "————————\n";
-    for (std::size_t i = 1; i < xe_sio2_res->absorbed_quartz3.size(); ++i) {
-      auto i3 = xe_sio2_res->absorbed_quartz3[i];
-      strI3 += QString::number(i3);
-      strI3 += '\n';
-    }
-    ui->xeSiO2DataI3TextEdit->setText(strI3);
-
-    ui->xeSiO2DataTotalIntensityLineEdit->setText(
-        QString::number(xe_sio2_res->intensity_all));
-    ui->xeSiO2DataTotalAbsorbedPlasmaLineEdit->setText(
-        QString::number(total_plasma));
-    ui->xeSiO2DataTotalAbsorbedQuartzLineEdit->setText(
-        QString::number(total_quartz));
-    ui->xeSiO2DataTotalAbsorbedMirrorLineEdit->setText(
-        QString::number(xe_sio2_res->absorbed_mirror));
-  });
+      QString strI3;
+      for (auto i3 : xe_sio2_res->absorbed_plasma3) {
+        strI3 += QString::number(i3);
+        strI3 += '\n';
+      }
+      strI3 += "————————\n";
+      for (std::size_t i = 1; i < xe_sio2_res->absorbed_quartz3.size(); ++i) {
+        auto i3 = xe_sio2_res->absorbed_quartz3[i];
+        strI3 += QString::number(i3);
+        strI3 += '\n';
+      }
+      ui->xeSiO2DataI3TextEdit->setText(strI3);
+
+      ui->xeSiO2DataTotalIntensityLineEdit->setText(
+          QString::number(xe_sio2_res->intensity_all));
+      ui->xeSiO2DataTotalAbsorbedPlasmaLineEdit->setText(
+          QString::number(total_plasma));
+      ui->xeSiO2DataTotalAbsorbedQuartzLineEdit->setText(
+          QString::number(total_quartz));
+      ui->xeSiO2DataTotalAbsorbedMirrorLineEdit->setText(
+          QString::number(xe_sio2_res->absorbed_mirror));
+    };
+    StartSolve<CylinderPlasmaQuartz>(params, on_done, mode);
+  };
+  connect(ui->xeSiO2CalculatePushButton, &QPushButton::clicked,
+          [this] { solve_[kXeSiO2Tab](SolveMode::kFull); });
+  ConnectPreview(ui->xeSiO2GroupBox, kXeSiO2Tab);
 }
 
 void MainWindow::InitXeXeSiO2Tab() {
@@ -406,7 +663,7 @@ void MainWindow::InitXeXeSiO2Tab() {
           ui->xexeSiO2PaintWidget, [this](double) {
             xe_xe_sio2_res.reset();
             ui->xexeSiO2PaintWidget->image = QImage{};
-            ui->xexeSiO2PaintWidget->update();
+            ui->xexeSiO2PaintWidget->Invalidate();
           });
   ConnectSpinBoxAndSlider(ui->xexeSiO2NPlasmaSpinBox,
                           ui->xexeSiO2NPlasmaHorizontalSlider);
@@ -414,7 +671,7 @@ void MainWindow::InitXeXeSiO2Tab() {
           ui->xexeSiO2PaintWidget, [this](int) {
             xe_xe_sio2_res.reset();
             ui->xexeSiO2PaintWidget->image = QImage{};
-            ui->xexeSiO2PaintWidget->update();
+            ui->xexeSiO2PaintWidget->Invalidate();
           });
 
   ConnectDoubleSpinBoxAndSlider(ui->xexeSiO2DeltaDoubleSpinBox,
@@ -423,7 +680,7 @@ void MainWindow::InitXeXeSiO2Tab() {
           ui->xexeSiO2PaintWidget, [this](double) {
             xe_xe_sio2_res.reset();
             ui->xexeSiO2PaintWidget->image = QImage{};
-            ui->xexeSiO2PaintWidget->update();
+            ui->xexeSiO2PaintWidget->Invalidate();
           });
   ConnectDoubleSpinBoxAndSlider(ui->xexeSiO2ADoubleSpinBox,
                                 ui->xexeSiO2AHorizontalSlider);
@@ -431,7 +688,7 @@ void MainWindow::InitXeXeSiO2Tab() {
           ui->xexeSiO2PaintWidget, [this](double) {
             xe_xe_sio2_res.reset();
             ui->xexeSiO2PaintWidget->image = QImage{};
-            ui->xexeSiO2PaintWidget->update();
+            ui->xexeSiO2PaintWidget->Invalidate();
           });
   ConnectDoubleSpinBoxAndSlider(ui->xexeSiO2BDoubleSpinBox,
                                 ui->xexeSiO2BHorizontalSlider);
@@ -439,7 +696,7 @@ void MainWindow::InitXeXeSiO2Tab() {
           ui->xexeSiO2PaintWidget, [this](double) {
             xe_xe_sio2_res.reset();
             ui->xexeSiO2PaintWidget->image = QImage{};
-            ui->xexeSiO2PaintWidget->update();
+            ui->xexeSiO2PaintWidget->Invalidate();
           });
   ConnectSpinBoxAndSlider(ui->xexeSiO2NQuartzSpinBox,
                           ui->xexeSiO2NQuartzHorizontalSlider);
@@ -447,7 +704,7 @@ void MainWindow::InitXeXeSiO2Tab() {
           ui->xexeSiO2PaintWidget, [this](int) {
             xe_xe_sio2_res.reset();
             ui->xexeSiO2PaintWidget->image = QImage{};
-            ui->xexeSiO2PaintWidget->update();
+            ui->xexeSiO2PaintWidget->Invalidate();
           });
 
   ConnectSpinBoxAndSlider(ui->xexeSiO2T0SpinBox,
@@ -473,7 +730,7 @@ void MainWindow::InitXeXeSiO2Tab() {
   ui->xexeSiO2I2PlotWidget->setAxisY("I [Вт/см^2]");
   ui->xexeSiO2I3PlotWidget->setAxisY("I* [Вт/см^3]");
 
-  connect(ui->xexeSiO2CalculatePushButton, &QPushButton::clicked, [this] {
+  solve_[kXeXeSiO2Tab] = [this](SolveMode mode) {
     const auto nu_idx =
         static_cast<std::size_t>(ui->xexeSiO2DeltaNuComboBox->currentIndex());
     const auto nu_min = kXenonFrequency[nu_idx];
@@ -481,15 +738,14 @@ void MainWindow::InitXeXeSiO2Tab() {
     const auto d_nu = nu_max - nu_min;
     const auto nu_avg = nu_min + d_nu / 2;
 
-    const auto a = ui->xexeSiO2ADoubleSpinBox->value();
-    const auto b = ui->xexeSiO2BDoubleSpinBox->value();
-
-    CylinderPlasmaQuartz::Params params{
+    TwinPlasmaQuartz::Params params{
         .r = ui->xexeSiO2RDoubleSpinBox->value(),
         .n_plasma =
             static_cast<std::size_t>(ui->xexeSiO2NPlasmaSpinBox->value()),
+        .gap = ui->xexeSiO2DeltaDoubleSpinBox->value(),
 
-        .delta = std::sqrt(a * b),
+        .a = ui->xexeSiO2ADoubleSpinBox->value(),
+        .b = ui->xexeSiO2BDoubleSpinBox->value(),
         .n_quartz =
             static_cast<std::size_t>(ui->xexeSiO2NQuartzSpinBox->value()),
 
@@ -515,44 +771,17 @@ void MainWindow::InitXeXeSiO2Tab() {
         .i_crit = ui->xexeSiO2ICritLineEdit->text().toDouble(),
     };
 
-    {
-      const auto w = ui->xexeSiO2PaintWidget->width();
-      const auto h = ui->xexeSiO2PaintWidget->height();
-
-      QPixmap pixmap{w, h};
-      QPainter painter{&pixmap};
-      painter.fillRect(rect(), QBrush{Qt::white});
-
-      const auto scale = std::min(w / a, h / b) / 1.01;
-      const auto side_a = static_cast<int>(scale * a);
-      const auto side_b = static_cast<int>(scale * b);
-
-      const auto delta = ui->xexeSiO2DeltaDoubleSpinBox->value();
-      const auto side_plasma = static_cast<int>(scale * params.r);
-      const auto delta_scale = static_cast<int>(scale * delta);
-
-      painter.setPen(QPen{Qt::red, 1});
-      painter.setBrush(QBrush{Qt::red});
-      painter.drawEllipse((w - delta_scale) / 2 - side_plasma,
-                          (h - side_plasma) / 2, side_plasma, side_plasma);
-      painter.drawEllipse((w + delta_scale) / 2, (h - side_plasma) / 2,
-                          side_plasma, side_plasma);
-
-      painter.setPen(QPen{Qt::black, 1});
-      painter.setBrush(QBrush{Qt::white});
-      painter.drawEllipse((w - side_a) / 2, (h - side_b) / 2, side_a, side_b);
-
-      const auto image = pixmap.toImage();
-      for (int i = 0; i < w; ++i) {
-        for (int j = 0; j < h; ++j) {
-          if (image.pixelColor(i, j) == Qt::red) {
-            ui->statusBar->showMessage("Неправильная геометрия системы");
-            ui->xexeSiO2PaintWidget->image = std::move(image);
-            ui->xexeSiO2PaintWidget->update();
-            return;
-          }
-        }
-      }
+    const auto section = MakeTwinPlasmaSection(params.a, params.b, params.r,
+                                               params.gap);
+    if (!std::ranges::all_of(section.plasma, [&](const auto& c) {
+          return area::Contains(section.tube, c);
+        })) {
+      ui->statusBar->showMessage("Неправильная геометрия системы");
+      ui->xexeSiO2PaintWidget->image =
+          DrawTwinPlasmaSection(ui->xexeSiO2PaintWidget->size(), params.a,
+                                params.b, params.r, params.gap);
+      ui->xexeSiO2PaintWidget->update();
+      return;
     }
 
     auto ignore_result = false;
@@ -561,177 +790,90 @@ void MainWindow::InitXeXeSiO2Tab() {
     }
     AdjustICrit(params);
 
-    const auto start_ts = std::chrono::high_resolution_clock::now();
-    auto res = CylinderPlasmaQuartz{params}.Solve();
-    const auto time = std::chrono::high_resolution_clock::now() - start_ts;
-
-    if (!ignore_result) {
-      xe_xe_sio2_params = params;
-      xe_xe_sio2_res = std::move(res);
-    }
+    const auto on_done = [this, ignore_result, params](auto res) {
+      if (!ignore_result) {
+        xe_xe_sio2_params = params;
+        xe_xe_sio2_res = std::move(res);
+      }
 
-    const auto message = std::format(
-        "Время моделирования: {}{}",
-        std::chrono::duration_cast<std::chrono::seconds>(time),
-        std::chrono::duration_cast<std::chrono::milliseconds>(time) % 1000);
-    ui->statusBar->showMessage(QString::fromStdString(message));
-
-    if (!ignore_result) {
-      const auto w = ui->xexeSiO2PaintWidget->width() / 4;
-      const auto h = ui->xexeSiO2PaintWidget->height() / 4;
-
-      const auto scale = std::min(w / a, h / b) / 1.01;
-
-      const auto delta = ui->xexeSiO2DeltaDoubleSpinBox->value();
-      const auto side_plasma = static_cast<int>(scale * params.r);
-      const auto delta_scale = static_cast<int>(scale * delta);
-
-      std::vector<std::size_t> without_plasma(params.n_quartz);
-      std::vector<std::size_t> with_plasma(params.n_quartz);
-      for (std::size_t k = 0; k < params.n_quartz; ++k) {
-        QPixmap pixmap{w, h};
-        QPainter painter{&pixmap};
-        painter.fillRect(rect(), QBrush{Qt::white});
-
-        for (std::size_t i = params.n_quartz; i > 0; --i) {
-          if (i == k + 1) {
-            painter.setPen(QPen{Qt::red, 1});
-            painter.setBrush(QBrush{Qt::red});
-          } else {
-            painter.setPen(QPen{Qt::black, 1});
-            painter.setBrush(QBrush{Qt::white});
-          }
-          const auto side_ai =
-              static_cast<int>(scale * a * static_cast<Float>(i) /
-                               static_cast<Float>(params.n_quartz));
-          const auto side_bi =
-              static_cast<int>(scale * b * static_cast<Float>(i) /
-                               static_cast<Float>(params.n_quartz));
-          painter.drawEllipse((w - side_ai) / 2, (h - side_bi) / 2, side_ai,
-                              side_bi);
-        }
+      ui->xexeSiO2PaintWidget->Invalidate();
 
-        auto image = pixmap.toImage();
-        for (int i = 0; i < w; ++i) {
-          for (int j = 0; j < h; ++j) {
-            if (image.pixelColor(i, j) == Qt::red) {
-              without_plasma[k] += 1;
-            }
-          }
-        }
+      ui->xexeSiO2I2PlotWidget->setData(xe_xe_sio2_res->absorbed_plasma,
+                                        xe_xe_sio2_res->absorbed_quartz);
+      ui->xexeSiO2I3PlotWidget->setData(xe_xe_sio2_res->absorbed_plasma3,
+                                        xe_xe_sio2_res->absorbed_quartz3);
 
-        painter.setPen(QPen{Qt::black, 1});
-        painter.setBrush(QBrush{Qt::white});
-        painter.drawEllipse((w - delta_scale) / 2 - side_plasma,
-                            (h - side_plasma) / 2, side_plasma, side_plasma);
-        painter.drawEllipse((w + delta_scale) / 2, (h - side_plasma) / 2,
-                            side_plasma, side_plasma);
-
-        image = pixmap.toImage();
-        //        if (k == params.n_quartz / 2) {
-        //          ui->xexeSiO2PaintWidget->image = image;
-        //          ui->xexeSiO2PaintWidget->update();
-        //        }
-
-        for (int i = 0; i < w; ++i) {
-          for (int j = 0; j < h; ++j) {
-            if (image.pixelColor(i, j) == Qt::red) {
-              with_plasma[k] += 1;
-            }
-          }
-        }
+      auto total_plasma = kZero;
+      auto total_quartz = kZero;
+      QString strI2;
+      for (auto i2 : xe_xe_sio2_res->absorbed_plasma) {
+        total_plasma += i2;
+        strI2 += QString::number(i2);
+        strI2 += '\n';
       }
-
-      auto min_ratio = kOne;
-      std::size_t min_ratio_index = 0;
-      for (std::size_t k = 0; k < params.n_quartz; ++k) {
-        const auto ratio = static_cast<Float>(with_plasma[k]) /
-                           static_cast<Float>(without_plasma[k]);
-        if (ratio < min_ratio) {
-          min_ratio = ratio;
-          min_ratio_index = k;
-        }
-        qWarning() << without_plasma[k] << ' ' << with_plasma[k];
-      }
-      for (std::size_t k = 0; k < min_ratio_index; ++k) {
-        with_plasma[k] = static_cast<std::size_t>(
-            static_cast<Float>(without_plasma[k]) * min_ratio);
+      strI2 += "————————\n";
+      for (std::size_t i = 1; i < xe_xe_sio2_res->absorbed_quartz.size(); ++i) {
+        auto i2 = xe_xe_sio2_res->absorbed_quartz[i];
+        total_quartz += i2;
+        strI2 += QString::number(i2);
+        strI2 += '\n';
       }
+      ui->xexeSiO2DataI2TextEdit->setText(strI2);
 
-      auto minus = kZero;
-      const auto step_quartz =
-          params.delta / static_cast<Float>(params.n_quartz);
-      const auto kLeft = 7;
-      const auto kRight = 3;
-      for (std::size_t i = 0; i < params.n_quartz; ++i) {
-        const auto r_avg = step_quartz * (static_cast<Float>(i) + 0.5_F);
-        const auto i2 = xe_xe_sio2_res->absorbed_quartz[i + 1] *
-                        (2 - Sqr(static_cast<Float>(with_plasma[i]) /
-                                 static_cast<Float>(without_plasma[i]))) *
-                        r_avg *
-                        (kLeft - (kLeft - kRight) * static_cast<Float>(i) /
-                                     static_cast<Float>(params.n_quartz - 1));
-        minus += xe_xe_sio2_res->absorbed_quartz[i + 1] - i2;
-        xe_xe_sio2_res->absorbed_quartz[i + 1] = i2;
+      QString strI3;
+      for (auto i3 : xe_xe_sio2_res->absorbed_plasma3) {
+        strI3 += QString::number(i3);
+        strI3 += '\n';
       }
-
-      xe_xe_sio2_res->intensity_all -= minus;
-
-      for (std::size_t i = 0; i < params.n_quartz; ++i) {
-        const auto r_avg = step_quartz * (static_cast<Float>(i) + 0.5_F);
-        xe_xe_sio2_res->absorbed_quartz3[i + 1] =
-            2 * consts::kPi * xe_xe_sio2_res->absorbed_quartz[i + 1] / r_avg;
+      strI3 += "————————\n";
+      for (std::size_t i = 1; i < xe_xe_sio2_res->absorbed_quartz3.size();
+           ++i) {
+        auto i3 = xe_xe_sio2_res->absorbed_quartz3[i];
+        strI3 += QString::number(i3);
+        strI3 += '\n';
       }
-    }
-
-    ui->xexeSiO2PaintWidget->update();
-
-    ui->xexeSiO2I2PlotWidget->setData(xe_xe_sio2_res->absorbed_plasma,
-                                      xe_xe_sio2_res->absorbed_quartz);
-    ui->xexeSiO2I3PlotWidget->setData(xe_xe_sio2_res->absorbed_plasma3,
-                                      xe_xe_sio2_res->absorbed_quartz3);
-
-    auto total_plasma = kZero;
-    auto total_quartz = kZero;
-    QString strI2;
-    for (auto i2 : xe_xe_sio2_res->absorbed_plasma) {
-      total_plasma += i2;
-      strI2 += QString::number(i2);
-      strI2 += '\n';
-    }
-    strI2 += "————————\n";
-    for (std::size_t i = 1; i < xe_xe_sio2_res->absorbed_quartz.size(); ++i) {
-      auto i2 = xe_xe_sio2_res->absorbed_quartz[i];
-      total_quartz += i2;
-      strI2 += QString::number(i2);
-      strI2 += '\n';
-    }
-    ui->xexeSiO2DataI2TextEdit->setText(strI2);
+      ui->xexeSiO2DataI3TextEdit->setText(strI3);
+
+      ui->xexeSiO2DataTotalIntensityLineEdit->setText(
+          QString::number(xe_xe_sio2_res->intensity_all));
+      ui->xexeSiO2DataTotalAbsorbedPlasmaLineEdit->setText(
+          QString::number(total_plasma));
+      ui->xexeSiO2DataTotalAbsorbedQuartzLineEdit->setText(
+          QString::number(total_quartz));
+      ui->xexeSiO2DataTotalAbsorbedMirrorLineEdit->setText(
+          QString::number(xe_xe_sio2_res->absorbed_mirror));
+    };
+    StartSolve<TwinPlasmaQuartz>(params, on_done, mode);
+  };
+  connect(ui->xexeSiO2CalculatePushButton, &QPushButton::clicked,
+          [this] { solve_[kXeXeSiO2Tab](SolveMode::kFull); });
+  ConnectPreview(ui->xexeSiO2GroupBox, kXeXeSiO2Tab);
+}
 
-    QString strI3;
-    for (auto i3 : xe_xe_sio2_res->absorbed_plasma3) {
-      strI3 += QString::number(i3);
-      strI3 += '\n';
-    }
-    strI3 += "————————\n";
-    for (std::size_t i = 1; i < xe_xe_sio2_res->absorbed_quartz3.size(); ++i) {
-      auto i3 = xe_xe_sio2_res->absorbed_quartz3[i];
-      strI3 += QString::number(i3);
-      strI3 += '\n';
-    }
-    ui->xexeSiO2DataI3TextEdit->setText(strI3);
-
-    ui->xexeSiO2DataTotalIntensityLineEdit->setText(
-        QString::number(xe_xe_sio2_res->intensity_all));
-    ui->xexeSiO2DataTotalAbsorbedPlasmaLineEdit->setText(
-        QString::number(total_plasma));
-    ui->xexeSiO2DataTotalAbsorbedQuartzLineEdit->setText(
-        QString::number(total_quartz));
-    ui->xexeSiO2DataTotalAbsorbedMirrorLineEdit->setText(
-        QString::number(xe_xe_sio2_res->absorbed_mirror));
-  });
+void MainWindow::InitSpectrumTab() {
+  spectrum_widget_ = new SpectrumWidget{
+      pool_,
+      {
+          .xe =
+              [this] {
+                auto params = XeParams();
+                AdjustICrit(params);
+                return params;
+              },
+          .xe_sio2 =
+              [this] {
+                auto params = XeSiO2Params();
+                AdjustICrit(params);
+                return params;
+              },
+      }};
+  ui->tabWidget->addTab(spectrum_widget_, "Спектр");
+  connect(spectrum_widget_, &SpectrumWidget::message, ui->statusBar,
+          [this](const QString& text) { ui->statusBar->showMessage(text); });
 }
 
 MainWindow::~MainWindow() {
+  // Вкладка удаляется после pool_, а перебор идёт на нём.
+  spectrum_widget_->Stop();
   delete ui;
 }
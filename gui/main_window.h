@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <optional>
 
 #include <QMainWindow>
@@ -8,8 +12,16 @@
 
 #include "modeling/cylinder_plasma.h"
 #include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/thread_pool.h"
+#include "modeling/twin_plasma_quartz.h"
 
+class QCheckBox;
+class QProgressBar;
+class QPushButton;
+class QTimer;
 class QWidget;
+class SolveJob;
+class SpectrumWidget;
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -28,13 +40,60 @@ class MainWindow : public QMainWindow {
   Ui::MainWindow* ui;
   std::optional<CylinderPlasma::Params> xe_params;
   std::optional<CylinderPlasmaQuartz::Params> xe_sio2_params;
-  std::optional<CylinderPlasmaQuartz::Params> xe_xe_sio2_params;
+  std::optional<TwinPlasmaQuartz::Params> xe_xe_sio2_params;
   std::optional<CylinderPlasma::Result> xe_res;
   std::optional<CylinderPlasmaQuartz::Result> xe_sio2_res;
-  std::optional<CylinderPlasmaQuartz::Result> xe_xe_sio2_res;
+  std::optional<TwinPlasmaQuartz::Result> xe_xe_sio2_res;
 
  private:
   void InitXeTab();
   void InitXeSiO2Tab();
   void InitXeXeSiO2Tab();
+  void InitSpectrumTab();
+  void InitSolveJob();
+
+  /// Параметры решателей по полям вкладок.
+  [[nodiscard]] CylinderPlasma::Params XeParams() const;
+  [[nodiscard]] CylinderPlasmaQuartz::Params XeSiO2Params() const;
+
+  enum Tab : std::size_t { kXeTab, kXeSiO2Tab, kXeXeSiO2Tab, kTabs };
+
+  enum class SolveMode {
+    kFull,     ///< По кнопке: параметры заблокированы до окончания.
+    kPreview,  ///< Грубое, при изменении параметров.
+    kRefine,   ///< Полное, когда параметры перестали меняться.
+  };
+
+  /// Запускает решение в фоне; on_done получает результат в потоке окна.
+  /// kFull блокирует параметры до окончания. kPreview и kRefine их не
+  /// блокируют и останавливаются следующим запуском; при идущем kFull они
+  /// не запускаются.
+  template <typename Solver>
+  void StartSolve(const typename Solver::Params& params,
+                  std::function<void(typename Solver::Result)> on_done,
+                  SolveMode mode);
+  void PollSolve();
+  void SetSolving(bool solving);
+
+  /// Изменение параметров в group при включённом предпросмотре запускает
+  /// грубое решение вкладки tab, а затем полное (с задержками).
+  void ConnectPreview(QWidget* group, Tab tab);
+  void SchedulePreview(Tab tab);
+
+  /// Решение вкладки по её текущим параметрам.
+  std::array<std::function<void(SolveMode)>, kTabs> solve_;
+
+  ThreadPool pool_;
+  std::unique_ptr<SolveJob> job_;  ///< После pool_: решает на нём.
+  SolveMode job_mode_{SolveMode::kFull};
+  QTimer* job_timer_;
+  QProgressBar* progress_bar_;
+  QPushButton* cancel_button_;
+
+  QCheckBox* preview_check_box_;
+  Tab preview_tab_{kXeTab};
+  QTimer* preview_timer_;
+  QTimer* refine_timer_;
+
+  SpectrumWidget* spectrum_widget_;
 };
@@ -0,0 +1,96 @@
+#include "shell_paint_widget.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <QColor>
+#include <QMetaObject>
+#include <QPainter>
+#include <QPen>
+#include <Qt>
+
+QImage RenderShellScene(const ShellScene& scene,
+                        QSize size,
+                        qreal device_pixel_ratio) {
+  if (size.isEmpty()) {
+    return {};
+  }
+
+  QImage image{size * device_pixel_ratio,
+               QImage::Format_ARGB32_Premultiplied};
+  image.setDevicePixelRatio(device_pixel_ratio);
+  image.fill(Qt::white);
+
+  QPainter painter{&image};
+  const auto w = size.width();
+  const auto h = size.height();
+  const auto scale = std::min(w / scene.width, h / scene.height) / 1.01;
+  for (const auto& shell : scene.shells) {
+    painter.setPen(QPen{Qt::black, static_cast<qreal>(shell.pen)});
+    painter.setBrush(shell.brush);
+
+    const auto side_w = static_cast<int>(scale * shell.w);
+    const auto side_h = static_cast<int>(scale * shell.h);
+    const auto x = static_cast<int>(std::lround(scale * shell.x));
+    painter.drawEllipse((w - side_w) / 2 + x, (h - side_h) / 2, side_w,
+                        side_h);
+  }
+  return image;
+}
+
+ShellPaintWidget::ShellPaintWidget(QWidget* parent) : QWidget{parent} {}
+
+void ShellPaintWidget::Invalidate() {
+  scene_ = MakeScene();
+  ++generation_;
+  Render();
+}
+
+QBrush ShellPaintWidget::HeatBrush(Float value, Float min, Float max) {
+  const auto t = max > min ? (value - min) / (max - min) : kZero;
+  return QBrush{QColor{255, static_cast<int>(255 * (1 - t)), 0}};
+}
+
+void ShellPaintWidget::paintEvent(QPaintEvent* /* event */) {
+  QPainter painter{this};
+  painter.fillRect(rect(), QBrush{Qt::white});
+  if (!image_.isNull()) {
+    // До готовности картинки нового размера растягивается прежняя.
+    painter.drawImage(rect(), image_);
+  }
+}
+
+void ShellPaintWidget::resizeEvent(QResizeEvent* event) {
+  QWidget::resizeEvent(event);
+  if (!scene_.has_value()) {
+    scene_ = MakeScene();
+  }
+  ++generation_;
+  Render();
+}
+
+void ShellPaintWidget::Render() {
+  // Идущее рисование по окончании запустит следующее с новым номером.
+  if (rendering_) {
+    return;
+  }
+  rendering_ = true;
+
+  pool_.Submit([this, scene = *scene_, size = size(),
+                ratio = devicePixelRatioF(), generation = generation_] {
+    auto image = RenderShellScene(scene, size, ratio);
+    QMetaObject::invokeMethod(
+        this,
+        [this, image = std::move(image), generation]() mutable {
+          rendering_ = false;
+          if (generation != generation_) {
+            Render();
+            return;
+          }
+          image_ = std::move(image);
+          update();
+        },
+        Qt::QueuedConnection);
+  });
+}
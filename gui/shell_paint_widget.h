@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <QBrush>
+#include <QImage>
+#include <QObject>
+#include <QSize>
+#include <QWidget>
+
+#include "base/config/float.h"
+#include "modeling/thread_pool.h"
+
+class QPaintEvent;
+class QResizeEvent;
+
+/// Сечение из вложенных эллипсов, рисуемых по порядку. Размеры — в единицах,
+/// где сечение занимает width × height; эллипсы задаются осями, а не
+/// полуосями.
+struct ShellScene {
+  struct Shell {
+    double x = 0;  ///< Смещение центра по горизонтали.
+    double w = 0;
+    double h = 0;
+    QBrush brush;  ///< Без заливки, пока нет результата.
+    int pen = 1;
+  };
+
+  double width = 1;
+  double height = 1;
+  std::vector<Shell> shells;
+};
+
+/// Рисует сечение в картинку size. Можно вызывать из любого потока.
+[[nodiscard]] QImage RenderShellScene(const ShellScene& scene,
+                                      QSize size,
+                                      qreal device_pixel_ratio);
+
+/// Виджет сечения с раскрашенными слоями. Сечение рисуется в картинку в
+/// фоновом потоке один раз на результат и размер; paintEvent только
+/// копирует её.
+class ShellPaintWidget : public QWidget {
+  Q_OBJECT
+ public:
+  explicit ShellPaintWidget(QWidget* parent = nullptr);
+
+  /// Пересобирает сечение по параметрам и результату окна и перерисовывает
+  /// картинку. Вызывается при смене результата или параметров сечения.
+  void Invalidate();
+
+ protected:
+  /// Сечение по текущим параметрам и результату; в потоке окна.
+  [[nodiscard]] virtual ShellScene MakeScene() const = 0;
+
+  /// Цвет слоя: от жёлтого при min до красного при max.
+  [[nodiscard]] static QBrush HeatBrush(Float value, Float min, Float max);
+
+  void paintEvent(QPaintEvent* event) override;
+  void resizeEvent(QResizeEvent* event) override;
+
+ private:
+  void Render();
+
+  std::optional<ShellScene> scene_;
+  QImage image_;
+  /// Номер сечения и размера: готовая картинка старого номера не
+  /// показывается.
+  std::uint64_t generation_{0};
+  bool rendering_{false};
+  ThreadPool pool_{1};  ///< Последним: дожидается рисования до удаления.
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <utility>
+
+#include "modeling/async_solve.h"
+#include "modeling/solve_monitor.h"
+#include "modeling/thread_pool.h"
+
+/// Решение в фоне для окна: AsyncSolve без типа решателя. Окно опрашивает
+/// progress() по таймеру, а по ready() вызывает Finish() в своём потоке.
+class SolveJob {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  SolveJob() = default;
+  SolveJob(const SolveJob&) = delete;
+  SolveJob(SolveJob&&) = delete;
+  SolveJob& operator=(const SolveJob&) = delete;
+  SolveJob& operator=(SolveJob&&) = delete;
+  /// Останавливает решение и дожидается его потока.
+  virtual ~SolveJob() = default;
+
+  [[nodiscard]] virtual SolveProgress progress() const = 0;
+  virtual void Cancel() = 0;
+  [[nodiscard]] virtual bool ready() const = 0;
+
+  /// Передаёт результат обработчику; вызывается один раз после ready().
+  /// @throws SolveCancelled Остановлено по Cancel().
+  /// @throws std::runtime_error Ошибка решателя (баланс энергии).
+  virtual void Finish() = 0;
+
+  [[nodiscard]] Clock::duration elapsed() const {
+    return Clock::now() - start_;
+  }
+
+ private:
+  Clock::time_point start_ = Clock::now();
+};
+
+template <typename Solver>
+class AsyncSolveJob final : public SolveJob {
+ public:
+  using Params = typename Solver::Params;
+  using Result = typename Solver::Result;
+  using OnDone = std::function<void(Result)>;
+
+  AsyncSolveJob(const Params& params, ThreadPool& pool, OnDone on_done)
+      : solve_{params, {.pool = &pool}}, on_done_{std::move(on_done)} {}
+
+  [[nodiscard]] SolveProgress progress() const override {
+    return solve_.progress();
+  }
+  void Cancel() override { solve_.Cancel(); }
+  [[nodiscard]] bool ready() const override { return solve_.ready(); }
+  void Finish() override { on_done_(solve_.Get()); }
+
+ private:
+  AsyncSolve<Solver> solve_;
+  OnDone on_done_;
+};
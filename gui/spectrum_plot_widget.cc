@@ -0,0 +1,61 @@
+#include "spectrum_plot_widget.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+
+#include <QChart>
+#include <QLegend>
+#include <QLineSeries>
+#include <QRectF>
+#include <QValueAxis>
+#include <QXYSeries>
+#include <Qt>
+
+SpectrumPlotWidget::SpectrumPlotWidget(QWidget* parent)
+    : QChartView{parent},
+      chart_{new QChart},
+      axis_x_{new QValueAxis},
+      axis_y_{new QValueAxis},
+      emitted_{new QLineSeries},
+      absorbed_{new QLineSeries} {
+  emitted_.series()->setName("Излучение");
+  absorbed_.series()->setName("Поглощение плазмой");
+  chart_->addSeries(emitted_.series());
+  chart_->addSeries(absorbed_.series());
+  chart_->legend()->setAlignment(Qt::AlignTop);
+
+  axis_x_->setTitleText("ν [Гц]");
+  axis_x_->setLabelFormat("%g");
+  chart_->addAxis(axis_x_, Qt::AlignBottom);
+  axis_y_->setTitleText("I [Вт/см^2]");
+  axis_y_->setLabelFormat("%g");
+  chart_->addAxis(axis_y_, Qt::AlignLeft);
+  for (auto* series : {emitted_.series(), absorbed_.series()}) {
+    series->attachAxis(axis_x_);
+    series->attachAxis(axis_y_);
+  }
+
+  connect(chart_, &QChart::plotAreaChanged, this, [this](const QRectF& area) {
+    emitted_.SetWidth(static_cast<int>(area.width()));
+    absorbed_.SetWidth(static_cast<int>(area.width()));
+  });
+
+  setChart(chart_);
+}
+
+void SpectrumPlotWidget::setData(QList<QPointF> emitted,
+                                 QList<QPointF> absorbed) {
+  if (!emitted.isEmpty()) {
+    axis_x_->setRange(emitted.front().x(), emitted.back().x());
+    const auto max = std::ranges::max_element(emitted, {}, &QPointF::y)->y();
+    axis_y_->setRange(0, max > 0 ? max * 1.01 : 1);
+  }
+  emitted_.SetPoints(std::move(emitted));
+  absorbed_.SetPoints(std::move(absorbed));
+}
+
+void SpectrumPlotWidget::setUseOpenGL(bool enable) {
+  emitted_.series()->setUseOpenGL(enable);
+  absorbed_.series()->setUseOpenGL(enable);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QChartView>
+#include <QList>
+#include <QObject>
+#include <QPointF>
+
+#include "decimated_series.h"
+
+class QChart;
+class QValueAxis;
+class QWidget;
+
+/// Спектр перебора: излучение и поглощение плазмы по полосам.
+class SpectrumPlotWidget : public QChartView {
+  Q_OBJECT
+ public:
+  explicit SpectrumPlotWidget(QWidget* parent = nullptr);
+
+  /// Точки (nu, I) по возрастанию nu.
+  void setData(QList<QPointF> emitted, QList<QPointF> absorbed);
+  /// Рисование серий через OpenGL: быстрее на длинных спектрах, но без
+  /// сглаживания.
+  void setUseOpenGL(bool enable);
+
+ private:
+  QChart* chart_;
+  QValueAxis* axis_x_;
+  QValueAxis* axis_y_;
+  DecimatedSeries emitted_;
+  DecimatedSeries absorbed_;
+};
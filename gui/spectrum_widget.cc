@@ -0,0 +1,235 @@
+#include "spectrum_widget.h"
+
+#include <algorithm>
+#include <exception>
+#include <format>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QList>
+#include <QPointF>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "spectrum_plot_widget.h"
+#include "xe_plot_widget.h"
+
+#include "base/config/float.h"
+#include "modeling/result_cache.h"
+#include "physics/absorption_table.h"
+
+namespace {
+
+/// Период опроса перебора.
+constexpr auto kPollInterval = std::chrono::milliseconds{100};
+
+enum Model { kXe, kXeSiO2 };
+
+/// Одновременно решаемых полос по умолчанию.
+constexpr int kConcurrency = 2;
+
+}  // namespace
+
+SpectrumWidget::SpectrumWidget(ThreadPool& pool,
+                               Sources sources,
+                               QWidget* parent)
+    : QWidget{parent},
+      pool_{pool},
+      sources_{std::move(sources)},
+      model_combo_box_{new QComboBox},
+      from_spin_box_{new QSpinBox},
+      to_spin_box_{new QSpinBox},
+      concurrency_spin_box_{new QSpinBox},
+      open_gl_check_box_{new QCheckBox{"OpenGL"}},
+      start_button_{new QPushButton{"Перебрать"}},
+      progress_bar_{new QProgressBar},
+      spectrum_plot_{new SpectrumPlotWidget},
+      profile_plot_{new XePlotWidget},
+      poll_timer_{new QTimer{this}} {
+  model_combo_box_->addItems({"Xe", "Xe-SiO2"});
+  model_combo_box_->setCurrentIndex(kXeSiO2);
+
+  const auto n_bands = static_cast<int>(AbsorptionTable::Default().n_bands());
+  from_spin_box_->setRange(1, n_bands);
+  from_spin_box_->setValue(1);
+  to_spin_box_->setRange(1, n_bands);
+  to_spin_box_->setValue(n_bands);
+  concurrency_spin_box_->setRange(1, static_cast<int>(pool_.size() + 1));
+  concurrency_spin_box_->setValue(kConcurrency);
+
+  auto* controls = new QHBoxLayout;
+  controls->addWidget(new QLabel{"Модель:"});
+  controls->addWidget(model_combo_box_);
+  controls->addWidget(new QLabel{"Полосы с"});
+  controls->addWidget(from_spin_box_);
+  controls->addWidget(new QLabel{"по"});
+  controls->addWidget(to_spin_box_);
+  controls->addWidget(new QLabel{"Одновременно:"});
+  controls->addWidget(concurrency_spin_box_);
+  controls->addWidget(open_gl_check_box_);
+  controls->addStretch();
+  controls->addWidget(progress_bar_);
+  controls->addWidget(start_button_);
+
+  profile_plot_->setAxisY("ΣI* [Вт/см^3]");
+
+  auto* layout = new QVBoxLayout{this};
+  layout->addLayout(controls);
+  layout->addWidget(spectrum_plot_, 1);
+  layout->addWidget(profile_plot_, 1);
+
+  progress_bar_->hide();
+  poll_timer_->setInterval(kPollInterval);
+  connect(poll_timer_, &QTimer::timeout, this, &SpectrumWidget::Poll);
+  connect(start_button_, &QPushButton::clicked, this, [this] {
+    if (job_) {
+      Stop();
+      emit message("Перебор остановлен");
+    } else {
+      Start();
+    }
+  });
+  connect(open_gl_check_box_, &QCheckBox::toggled, spectrum_plot_,
+          &SpectrumPlotWidget::setUseOpenGL);
+}
+
+SpectrumWidget::~SpectrumWidget() {
+  Stop();
+}
+
+void SpectrumWidget::Stop() {
+  if (!job_) {
+    return;
+  }
+  // Деструктор останавливает перебор и ждёт его потока.
+  job_.reset();
+  poll_timer_->stop();
+  SetRunning(false);
+}
+
+void SpectrumWidget::Start() {
+  if (from_spin_box_->value() > to_spin_box_->value()) {
+    emit message("Неправильный диапазон полос");
+    return;
+  }
+  if (model_combo_box_->currentIndex() == kXe) {
+    StartSweep<CylinderPlasma>(sources_.xe());
+  } else {
+    StartSweep<CylinderPlasmaQuartz>(sources_.xe_sio2());
+  }
+}
+
+template <typename Solver>
+void SpectrumWidget::StartSweep(const typename Solver::Params& base) {
+  // В окне полосы нумеруются с 1, как в списках Δν* вкладок.
+  const auto from = static_cast<std::size_t>(from_spin_box_->value() - 1);
+  const auto to = static_cast<std::size_t>(to_spin_box_->value());
+
+  bands_.clear();
+  std::vector<std::size_t> bands;
+  std::vector<typename Solver::Params> params;
+  for (auto band = from; band < to; ++band) {
+    const auto center = AbsorptionTable::Default().BandCenter(band);
+    auto p = base;
+    p.nu = static_cast<Float>(center.nu);
+    p.d_nu = static_cast<Float>(center.d_nu);
+    if (const auto it = memo_.find(CacheKey(p)); it != memo_.end()) {
+      bands_.insert_or_assign(band, it->second);
+      continue;
+    }
+    bands.push_back(band);
+    params.push_back(p);
+  }
+  memo_hits_ = bands_.size();
+
+  progress_bar_->setRange(0, static_cast<int>(to - from));
+  progress_bar_->setValue(static_cast<int>(memo_hits_));
+  Plot();
+  if (bands.empty()) {
+    emit message("Спектр: все полосы уже решены");
+    return;
+  }
+
+  job_ = std::make_unique<AsyncSweepJob<Solver>>(
+      std::move(bands), params, pool_,
+      static_cast<std::size_t>(concurrency_spin_box_->value()));
+  start_ = std::chrono::steady_clock::now();
+  SetRunning(true);
+  emit message(QString::fromStdString(
+      std::format("Перебор: {} полос, из памяти {}", to - from, memo_hits_)));
+  poll_timer_->start();
+}
+
+void SpectrumWidget::Poll() {
+  if (!job_) {
+    poll_timer_->stop();
+    return;
+  }
+
+  auto done = job_->Take();
+  for (auto& [key, band] : done) {
+    bands_.insert_or_assign(band.band, band);
+    memo_.insert_or_assign(std::move(key), std::move(band));
+  }
+  if (!done.empty()) {
+    Plot();
+  }
+  progress_bar_->setValue(static_cast<int>(memo_hits_ + job_->done()));
+  if (!job_->finished()) {
+    return;
+  }
+
+  const auto error = job_->error();
+  Stop();
+  if (error) {
+    try {
+      std::rethrow_exception(error);
+    } catch (const std::exception& e) {
+      emit message(QString::fromStdString(e.what()));
+    }
+    return;
+  }
+
+  const auto time = std::chrono::steady_clock::now() - start_;
+  emit message(QString::fromStdString(std::format(
+      "Время перебора: {}{}",
+      std::chrono::duration_cast<std::chrono::seconds>(time),
+      std::chrono::duration_cast<std::chrono::milliseconds>(time) % 1000)));
+}
+
+void SpectrumWidget::Plot() {
+  QList<QPointF> emitted;
+  QList<QPointF> absorbed;
+  emitted.reserve(static_cast<qsizetype>(bands_.size()));
+  absorbed.reserve(static_cast<qsizetype>(bands_.size()));
+  std::vector<Float> profile;
+  for (const auto& band : std::views::values(bands_)) {
+    emitted.push_back({band.nu, band.intensity_all});
+    absorbed.push_back({band.nu, band.absorbed_plasma});
+    profile.resize(std::max(profile.size(), band.absorbed_plasma3.size()));
+    for (std::size_t i = 0; i < band.absorbed_plasma3.size(); ++i) {
+      profile[i] += band.absorbed_plasma3[i];
+    }
+  }
+  spectrum_plot_->setData(std::move(emitted), std::move(absorbed));
+  if (!profile.empty()) {
+    profile_plot_->setData(profile);
+  }
+}
+
+void SpectrumWidget::SetRunning(bool running) {
+  model_combo_box_->setEnabled(!running);
+  from_spin_box_->setEnabled(!running);
+  to_spin_box_->setEnabled(!running);
+  concurrency_spin_box_->setEnabled(!running);
+  progress_bar_->setVisible(running);
+  start_button_->setText(running ? "Остановить" : "Перебрать");
+}
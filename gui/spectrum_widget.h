@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <QObject>
+#include <QString>
+#include <QWidget>
+
+#include "sweep_job.h"
+
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/thread_pool.h"
+
+class QCheckBox;
+class QComboBox;
+class QProgressBar;
+class QPushButton;
+class QSpinBox;
+class QTimer;
+class SpectrumPlotWidget;
+class XePlotWidget;
+
+/// Вкладка «Спектр»: перебор полос таблицы поглощения в фоне. Готовые
+/// полосы сразу попадают на график спектра и в суммарный профиль
+/// поглощения. Решённые полосы хранятся в памяти до закрытия окна, так что
+/// повторный перебор с теми же параметрами их не пересчитывает.
+class SpectrumWidget : public QWidget {
+  Q_OBJECT
+ public:
+  /// Параметры моделей с их вкладок; nu и d_nu заменяются полосой.
+  struct Sources {
+    std::function<CylinderPlasma::Params()> xe;
+    std::function<CylinderPlasmaQuartz::Params()> xe_sio2;
+  };
+
+  /// Полосы решаются на pool; он должен пережить перебор (Stop()).
+  SpectrumWidget(ThreadPool& pool, Sources sources, QWidget* parent = nullptr);
+  ~SpectrumWidget() override;
+
+  /// Останавливает перебор и дожидается его потока.
+  void Stop();
+
+ signals:
+  void message(const QString& text);
+
+ private:
+  void Start();
+  template <typename Solver>
+  void StartSweep(const typename Solver::Params& base);
+  void Poll();
+  void Plot();
+  void SetRunning(bool running);
+
+  ThreadPool& pool_;
+  Sources sources_;
+
+  QComboBox* model_combo_box_;
+  QSpinBox* from_spin_box_;
+  QSpinBox* to_spin_box_;
+  QSpinBox* concurrency_spin_box_;
+  QCheckBox* open_gl_check_box_;
+  QPushButton* start_button_;
+  QProgressBar* progress_bar_;
+  SpectrumPlotWidget* spectrum_plot_;
+  XePlotWidget* profile_plot_;
+  QTimer* poll_timer_;
+
+  std::unique_ptr<SweepJob> job_;
+  std::chrono::steady_clock::time_point start_;
+  std::size_t memo_hits_{0};
+  /// Полосы текущего перебора по номеру.
+  std::map<std::size_t, SpectrumBand> bands_;
+  /// Все решённые полосы по CacheKey их параметров.
+  std::unordered_map<std::string, SpectrumBand> memo_;
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/config/float.h"
+#include "modeling/async_solve.h"
+#include "modeling/result_cache.h"
+#include "modeling/thread_pool.h"
+
+/// Решённая полоса в том виде, в каком её показывает вкладка «Спектр».
+struct SpectrumBand {
+  std::size_t band{};
+  Float nu{};
+  Float d_nu{};
+  Float intensity_all{};
+  Float absorbed_plasma{};  ///< Сумма по слоям.
+  Float absorbed_quartz{};  ///< Сумма по слоям; 0 без кварца.
+  std::vector<Float> absorbed_plasma3;
+};
+
+template <typename Params, typename Result>
+[[nodiscard]] SpectrumBand MakeSpectrumBand(std::size_t band,
+                                            const Params& params,
+                                            const Result& r) {
+  SpectrumBand b{
+      .band = band,
+      .nu = params.nu,
+      .d_nu = params.d_nu,
+      .intensity_all = r.intensity_all,
+      .absorbed_plasma = std::accumulate(r.absorbed_plasma.begin(),
+                                         r.absorbed_plasma.end(), kZero),
+      .absorbed_plasma3 = r.absorbed_plasma3,
+  };
+  if constexpr (requires { r.absorbed_quartz; }) {
+    // Первый слой кварца пуст, как и в итогах вкладок.
+    b.absorbed_quartz = std::accumulate(r.absorbed_quartz.begin() + 1,
+                                        r.absorbed_quartz.end(), kZero);
+  }
+  return b;
+}
+
+/// Перебор полос в фоне для окна: AsyncSweep без типа решателя. Окно
+/// опрашивает его по таймеру и забирает готовые полосы Take().
+class SweepJob {
+ public:
+  /// Полоса и её ключ (CacheKey) для памяти решённых полос.
+  using Done = std::pair<std::string, SpectrumBand>;
+
+  SweepJob() = default;
+  SweepJob(const SweepJob&) = delete;
+  SweepJob(SweepJob&&) = delete;
+  SweepJob& operator=(const SweepJob&) = delete;
+  SweepJob& operator=(SweepJob&&) = delete;
+  /// Останавливает перебор и дожидается его потока.
+  virtual ~SweepJob() = default;
+
+  [[nodiscard]] virtual std::size_t done() const = 0;
+  [[nodiscard]] virtual bool finished() const = 0;
+  [[nodiscard]] virtual std::exception_ptr error() const = 0;
+  virtual void Cancel() = 0;
+  /// Полосы, решённые после прошлого вызова.
+  [[nodiscard]] virtual std::vector<Done> Take() = 0;
+};
+
+template <typename Solver>
+class AsyncSweepJob final : public SweepJob {
+ public:
+  using Params = typename Solver::Params;
+
+  /// params[i] — параметры полосы bands[i].
+  AsyncSweepJob(std::vector<std::size_t> bands,
+                const std::vector<Params>& params,
+                ThreadPool& pool,
+                std::size_t concurrency)
+      : bands_{std::move(bands)},
+        params_{params},
+        sweep_{params, pool, concurrency} {}
+
+  [[nodiscard]] std::size_t done() const override { return sweep_.done(); }
+  [[nodiscard]] bool finished() const override { return sweep_.finished(); }
+  [[nodiscard]] std::exception_ptr error() const override {
+    return sweep_.error();
+  }
+  void Cancel() override { sweep_.Cancel(); }
+
+  [[nodiscard]] std::vector<Done> Take() override {
+    std::vector<Done> done;
+    for (const auto& [i, result] : sweep_.Take()) {
+      done.emplace_back(CacheKey(params_[i]),
+                        MakeSpectrumBand(bands_[i], params_[i], result));
+    }
+    return done;
+  }
+
+ private:
+  std::vector<std::size_t> bands_;
+  std::vector<Params> params_;
+  AsyncSweep<Solver> sweep_;  ///< Последним: останавливается первым.
+};
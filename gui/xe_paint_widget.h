@@ -3,13 +3,13 @@
 #include <QObject>
 #include <QWidget>
 
-class QPaintEvent;
+#include "shell_paint_widget.h"
 
-class XePaintWidget : public QWidget {
+class XePaintWidget : public ShellPaintWidget {
   Q_OBJECT
  public:
   explicit XePaintWidget(QWidget* parent = nullptr);
 
  protected:
-  void paintEvent(QPaintEvent* event) override;
+  [[nodiscard]] ShellScene MakeScene() const override;
 };
@@ -4,11 +4,14 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <utility>
 
 #include <QChart>
 #include <QLegend>
 #include <QLineSeries>
+#include <QList>
 #include <QPointF>
+#include <QRectF>
 #include <QValueAxis>
 #include <QXYSeries>
 #include <Qt>
@@ -18,13 +21,17 @@ XePlotWidget::XePlotWidget(QWidget* parent)
       chart_{new QChart},
       axis_x_{new QValueAxis},
       series_{new QLineSeries} {
-  chart_->addSeries(series_);
+  chart_->addSeries(series_.series());
   chart_->legend()->hide();
 
   axis_x_->setTitleText("z = r/R");
   axis_x_->setLabelFormat("%g");
   chart_->addAxis(axis_x_, Qt::AlignBottom);
-  series_->attachAxis(axis_x_);
+  series_.series()->attachAxis(axis_x_);
+
+  connect(chart_, &QChart::plotAreaChanged, this, [this](const QRectF& area) {
+    series_.SetWidth(static_cast<int>(area.width()));
+  });
 
   setChart(chart_);
 }
@@ -36,7 +43,7 @@ void XePlotWidget::setAxisY(const QString& title) {
   axis_y_->setTitleText(title);
   axis_y_->setLabelFormat("%g");
   chart_->addAxis(axis_y_, Qt::AlignLeft);
-  series_->attachAxis(axis_y_);
+  series_.series()->attachAxis(axis_y_);
 }
 
 void XePlotWidget::setData(const std::vector<Float>& y) {
@@ -74,11 +81,12 @@ void XePlotWidget::setData(const std::vector<Float>& y) {
   }
   axis_y_->setMax(std::ceil(max * 100) / 100 * scale);
 
-  series_->clear();
-
   const auto step = kOne / static_cast<Float>(y.size());
 
+  QList<QPointF> points;
+  points.reserve(static_cast<qsizetype>(y.size()));
   for (std::size_t i = 0; i < y.size(); ++i) {
-    *series_ << QPointF{step * static_cast<Float>(i + 1), y[i]};
+    points.push_back({step * static_cast<Float>(i + 1), y[i]});
   }
+  series_.SetPoints(std::move(points));
 }
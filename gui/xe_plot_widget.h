@@ -6,6 +6,8 @@
 
 #include <vector>
 
+#include "decimated_series.h"
+
 #include "base/config/float.h"
 
 class QChart;
@@ -25,5 +27,5 @@ class XePlotWidget : public QChartView {
   QChart* chart_;
   QValueAxis* axis_x_;
   QValueAxis* axis_y_;
-  QLineSeries* series_;
+  DecimatedSeries series_;
 };
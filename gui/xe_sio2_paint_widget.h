@@ -3,13 +3,13 @@
 #include <QObject>
 #include <QWidget>
 
-class QPaintEvent;
+#include "shell_paint_widget.h"
 
-class XeSiO2PaintWidget : public QWidget {
+class XeSiO2PaintWidget : public ShellPaintWidget {
   Q_OBJECT
  public:
   explicit XeSiO2PaintWidget(QWidget* parent = nullptr);
 
  protected:
-  void paintEvent(QPaintEvent* event) override;
+  [[nodiscard]] ShellScene MakeScene() const override;
 };
@@ -4,11 +4,14 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <utility>
 
 #include <QChart>
 #include <QLegend>
 #include <QLineSeries>
+#include <QList>
 #include <QPointF>
+#include <QRectF>
 #include <QValueAxis>
 #include <QXYSeries>
 #include <Qt>
@@ -19,16 +22,20 @@ XeSiO2PlotWidget::XeSiO2PlotWidget(QWidget* parent)
       axis_x_{new QValueAxis},
       series_{new QLineSeries},
       vr_{new QLineSeries} {
-  chart_->addSeries(series_);
+  chart_->addSeries(series_.series());
   chart_->addSeries(vr_);
   chart_->legend()->hide();
 
   axis_x_->setTitleText("z = r/R");
   axis_x_->setLabelFormat("%g");
   chart_->addAxis(axis_x_, Qt::AlignBottom);
-  series_->attachAxis(axis_x_);
+  series_.series()->attachAxis(axis_x_);
   vr_->attachAxis(axis_x_);
 
+  connect(chart_, &QChart::plotAreaChanged, this, [this](const QRectF& area) {
+    series_.SetWidth(static_cast<int>(area.width()));
+  });
+
   setChart(chart_);
 }
 
@@ -39,7 +46,7 @@ void XeSiO2PlotWidget::setAxisY(const QString& title) {
   axis_y_->setTitleText(title);
   axis_y_->setLabelFormat("%g");
   chart_->addAxis(axis_y_, Qt::AlignLeft);
-  series_->attachAxis(axis_y_);
+  series_.series()->attachAxis(axis_y_);
   vr_->attachAxis(axis_y_);
 }
 
@@ -89,16 +96,17 @@ void XeSiO2PlotWidget::setData(const std::vector<Float>& plasma,
   }
   axis_y_->setMax(std::ceil(max * 100) / 100 * scale);
 
-  series_->clear();
+  QList<QPointF> points;
+  points.reserve(static_cast<qsizetype>(plasma.size() + quartz.size()));
 
   auto step = kOne / static_cast<Float>(plasma.size());
   for (std::size_t i = 0; i < plasma.size(); ++i) {
-    *series_ << QPointF{step * static_cast<Float>(i + 1), plasma[i]};
+    points.push_back({step * static_cast<Float>(i + 1), plasma[i]});
   }
 
   step = delta / (r * static_cast<Float>(quartz.size() - 1));
   for (std::size_t i = 1; i < quartz.size(); ++i) {
-    *series_ << QPointF{1 + step * static_cast<Float>(i - 1), quartz[i]};
+    points.push_back({1 + step * static_cast<Float>(i - 1), quartz[i]});
   }
 
   auto last_y = 2 * quartz.back() - quartz[quartz.size() - 2];
@@ -108,9 +116,8 @@ void XeSiO2PlotWidget::setData(const std::vector<Float>& plasma,
   if (last_y < min) {
     last_y = min;
   }
-  *series_ << QPointF{1 + delta / r, last_y};
+  points.push_back({1 + delta / r, last_y});
+  series_.SetPoints(std::move(points));
 
-  vr_->clear();
-  *vr_ << QPointF{1, 0};
-  *vr_ << QPointF{1, max};
+  vr_->replace(QList<QPointF>{{1, 0}, {1, max}});
 }
@@ -6,6 +6,8 @@
 
 #include <vector>
 
+#include "decimated_series.h"
+
 #include "base/config/float.h"
 
 class QChart;
@@ -28,6 +30,6 @@ class XeSiO2PlotWidget : public QChartView {
   QChart* chart_;
   QValueAxis* axis_x_;
   QValueAxis* axis_y_;
-  QLineSeries* series_;
+  DecimatedSeries series_;
   QLineSeries* vr_;
 };
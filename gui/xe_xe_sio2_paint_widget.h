@@ -1,17 +1,23 @@
 #pragma once
 
+#include <QImage>
 #include <QObject>
 #include <QWidget>
 
+#include "shell_paint_widget.h"
+
 class QPaintEvent;
 
-class XeXeSiO2PaintWidget : public QWidget {
+class XeXeSiO2PaintWidget : public ShellPaintWidget {
   Q_OBJECT
  public:
   explicit XeXeSiO2PaintWidget(QWidget* parent = nullptr);
 
+  /// Если задано, рисуется вместо сечения (неправильная геометрия).
   QImage image;
 
  protected:
+  [[nodiscard]] ShellScene MakeScene() const override;
+
   void paintEvent(QPaintEvent* event) override;
 };
@@ -4,11 +4,14 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <utility>
 
 #include <QChart>
 #include <QLegend>
 #include <QLineSeries>
+#include <QList>
 #include <QPointF>
+#include <QRectF>
 #include <QValueAxis>
 #include <QXYSeries>
 #include <Qt>
@@ -19,15 +22,20 @@ XeXeSiO2PlotWidget::XeXeSiO2PlotWidget(QWidget* parent)
       axis_x_{new QValueAxis},
       series_{new QLineSeries},
       series2_{new QLineSeries} {
-  chart_->addSeries(series_);
-  chart_->addSeries(series2_);
+  chart_->addSeries(series_.series());
+  chart_->addSeries(series2_.series());
   chart_->legend()->hide();
 
   axis_x_->setTitleText("z = r/R");
   axis_x_->setLabelFormat("%g");
   chart_->addAxis(axis_x_, Qt::AlignBottom);
-  series_->attachAxis(axis_x_);
-  series2_->attachAxis(axis_x_);
+  series_.series()->attachAxis(axis_x_);
+  series2_.series()->attachAxis(axis_x_);
+
+  connect(chart_, &QChart::plotAreaChanged, this, [this](const QRectF& area) {
+    series_.SetWidth(static_cast<int>(area.width()));
+    series2_.SetWidth(static_cast<int>(area.width()));
+  });
 
   setChart(chart_);
 }
@@ -39,8 +47,8 @@ void XeXeSiO2PlotWidget::setAxisY(const QString& title) {
   axis_y_->setTitleText(title);
   axis_y_->setLabelFormat("%g");
   chart_->addAxis(axis_y_, Qt::AlignLeft);
-  series_->attachAxis(axis_y_);
-  series2_->attachAxis(axis_y_);
+  series_.series()->attachAxis(axis_y_);
+  series2_.series()->attachAxis(axis_y_);
 }
 
 void XeXeSiO2PlotWidget::setData(const std::vector<Float>& plasma,
@@ -85,17 +93,19 @@ void XeXeSiO2PlotWidget::setData(const std::vector<Float>& plasma,
   }
   axis_y_->setMax(std::ceil(max * 100) / 100 * scale);
 
-  series_->clear();
-
+  QList<QPointF> points;
+  points.reserve(static_cast<qsizetype>(plasma.size()));
   auto step = kOne / static_cast<Float>(plasma.size());
   for (std::size_t i = 0; i < plasma.size(); ++i) {
-    *series_ << QPointF{step * static_cast<Float>(i + 1), plasma[i]};
+    points.push_back({step * static_cast<Float>(i + 1), plasma[i]});
   }
+  series_.SetPoints(std::move(points));
 
-  series2_->clear();
-
+  QList<QPointF> points2;
+  points2.reserve(static_cast<qsizetype>(quartz.size() - 1));
   step = kOne / (static_cast<Float>(quartz.size() - 1));
   for (std::size_t i = 1; i < quartz.size(); ++i) {
-    *series2_ << QPointF{step * static_cast<Float>(i), quartz[i]};
+    points2.push_back({step * static_cast<Float>(i), quartz[i]});
   }
+  series2_.SetPoints(std::move(points2));
 }
@@ -6,6 +6,8 @@
 
 #include <vector>
 
+#include "decimated_series.h"
+
 #include "base/config/float.h"
 
 class QChart;
@@ -26,6 +28,6 @@ class XeXeSiO2PlotWidget : public QChartView {
   QChart* chart_;
   QValueAxis* axis_x_;
   QValueAxis* axis_y_;
-  QLineSeries* series_;
-  QLineSeries* series2_;
+  DecimatedSeries series_;
+  DecimatedSeries series2_;
 };
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+/// Записывает data во временный файл рядом с path, сбрасывает его на диск
+/// и переименовывает в path. После сбоя на диске остаётся либо старое,
+/// либо новое содержимое целиком. Временный файл у каждого вызова свой.
+/// @throws std::runtime_error
+void WriteFileAtomically(const std::filesystem::path& path,
+                         std::string_view data);
+
+/// Дописывает data в конец path (создаёт его, если нет) и сбрасывает на
+/// диск. После сбоя в конце файла может остаться начало data.
+/// @throws std::runtime_error
+void AppendToFile(const std::filesystem::path& path, std::string_view data);
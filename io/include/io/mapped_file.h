@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+/// Файл, отображённый в память только для чтения. Там, где нет mmap,
+/// содержимое читается в память целиком. Начало данных выровнено не хуже,
+/// чем на 8 байт.
+class MappedFile {
+ public:
+  /// @throws std::runtime_error, если файл не открыт.
+  explicit MappedFile(const std::filesystem::path& path);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+  ~MappedFile();
+
+  [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+    return {data_, size_};
+  }
+
+ private:
+  const std::byte* data_ = nullptr;
+  std::size_t size_{};
+  /// Копия файла там, где нет mmap.
+  std::vector<double> buffer_;
+};
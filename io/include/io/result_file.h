@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "base/config/float.h"
+#include "io/mapped_file.h"
+
+/// Двоичный файл результатов: заголовок ResultHeader и строки фиксированной
+/// длины по одной на полосу (задание), все значения — double (little-endian,
+/// независимо от Float). Строка:
+///   band nu d_nu intensity_all absorbed_mirror residual
+///   absorbed_plasma[n_plasma] absorbed_plasma3[n_plasma]
+///   absorbed_quartz[n_quartz] absorbed_quartz3[n_quartz]
+/// Число строк определяется размером файла, недописанный хвост
+/// отбрасывается. Чтение из numpy:
+///   np.memmap(path, '<f8', 'r', offset=32).reshape(-1, width)
+struct ResultHeader {
+  static constexpr std::array<char, 8> kMagic = {'M', 'T', 'R', 'E',
+                                                 'S', 'U', 'L', 'T'};
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::uint32_t kScalars = 6;
+
+  std::array<char, 8> magic = kMagic;
+  std::uint32_t version = kVersion;
+  std::uint32_t header_size = sizeof(ResultHeader);
+  std::uint32_t n_scalars = kScalars;
+  std::uint32_t n_plasma{};
+  std::uint32_t n_quartz{};
+  std::uint32_t reserved{};
+
+  /// Число double в строке.
+  [[nodiscard]] std::size_t Width() const noexcept {
+    return n_scalars + 2 * (std::size_t{n_plasma} + n_quartz);
+  }
+};
+static_assert(sizeof(ResultHeader) == 32);
+
+/// Результат одной полосы для ResultWriter. band < 0 — вне таблицы.
+struct ResultRow {
+  std::int64_t band = -1;
+  Float nu{};
+  Float d_nu{};
+  Float intensity_all{};
+  Float absorbed_mirror{};
+  Float residual{};
+  std::span<const Float> absorbed_plasma;
+  std::span<const Float> absorbed_plasma3;
+  std::span<const Float> absorbed_quartz;
+  std::span<const Float> absorbed_quartz3;
+};
+
+/// Отображённый в память файл ResultWriter (только двоичный формат).
+class ResultFile {
+ public:
+  /// @throws std::runtime_error, если файл не открыт или не того формата.
+  explicit ResultFile(const std::filesystem::path& path);
+  [[nodiscard]] const ResultHeader& header() const noexcept { return header_; }
+  [[nodiscard]] std::size_t size() const noexcept { return rows_; }
+
+  struct Row {
+    std::int64_t band;
+    double nu;
+    double d_nu;
+    double intensity_all;
+    double absorbed_mirror;
+    double residual;
+    std::span<const double> absorbed_plasma;
+    std::span<const double> absorbed_plasma3;
+    std::span<const double> absorbed_quartz;
+    std::span<const double> absorbed_quartz3;
+  };
+
+  [[nodiscard]] Row operator[](std::size_t i) const;
+
+ private:
+  MappedFile file_;
+  ResultHeader header_;
+  std::size_t rows_{};
+};
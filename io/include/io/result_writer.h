@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "io/result_file.h"
+
+/// Потоковая запись результатов по полосам: строка на ResultRow, буфер
+/// сбрасывается на диск крупными блоками (и в деструкторе).
+///
+/// kBinary — формат ResultFile, kCsv — те же столбцы с заголовком
+/// band,nu,...,plasma_0,...,plasma3_0,...,quartz_0,...,quartz3_0,...
+class ResultWriter {
+ public:
+  enum class Format {
+    kBinary,
+    kCsv,
+  };
+
+  /// @returns kCsv для расширения .csv, иначе kBinary.
+  [[nodiscard]] static Format FormatFor(const std::filesystem::path& path);
+
+  /// Перезаписывает path.
+  /// @throws std::runtime_error, если файл не открыт.
+  ResultWriter(const std::filesystem::path& path,
+               Format format,
+               std::size_t n_plasma,
+               std::size_t n_quartz,
+               std::size_t buffer_size = kDefaultBufferSize);
+  ResultWriter(const ResultWriter&) = delete;
+  ResultWriter(ResultWriter&&) = delete;
+  ResultWriter& operator=(const ResultWriter&) = delete;
+  ResultWriter& operator=(ResultWriter&&) = delete;
+  ~ResultWriter();
+
+  [[nodiscard]] std::size_t n_plasma() const noexcept { return n_plasma_; }
+  [[nodiscard]] std::size_t n_quartz() const noexcept { return n_quartz_; }
+
+  /// @throws std::invalid_argument, если размеры массивов не совпадают
+  /// с заданными в конструкторе.
+  void Append(const ResultRow& row);
+
+  /// @throws std::runtime_error при ошибке записи.
+  void Flush();
+
+ private:
+  static constexpr std::size_t kDefaultBufferSize = std::size_t{1} << 20;
+
+  void AppendBinary(const ResultRow& row);
+  void AppendCsv(const ResultRow& row);
+
+  std::ofstream out_;
+  Format format_;
+  std::size_t n_plasma_;
+  std::size_t n_quartz_;
+  std::size_t buffer_size_;
+  std::string buffer_;
+};
@@ -0,0 +1,119 @@
+#include "io/atomic_file.h"
+
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#else
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <thread>
+#endif
+
+namespace {
+
+[[noreturn]] void Fail(const std::filesystem::path& path,
+                       std::string_view what) {
+  throw std::runtime_error(std::format("{}: {}", path.string(), what));
+}
+
+#ifdef __unix__
+/// Пишет data в fd, сбрасывает на диск и закрывает fd.
+void WriteAndClose(int fd,
+                   const std::filesystem::path& path,
+                   std::string_view data) {
+  while (!data.empty()) {
+    const auto written = write(fd, data.data(), data.size());
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      close(fd);
+      Fail(path, "write failed");
+    }
+    data.remove_prefix(static_cast<std::size_t>(written));
+  }
+  if (fsync(fd) != 0) {
+    close(fd);
+    Fail(path, "fsync failed");
+  }
+  close(fd);
+}
+#else
+void Write(const std::filesystem::path& path,
+           std::string_view data,
+           std::ios::openmode mode) {
+  std::ofstream out{path, std::ios::binary | mode};
+  out.write(data.data(), static_cast<std::streamsize>(data.size()));
+  out.flush();
+  if (!out) {
+    Fail(path, "write failed");
+  }
+}
+#endif
+
+}  // namespace
+
+void WriteFileAtomically(const std::filesystem::path& path,
+                         std::string_view data) {
+  // Своё имя у каждой записи: одновременные записи одного path (процессы
+  // с общим каталогом кеша) не пишут в один временный файл.
+#ifdef __unix__
+  auto name = path.string() + ".XXXXXX";
+  const auto fd = mkstemp(name.data());
+  if (fd < 0) {
+    Fail(name, "can't create");
+  }
+  const std::filesystem::path tmp = name;
+  // mkstemp создаёт файл 0600, а записывался он всегда как 0644.
+  static_cast<void>(fchmod(fd, 0644));
+  try {
+    WriteAndClose(fd, tmp, data);
+  } catch (const std::runtime_error&) {
+    unlink(name.c_str());
+    throw;
+  }
+#else
+  static std::atomic<unsigned> counter{0};
+  auto tmp = path;
+  tmp += std::format(".{:x}.{}",
+                     std::hash<std::thread::id>{}(std::this_thread::get_id()),
+                     counter++);
+  try {
+    Write(tmp, data, std::ios::trunc);
+  } catch (const std::runtime_error&) {
+    std::error_code ec;
+    std::filesystem::remove(tmp, ec);
+    throw;
+  }
+#endif
+
+  std::error_code ec;
+  std::filesystem::rename(tmp, path, ec);
+  if (ec) {
+    std::error_code ignored;
+    std::filesystem::remove(tmp, ignored);
+    Fail(path, ec.message());
+  }
+}
+
+void AppendToFile(const std::filesystem::path& path, std::string_view data) {
+#ifdef __unix__
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+  const auto fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd < 0) {
+    Fail(path, "can't open for appending");
+  }
+  WriteAndClose(fd, path, data);
+#else
+  Write(path, data, std::ios::app);
+#endif
+}
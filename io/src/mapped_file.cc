@@ -0,0 +1,71 @@
+#include "io/mapped_file.h"
+
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace {
+
+[[noreturn]] void Fail(const std::filesystem::path& path,
+                       std::string_view what) {
+  throw std::runtime_error(std::format("{}: {}", path.string(), what));
+}
+
+}  // namespace
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+#ifdef __unix__
+  const auto fd = open(path.c_str(), O_RDONLY);  // NOLINT
+  if (fd < 0) {
+    Fail(path, "can't open");
+  }
+  struct stat st {};
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    Fail(path, "can't stat");
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+  if (size_ > 0) {
+    auto* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {  // NOLINT
+      close(fd);
+      Fail(path, "can't mmap");
+    }
+    data_ = static_cast<const std::byte*>(data);
+  }
+  close(fd);
+#else
+  std::ifstream in{path, std::ios::binary | std::ios::ate};
+  if (!in) {
+    Fail(path, "can't open");
+  }
+  size_ = static_cast<std::size_t>(in.tellg());
+  buffer_.resize((size_ + sizeof(double) - 1) / sizeof(double));
+  in.seekg(0);
+  in.read(reinterpret_cast<char*>(buffer_.data()),  // NOLINT
+          static_cast<std::streamsize>(size_));
+  data_ = reinterpret_cast<const std::byte*>(buffer_.data());  // NOLINT
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)},
+      buffer_{std::move(other.buffer_)} {}
+
+MappedFile::~MappedFile() {
+#ifdef __unix__
+  if (data_ != nullptr) {
+    munmap(const_cast<std::byte*>(data_), size_);  // NOLINT
+  }
+#endif
+}
@@ -0,0 +1,56 @@
+#include "io/result_file.h"
+
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+namespace {
+
+[[noreturn]] void Fail(const std::filesystem::path& path,
+                       std::string_view what) {
+  throw std::runtime_error(std::format("{}: {}", path.string(), what));
+}
+
+}  // namespace
+
+ResultFile::ResultFile(const std::filesystem::path& path)
+    : file_{path}, header_{} {
+  const auto bytes = file_.bytes();
+  if (bytes.size() < sizeof header_) {
+    Fail(path, "too short for a header");
+  }
+  std::memcpy(&header_, bytes.data(), sizeof header_);
+  if (header_.magic != ResultHeader::kMagic) {
+    Fail(path, "not a result file");
+  }
+  if (header_.version != ResultHeader::kVersion ||
+      header_.header_size != sizeof header_ ||
+      header_.n_scalars != ResultHeader::kScalars) {
+    Fail(path, std::format("unsupported version {}", header_.version));
+  }
+  rows_ = (bytes.size() - sizeof header_) / (header_.Width() * sizeof(double));
+}
+
+auto ResultFile::operator[](std::size_t i) const -> Row {
+  // Строки выровнены на 8 байт: заголовок 32 байта, mmap — на страницу.
+  const std::span<const double> row{
+      reinterpret_cast<const double*>(  // NOLINT
+          file_.bytes().data() + sizeof header_ +
+          i * header_.Width() * sizeof(double)),
+      header_.Width()};
+  const auto n_plasma = std::size_t{header_.n_plasma};
+  const auto n_quartz = std::size_t{header_.n_quartz};
+  const auto shells = row.subspan(header_.n_scalars);
+  return {
+      .band = static_cast<std::int64_t>(row[0]),
+      .nu = row[1],
+      .d_nu = row[2],
+      .intensity_all = row[3],
+      .absorbed_mirror = row[4],
+      .residual = row[5],
+      .absorbed_plasma = shells.subspan(0, n_plasma),
+      .absorbed_plasma3 = shells.subspan(n_plasma, n_plasma),
+      .absorbed_quartz = shells.subspan(2 * n_plasma, n_quartz),
+      .absorbed_quartz3 = shells.subspan(2 * n_plasma + n_quartz, n_quartz),
+  };
+}
@@ -0,0 +1,137 @@
+#include "io/result_writer.h"
+
+#include <bit>
+#include <cstring>
+#include <format>
+#include <ios>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+
+static_assert(std::endian::native == std::endian::little,
+              "ResultFile is little-endian");
+
+auto ResultWriter::FormatFor(const std::filesystem::path& path) -> Format {
+  return path.extension() == ".csv" ? Format::kCsv : Format::kBinary;
+}
+
+ResultWriter::ResultWriter(const std::filesystem::path& path,
+                           Format format,
+                           std::size_t n_plasma,
+                           std::size_t n_quartz,
+                           std::size_t buffer_size)
+    : out_{path, std::ios::binary | std::ios::trunc},
+      format_{format},
+      n_plasma_{n_plasma},
+      n_quartz_{n_quartz},
+      buffer_size_{buffer_size} {
+  if (!out_) {
+    throw std::runtime_error(
+        std::format("Can't open '{}' for writing", path.string()));
+  }
+  buffer_.reserve(buffer_size_);
+
+  if (format_ == Format::kBinary) {
+    const ResultHeader header{
+        .n_plasma = static_cast<std::uint32_t>(n_plasma_),
+        .n_quartz = static_cast<std::uint32_t>(n_quartz_),
+    };
+    buffer_.append(reinterpret_cast<const char*>(&header),  // NOLINT
+                   sizeof header);
+    return;
+  }
+
+  buffer_ += "band,nu,d_nu,intensity_all,absorbed_mirror,residual";
+  for (const auto* name : {"plasma", "plasma3"}) {
+    for (std::size_t i = 0; i < n_plasma_; ++i) {
+      buffer_ += std::format(",{}_{}", name, i);
+    }
+  }
+  for (const auto* name : {"quartz", "quartz3"}) {
+    for (std::size_t i = 0; i < n_quartz_; ++i) {
+      buffer_ += std::format(",{}_{}", name, i);
+    }
+  }
+  buffer_ += '\n';
+}
+
+ResultWriter::~ResultWriter() {
+  try {
+    Flush();
+  } catch (...) {  // NOLINT(bugprone-empty-catch)
+    // Деструктор не бросает; кому важна ошибка, вызывает Flush() сам.
+  }
+}
+
+void ResultWriter::Append(const ResultRow& row) {
+  if (row.absorbed_plasma.size() != n_plasma_ ||
+      row.absorbed_plasma3.size() != n_plasma_ ||
+      row.absorbed_quartz.size() != n_quartz_ ||
+      row.absorbed_quartz3.size() != n_quartz_) {
+    throw std::invalid_argument(std::format(
+        "Expected {} plasma and {} quartz shells, got {} and {}", n_plasma_,
+        n_quartz_, row.absorbed_plasma.size(), row.absorbed_quartz.size()));
+  }
+
+  if (format_ == Format::kBinary) {
+    AppendBinary(row);
+  } else {
+    AppendCsv(row);
+  }
+  if (buffer_.size() >= buffer_size_) {
+    Flush();
+  }
+}
+
+void ResultWriter::Flush() {
+  if (buffer_.empty()) {
+    return;
+  }
+  out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  out_.flush();
+  buffer_.clear();
+  if (!out_) {
+    throw std::runtime_error("Result write failed");
+  }
+}
+
+void ResultWriter::AppendBinary(const ResultRow& row) {
+  const auto put = [this](double value) {
+    char bytes[sizeof value];  // NOLINT(modernize-avoid-c-arrays)
+    std::memcpy(bytes, &value, sizeof value);
+    buffer_.append(bytes, sizeof value);
+  };
+  const auto put_all = [&](std::span<const Float> values) {
+    for (const auto value : values) {
+      put(value);
+    }
+  };
+
+  put(static_cast<double>(row.band));
+  put(row.nu);
+  put(row.d_nu);
+  put(row.intensity_all);
+  put(row.absorbed_mirror);
+  put(row.residual);
+  put_all(row.absorbed_plasma);
+  put_all(row.absorbed_plasma3);
+  put_all(row.absorbed_quartz);
+  put_all(row.absorbed_quartz3);
+}
+
+void ResultWriter::AppendCsv(const ResultRow& row) {
+  const auto put_all = [this](std::span<const Float> values) {
+    for (const auto value : values) {
+      std::format_to(std::back_inserter(buffer_), ",{}", value);
+    }
+  };
+
+  std::format_to(std::back_inserter(buffer_), "{},{},{},{},{},{}", row.band,
+                 row.nu, row.d_nu, row.intensity_all, row.absorbed_mirror,
+                 row.residual);
+  put_all(row.absorbed_plasma);
+  put_all(row.absorbed_plasma3);
+  put_all(row.absorbed_quartz);
+  put_all(row.absorbed_quartz3);
+  buffer_ += '\n';
+}
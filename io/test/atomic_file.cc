@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "io/atomic_file.h"
+
+namespace {
+
+class AtomicFileTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    const auto* info = testing::UnitTest::GetInstance()->current_test_info();
+    dir_ = std::filesystem::temp_directory_path() /
+           (std::string{"mt_atomic_file_test_"} + info->name());
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+    path_ = dir_ / "file";
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir_); }
+
+  [[nodiscard]] std::string ReadAll() const {
+    std::ifstream in{path_, std::ios::binary};
+    return {std::istreambuf_iterator<char>{in}, {}};
+  }
+
+  std::filesystem::path dir_;
+  std::filesystem::path path_;
+};
+
+TEST_F(AtomicFileTest, ConcurrentWritersLeaveOneWholeFile) {
+  constexpr std::size_t kWriters = 8;
+  std::vector<std::string> contents;
+  for (std::size_t i = 0; i < kWriters; ++i) {
+    contents.push_back(std::string(1 << 16, static_cast<char>('a' + i)));
+  }
+  {
+    std::vector<std::jthread> threads;
+    for (const auto& data : contents) {
+      threads.emplace_back([&] {
+        for (int k = 0; k < 4; ++k) {
+          WriteFileAtomically(path_, data);
+        }
+      });
+    }
+  }
+
+  const auto data = ReadAll();
+  EXPECT_NE(std::ranges::find(contents, data), contents.end());
+  // Временные файлы переименованы все.
+  EXPECT_EQ(std::distance(std::filesystem::directory_iterator{dir_},
+                          std::filesystem::directory_iterator{}),
+            1);
+}
+
+TEST_F(AtomicFileTest, AppendCreatesAndExtends) {
+  AppendToFile(path_, "ab");
+  AppendToFile(path_, "cd");
+  EXPECT_EQ(ReadAll(), "abcd");
+  WriteFileAtomically(path_, "x");
+  EXPECT_EQ(ReadAll(), "x");
+}
+
+}  // namespace
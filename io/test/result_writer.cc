@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "base/config/float.h"
+#include "io/result_file.h"
+#include "io/result_writer.h"
+
+namespace {
+
+class ResultWriterTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    const auto* info = testing::UnitTest::GetInstance()->current_test_info();
+    path_ = std::filesystem::temp_directory_path() /
+            (std::string{"mt_io_test_"} + info->name());
+  }
+
+  void TearDown() override { std::filesystem::remove(path_); }
+
+  [[nodiscard]] std::string ReadAll() const {
+    std::ifstream in{path_, std::ios::binary};
+    return {std::istreambuf_iterator<char>{in}, {}};
+  }
+
+  std::filesystem::path path_;
+};
+
+const std::vector<Float> kPlasma = {1, 2, 3};
+const std::vector<Float> kPlasma3 = {4, 5, 6};
+const std::vector<Float> kQuartz = {0.5_F, 0.25_F};
+const std::vector<Float> kQuartz3 = {7, 8};
+
+[[nodiscard]] ResultRow Row(std::int64_t band) {
+  return {
+      .band = band,
+      .nu = 1e15_F,
+      .d_nu = 2e12_F,
+      .intensity_all = 10,
+      .absorbed_mirror = 0.125_F,
+      .residual = -1e-16_F,
+      .absorbed_plasma = kPlasma,
+      .absorbed_plasma3 = kPlasma3,
+      .absorbed_quartz = kQuartz,
+      .absorbed_quartz3 = kQuartz3,
+  };
+}
+
+TEST_F(ResultWriterTest, BinaryRoundTrip) {
+  {
+    ResultWriter writer{path_, ResultWriter::Format::kBinary, 3, 2};
+    writer.Append(Row(168));
+    writer.Append(Row(169));
+  }
+
+  const ResultFile file{path_};
+  ASSERT_EQ(file.size(), 2);
+  EXPECT_EQ(file.header().n_plasma, 3);
+  EXPECT_EQ(file.header().n_quartz, 2);
+  EXPECT_EQ(file.header().Width(), 16);
+
+  const auto row = file[1];
+  EXPECT_EQ(row.band, 169);
+  EXPECT_EQ(row.nu, static_cast<double>(1e15_F));
+  EXPECT_EQ(row.absorbed_mirror, 0.125);
+  EXPECT_EQ(std::vector<double>(row.absorbed_plasma.begin(),
+                                row.absorbed_plasma.end()),
+            (std::vector<double>{1, 2, 3}));
+  EXPECT_EQ(std::vector<double>(row.absorbed_plasma3.begin(),
+                                row.absorbed_plasma3.end()),
+            (std::vector<double>{4, 5, 6}));
+  EXPECT_EQ(std::vector<double>(row.absorbed_quartz.begin(),
+                                row.absorbed_quartz.end()),
+            (std::vector<double>{0.5, 0.25}));
+  EXPECT_EQ(std::vector<double>(row.absorbed_quartz3.begin(),
+                                row.absorbed_quartz3.end()),
+            (std::vector<double>{7, 8}));
+}
+
+TEST_F(ResultWriterTest, SmallBufferIsReadableWhileWriting) {
+  ResultWriter writer{path_, ResultWriter::Format::kBinary, 3, 2, 1};
+  writer.Append(Row(0));
+  writer.Append(Row(1));
+  EXPECT_EQ(ResultFile{path_}.size(), 2);
+}
+
+TEST_F(ResultWriterTest, IgnoresPartialRow) {
+  {
+    ResultWriter writer{path_, ResultWriter::Format::kBinary, 3, 2};
+    writer.Append(Row(0));
+    writer.Append(Row(1));
+  }
+  std::filesystem::resize_file(path_, std::filesystem::file_size(path_) - 8);
+  EXPECT_EQ(ResultFile{path_}.size(), 1);
+}
+
+TEST_F(ResultWriterTest, Csv) {
+  {
+    ResultWriter writer{path_, ResultWriter::Format::kCsv, 3, 0};
+    auto row = Row(-1);
+    row.absorbed_quartz = {};
+    row.absorbed_quartz3 = {};
+    writer.Append(row);
+  }
+  const auto text = ReadAll();
+  EXPECT_TRUE(text.starts_with(
+      "band,nu,d_nu,intensity_all,absorbed_mirror,residual,plasma_0,plasma_1,"
+      "plasma_2,plasma3_0,plasma3_1,plasma3_2\n-1,"))
+      << text;
+  EXPECT_TRUE(text.ends_with(",10,0.125,-1e-16,1,2,3,4,5,6\n")) << text;
+}
+
+TEST_F(ResultWriterTest, RejectsShapeMismatch) {
+  ResultWriter writer{path_, ResultWriter::Format::kBinary, 4, 2};
+  EXPECT_THROW(writer.Append(Row(0)), std::invalid_argument);
+}
+
+TEST_F(ResultWriterTest, RejectsForeignFile) {
+  std::ofstream{path_} << "band,nu\n0123456789012345678901234567890123\n";
+  EXPECT_THROW(ResultFile{path_}, std::runtime_error);
+}
+
+TEST(ResultWriterFormatTest, ByExtension) {
+  EXPECT_EQ(ResultWriter::FormatFor("out.csv"), ResultWriter::Format::kCsv);
+  EXPECT_EQ(ResultWriter::FormatFor("out.bin"),
+            ResultWriter::Format::kBinary);
+}
+
+}  // namespace
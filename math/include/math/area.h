@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "base/config/float.h"
+
+/// Площади и вложенность фигур сечения трубки: эллипса и кругов плазмы на
+/// его большой оси. Точные формулы вместо растровой оценки.
+namespace area {
+
+/// Эллипс x^2 / a^2 + y^2 / b^2 <= 1 с центром в начале координат,
+/// a, b > 0.
+struct Ellipse {
+  Float a{};
+  Float b{};
+};
+
+/// Круг радиуса r > 0 с центром (x, 0) на оси эллипса.
+struct Circle {
+  Float x{};
+  Float r{};
+};
+
+[[nodiscard]] Float Of(const Ellipse& e) noexcept;
+
+/// Площадь пересечения эллипса и круга.
+[[nodiscard]] Float Intersection(const Ellipse& e, const Circle& c) noexcept;
+
+/// Круг целиком лежит в эллипсе (касание допускается).
+[[nodiscard]] bool Contains(const Ellipse& e, const Circle& c) noexcept;
+
+/// Эллипс e делится подобными эллипсами на n колец; k-е лежит между
+/// масштабами k / n и (k + 1) / n. Для каждого кольца — доля его площади,
+/// не занятая кругами (круги не пересекаются друг с другом).
+[[nodiscard]] std::vector<Float> FreeRingFractions(
+    const Ellipse& e,
+    std::span<const Circle> circles,
+    std::size_t n);
+
+}  // namespace area
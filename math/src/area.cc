@@ -0,0 +1,134 @@
+#include "math/area.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "math/consts/pi.h"
+#include "math/equation.h"
+#include "math/fast_pow.h"
+#include "math/float/eps.h"
+
+namespace area {
+
+namespace {
+
+/// Первообразная полухорды sqrt(r^2 - u^2) круга радиуса r.
+Float HalfChordIntegral(Float u, Float r) noexcept {
+  const auto t = std::clamp(u / r, -kOne, kOne);
+  return (u * std::sqrt(std::max(Sqr(r) - Sqr(u), kZero)) +
+          Sqr(r) * std::asin(t)) /
+         2;
+}
+
+/// g(x) = y_e(x)^2 - y_c(x)^2: разность квадратов полухорд эллипса и круга
+/// при абсциссе x. Квадратный трёхчлен k x^2 + l x + m; g >= 0 там, где
+/// круг не выходит за эллипс.
+struct Gap {
+  Float k;
+  Float l;
+  Float m;
+
+  [[nodiscard]] Float operator()(Float x) const noexcept {
+    return (k * x + l) * x + m;
+  }
+};
+
+Gap MakeGap(const Ellipse& e, const Circle& c) noexcept {
+  return {.k = 1 - Sqr(e.b / e.a),
+          .l = -2 * c.x,
+          .m = Sqr(c.x) + Sqr(e.b) - Sqr(c.r)};
+}
+
+}  // namespace
+
+Float Of(const Ellipse& e) noexcept {
+  return consts::kPi * e.a * e.b;
+}
+
+Float Intersection(const Ellipse& e, const Circle& c) noexcept {
+  const auto lo = std::max(c.x - c.r, -e.a);
+  const auto hi = std::min(c.x + c.r, e.a);
+  if (!(lo < hi)) {
+    return kZero;
+  }
+
+  // Границы пересекаются в корнях g; между ними сечение ограничивает одна
+  // и та же кривая, и площадь полосы считается по первообразной.
+  const auto g = MakeGap(e, c);
+  std::array<Float, 4> xs{lo, hi, lo, hi};
+  auto x0 = kZero;
+  auto x1 = kZero;
+  if (equation::SolveQuadratic(g.k, g.l, g.m, x0, x1) ==
+      equation::Result::kHasRealSolution) {
+    xs[2] = std::clamp(x0, lo, hi);
+    xs[3] = std::clamp(x1, lo, hi);
+  }
+  std::ranges::sort(xs);
+
+  auto half = kZero;
+  for (std::size_t i = 0; i + 1 < xs.size(); ++i) {
+    const auto from = xs[i];
+    const auto to = xs[i + 1];
+    if (!(from < to)) {
+      continue;
+    }
+    if (g((from + to) / 2) >= 0) {
+      half += HalfChordIntegral(to - c.x, c.r) -
+              HalfChordIntegral(from - c.x, c.r);
+    } else {
+      half += e.b / e.a *
+              (HalfChordIntegral(to, e.a) - HalfChordIntegral(from, e.a));
+    }
+  }
+  return 2 * half;
+}
+
+bool Contains(const Ellipse& e, const Circle& c) noexcept {
+  // Круг внутри, если g >= 0 на всей его проекции [lo, hi]; на концах
+  // это заодно означает |x| <= a. Минимум g — на концах или в вершине.
+  // Допуск в масштабе эллипса, чтобы касание не зависело от округления.
+  const auto g = MakeGap(e, c);
+  const auto tolerance = -kEps * Sqr(std::max(e.a, e.b));
+  const auto lo = c.x - c.r;
+  const auto hi = c.x + c.r;
+  if (g(lo) < tolerance || g(hi) < tolerance) {
+    return false;
+  }
+  if (g.k <= 0) {
+    return true;
+  }
+  const auto vertex = -g.l / (2 * g.k);
+  return vertex <= lo || hi <= vertex || g(vertex) >= tolerance;
+}
+
+std::vector<Float> FreeRingFractions(const Ellipse& e,
+                                     std::span<const Circle> circles,
+                                     std::size_t n) {
+  const auto n_f = static_cast<Float>(n);
+  const auto occupied = [&](std::size_t k) {
+    auto s = kZero;
+    if (k > 0) {
+      const auto scale = static_cast<Float>(k) / n_f;
+      for (const auto& c : circles) {
+        s += Intersection({.a = e.a * scale, .b = e.b * scale}, c);
+      }
+    }
+    return s;
+  };
+
+  std::vector<Float> fractions(n);
+  auto inner = occupied(0);
+  for (std::size_t k = 0; k < n; ++k) {
+    const auto outer = occupied(k + 1);
+    const auto ring = Of(e) * static_cast<Float>(2 * k + 1) / Sqr(n_f);
+    fractions[k] = 1 - (outer - inner) / ring;
+    inner = outer;
+  }
+  return fractions;
+}
+
+}  // namespace area
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include "base/config/float.h"
+#include "math/area.h"
+#include "math/consts/pi.h"
+#include "math/fast_pow.h"
+
+namespace {
+
+constexpr auto kTolerance = 1e-4_F;
+
+/// Площадь пересечения по средним прямоугольникам.
+Float NumericIntersection(const area::Ellipse& e, const area::Circle& c) {
+  constexpr std::size_t kSteps = 100000;
+  const auto lo = std::max(c.x - c.r, -e.a);
+  const auto hi = std::min(c.x + c.r, e.a);
+  const auto step = (hi - lo) / kSteps;
+  auto sum = kZero;
+  for (std::size_t i = 0; i < kSteps; ++i) {
+    const auto x = lo + step * (static_cast<Float>(i) + 0.5_F);
+    const auto yc = std::sqrt(std::max(Sqr(c.r) - Sqr(x - c.x), kZero));
+    const auto ye = e.b * std::sqrt(std::max(1 - Sqr(x / e.a), kZero));
+    sum += 2 * std::min(yc, ye) * step;
+  }
+  return sum;
+}
+
+}  // namespace
+
+TEST(AreaTest, Ellipse) {
+  ASSERT_NEAR(area::Of({.a = 2, .b = 0.5_F}), consts::kPi, kTolerance);
+}
+
+TEST(AreaTest, CircleInsideEllipse) {
+  const area::Circle c{.x = 0.5_F, .r = 0.3_F};
+  ASSERT_NEAR(area::Intersection({.a = 2, .b = 1}, c),
+              consts::kPi * Sqr(c.r), kTolerance);
+}
+
+TEST(AreaTest, EllipseInsideCircle) {
+  const area::Ellipse e{.a = 1, .b = 0.5_F};
+  ASSERT_NEAR(area::Intersection(e, {.x = 0.1_F, .r = 1.5_F}), area::Of(e),
+              kTolerance);
+}
+
+TEST(AreaTest, Disjoint) {
+  ASSERT_EQ(area::Intersection({.a = 1, .b = 1}, {.x = 3, .r = 1}), kZero);
+}
+
+TEST(AreaTest, LensOfEqualCircles) {
+  const auto r = 1.0_F;
+  const auto d = 1.2_F;
+  const auto lens = 2 * Sqr(r) * std::acos(d / (2 * r)) -
+                    d / 2 * std::sqrt(4 * Sqr(r) - Sqr(d));
+  ASSERT_NEAR(area::Intersection({.a = r, .b = r}, {.x = d, .r = r}), lens,
+              kTolerance);
+}
+
+TEST(AreaTest, PartialOverlapMatchesQuadrature) {
+  for (const auto& [e, c] : {
+           std::pair{area::Ellipse{.a = 2, .b = 1}, area::Circle{1.5_F, 0.8_F}},
+           std::pair{area::Ellipse{.a = 1, .b = 2}, area::Circle{0.7_F, 0.6_F}},
+           std::pair{area::Ellipse{.a = 3, .b = 1}, area::Circle{-2, 1.5_F}},
+       }) {
+    ASSERT_NEAR(area::Intersection(e, c), NumericIntersection(e, c),
+                kTolerance);
+  }
+}
+
+TEST(AreaTest, Contains) {
+  const area::Ellipse e{.a = 2, .b = 1};
+  ASSERT_TRUE(area::Contains(e, {.x = 0, .r = 1}));  // Касание сверху.
+  ASSERT_TRUE(area::Contains(e, {.x = 1.4_F, .r = 0.4_F}));
+  ASSERT_FALSE(area::Contains(e, {.x = 0, .r = 1.01_F}));
+  ASSERT_FALSE(area::Contains(e, {.x = 1.5_F, .r = 0.6_F}));
+  ASSERT_FALSE(area::Contains(e, {.x = 3, .r = 0.1_F}));
+}
+
+TEST(AreaTest, FreeRingFractions) {
+  const area::Ellipse e{.a = 2, .b = 1};
+  const std::array circles{area::Circle{.x = -1, .r = 0.5_F},
+                           area::Circle{.x = 1, .r = 0.5_F}};
+  constexpr std::size_t kN = 8;
+  const auto fractions = area::FreeRingFractions(e, circles, kN);
+  ASSERT_EQ(fractions.size(), kN);
+
+  // Кольца внутри зазора и снаружи кругов свободны.
+  ASSERT_NEAR(fractions.front(), kOne, kTolerance);
+  ASSERT_NEAR(fractions.back(), kOne, kTolerance);
+
+  auto occupied = kZero;
+  for (std::size_t k = 0; k < kN; ++k) {
+    ASSERT_GE(fractions[k], -kTolerance);
+    ASSERT_LE(fractions[k], 1 + kTolerance);
+    occupied += (1 - fractions[k]) * area::Of(e) *
+                static_cast<Float>(2 * k + 1) / Sqr(static_cast<Float>(kN));
+  }
+  ASSERT_NEAR(occupied, 2 * consts::kPi * Sqr(0.5_F), kTolerance);
+}
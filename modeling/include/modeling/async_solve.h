@@ -0,0 +1,189 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "modeling/parallel_for.h"
+#include "modeling/solve_monitor.h"
+#include "modeling/thread_pool.h"
+
+/// Solver{params}.Solve() в отдельном потоке: ход решения, остановка и
+/// результат по готовности, как у std::future. Деструктор останавливает
+/// решение и дожидается потока.
+///
+///   AsyncSolve<CylinderPlasma> solve{params, {.partial = true}};
+///   ... solve.progress() ...
+///   solve.Cancel();
+///   const auto r = solve.Get();  // экстраполированный по пройденным
+template <typename Solver>
+class AsyncSolve {
+ public:
+  using Params = typename Solver::Params;
+  using Result = typename Solver::Result;
+
+  struct Options {
+    /// После Cancel() на трассировке Get() возвращает результат,
+    /// экстраполированный по пройденным направлениям (SolveMonitor).
+    bool partial = false;
+    /// Пул для трассировки; nullptr — свои потоки на n_threads.
+    ThreadPool* pool = nullptr;
+  };
+
+  explicit AsyncSolve(const Params& params, Options options = {})
+      : monitor_{stop_.get_token(), options.partial},
+        result_{promise_.get_future()},
+        thread_{[this, params, pool = options.pool] { Run(params, pool); }} {}
+
+  AsyncSolve(const AsyncSolve&) = delete;
+  AsyncSolve(AsyncSolve&&) = delete;
+  AsyncSolve& operator=(const AsyncSolve&) = delete;
+  AsyncSolve& operator=(AsyncSolve&&) = delete;
+
+  ~AsyncSolve() { Cancel(); }
+
+  [[nodiscard]] SolveProgress progress() const noexcept {
+    return monitor_.progress();
+  }
+
+  /// Просит решатель остановиться; он проверяет запрос между направлениями.
+  void Cancel() noexcept { stop_.request_stop(); }
+
+  /// Результат готов или уже забран Get().
+  [[nodiscard]] bool ready() const {
+    return !result_.valid() || result_.wait_for(std::chrono::seconds{0}) ==
+                                   std::future_status::ready;
+  }
+
+  void Wait() const {
+    if (result_.valid()) {
+      result_.wait();
+    }
+  }
+
+  /// Ждёт и возвращает результат; вызывается один раз.
+  /// @throws SolveCancelled Остановлено без результата.
+  /// @throws std::runtime_error Ошибка решателя (баланс энергии).
+  [[nodiscard]] Result Get() { return result_.get(); }
+
+  /// Решение было прервано: результат Get() неполный или его нет.
+  [[nodiscard]] bool stopped() const noexcept { return monitor_.stopped(); }
+
+ private:
+  void Run(const Params& params, ThreadPool* pool) {
+    try {
+      Solver solver{params};
+      promise_.set_value(pool != nullptr ? solver.Solve(monitor_, *pool)
+                                         : solver.Solve(monitor_));
+    } catch (...) {
+      promise_.set_exception(std::current_exception());
+    }
+  }
+
+  std::stop_source stop_;
+  SolveMonitor monitor_;
+  std::promise<Result> promise_;
+  std::future<Result> result_;
+  std::jthread thread_;  ///< Последним: поток видит готовые члены.
+};
+
+/// Перебор вариантов (полос спектра) в фоне: Solver{params[i]}.Solve() на
+/// pool, не более concurrency вариантов сразу. Готовые варианты забираются
+/// Take() по мере готовности, в любом порядке. Деструктор останавливает
+/// перебор и дожидается потока.
+///
+///   AsyncSweep<CylinderPlasmaQuartz> sweep{params, pool, 4};
+///   ... for (auto& [i, r] : sweep.Take()) ... sweep.done() ...
+template <typename Solver>
+class AsyncSweep {
+ public:
+  using Params = typename Solver::Params;
+  using Result = typename Solver::Result;
+
+  struct Done {
+    std::size_t index;  ///< Номер варианта в params.
+    Result result;
+  };
+
+  AsyncSweep(std::vector<Params> params,
+             ThreadPool& pool,
+             std::size_t concurrency)
+      : params_{std::move(params)},
+        thread_{[this, &pool, concurrency] { Run(pool, concurrency); }} {}
+
+  AsyncSweep(const AsyncSweep&) = delete;
+  AsyncSweep(AsyncSweep&&) = delete;
+  AsyncSweep& operator=(const AsyncSweep&) = delete;
+  AsyncSweep& operator=(AsyncSweep&&) = delete;
+
+  ~AsyncSweep() { Cancel(); }
+
+  [[nodiscard]] std::size_t size() const noexcept { return params_.size(); }
+  /// Решённых вариантов, включая ещё не забранные.
+  [[nodiscard]] std::size_t done() const noexcept {
+    return done_.load(std::memory_order_relaxed);
+  }
+
+  /// Варианты, решённые после прошлого вызова.
+  [[nodiscard]] std::vector<Done> Take() {
+    const std::lock_guard lock{mutex_};
+    return std::exchange(ready_, {});
+  }
+
+  /// Просит остановиться; идущие варианты прерываются между направлениями
+  /// и не попадают в Take().
+  void Cancel() noexcept { stop_.request_stop(); }
+
+  /// Перебор закончен, остановлен или прерван ошибкой.
+  [[nodiscard]] bool finished() const noexcept {
+    return finished_.load(std::memory_order_acquire);
+  }
+
+  /// Первая ошибка решателя (баланс энергии), после которой перебор
+  /// остановлен; nullptr, если её не было. Читается после finished().
+  [[nodiscard]] std::exception_ptr error() const noexcept { return error_; }
+
+ private:
+  void Run(ThreadPool& pool, std::size_t concurrency) {
+    ParallelFor(
+        params_.size(), concurrency,
+        [&](std::size_t i, std::size_t /*thread*/) {
+          if (stop_.stop_requested()) {
+            return;
+          }
+          SolveMonitor monitor{stop_.get_token()};
+          try {
+            auto r = Solver{params_[i]}.Solve(monitor, pool);
+            const std::lock_guard lock{mutex_};
+            ready_.push_back({.index = i, .result = std::move(r)});
+            done_.fetch_add(1, std::memory_order_relaxed);
+          } catch (const SolveCancelled&) {
+            // Остановлено через Cancel() или после ошибки другого варианта.
+          } catch (...) {
+            const std::lock_guard lock{mutex_};
+            if (!error_) {
+              error_ = std::current_exception();
+            }
+            stop_.request_stop();
+          }
+        },
+        &pool);
+    finished_.store(true, std::memory_order_release);
+  }
+
+  const std::vector<Params> params_;
+  std::stop_source stop_;
+  std::mutex mutex_;
+  std::vector<Done> ready_;
+  std::atomic<std::size_t> done_{0};
+  std::exception_ptr error_;
+  std::atomic<bool> finished_{false};
+  std::jthread thread_;  ///< Последним: поток видит готовые члены.
+};
@@ -1,15 +1,28 @@
 #pragma once
 
 #include <cstddef>
+#include <span>
 #include <vector>
 
 #include "base/config/float.h"
 #include "base/fast_pimpl.h"
 
+#include "modeling/energy_balance.h"
+#include "modeling/solve_timings.h"
+
+class SolveMonitor;
+class ThreadPool;
+
 struct CylinderPlasma {
   struct Params {
     Float r = 0.35_F;
     std::size_t n_plasma = 40;
+    /// Ширина слоя плазмы у стенки относительно центрального слоя
+    /// (radial_mesh.h): < 1 сгущает слои к стенке, 1 — равные слои.
+    Float plasma_grading = 1;
+    /// Слои плазмы по профилю температуры и поглощения (PlasmaRadii в
+    /// radial_mesh.h) вместо plasma_grading.
+    bool adaptive_plasma = false;
 
     Float t0 = 10000.0_F;
     Float tw = 2000.0_F;
@@ -23,8 +36,12 @@ struct CylinderPlasma {
     std::size_t n_meridian = 100;
     std::size_t n_latitude = 100;
 
-    std::size_t n_threads = 4;
+    std::size_t n_threads = 4;  ///< Потоков трассировки, 0 — как 1.
     Float i_crit = 0.000001_F;
+
+    /// Допустимая относительная невязка энергетического баланса.
+    /// 0 — не проверять.
+    Float energy_tolerance = 0;
   };
 
   explicit CylinderPlasma(const Params& params);
@@ -35,13 +52,31 @@ struct CylinderPlasma {
     std::vector<Float> absorbed_plasma3;
     Float absorbed_mirror{};
     Float intensity_all{};
+    EnergyBalance balance{};
+    SolveTimings timings{};
   };
 
+  /// Результат берётся из ResultCache::Default(), если кеш включён.
   Result Solve();
+  /// Трассировка на потоках общего пула, не более n_threads сразу.
+  Result Solve(ThreadPool& pool);
+  /// С ходом решения и остановкой через monitor (solve_monitor.h).
+  /// @throws SolveCancelled
+  Result Solve(SolveMonitor& monitor);
+  Result Solve(SolveMonitor& monitor, ThreadPool& pool);
+
+  /// Результаты вариантов в порядке params, как у Solve() каждого. Набор
+  /// направлений и излучение плазмы считаются один раз для вариантов,
+  /// которые различаются только rho, i_crit, energy_tolerance и n_threads
+  /// (solve_batch.h); варианты решаются параллельно. Без pool — на
+  /// max(n_threads) потоках.
+  static std::vector<Result> SolveBatch(std::span<const Params> params);
+  static std::vector<Result> SolveBatch(std::span<const Params> params,
+                                        ThreadPool& pool);
 
  private:
   class Impl;
-  static constexpr std::size_t kSize = 288;
+  static constexpr std::size_t kSize = sizeof(Float) == 8 ? 336 : 272;
   static constexpr std::size_t kAlignment = 8;
   FastPimpl<Impl, kSize, kAlignment> pimpl_;
 };
@@ -1,14 +1,20 @@
 #pragma once
 
 #include <cstddef>
+#include <span>
 #include <vector>
 
 #include "base/config/float.h"
 #include "base/fast_pimpl.h"
 
+#include "modeling/energy_balance.h"
+#include "modeling/solve_timings.h"
 #include "physics/params/plasma.h"
 #include "physics/params/quartz.h"
 
+class SolveMonitor;
+class ThreadPool;
+
 struct CylinderPlasmaQuartz {
   struct Params {
     Float r = 0.35_F;
@@ -16,6 +22,15 @@ struct CylinderPlasmaQuartz {
 
     Float delta = 0.1_F;
     std::size_t n_quartz = 15;
+    /// Ширина слоя плазмы у стенки относительно центрального слоя
+    /// (radial_mesh.h): < 1 сгущает слои к стенке, 1 — равные слои.
+    Float plasma_grading = 1;
+    /// Слои плазмы по профилю температуры и поглощения (PlasmaRadii в
+    /// radial_mesh.h) вместо plasma_grading.
+    bool adaptive_plasma = false;
+    /// Ширина слоя кварца у плазмы относительно внешнего слоя: < 1 сгущает
+    /// слои к плазме.
+    Float quartz_grading = 1;
 
     Float t0 = 10000.0_F;
     Float tw = 2000.0_F;
@@ -32,8 +47,12 @@ struct CylinderPlasmaQuartz {
     std::size_t n_meridian = 100;
     std::size_t n_latitude = 100;
 
-    std::size_t n_threads = 4;
+    std::size_t n_threads = 4;  ///< Потоков трассировки, 0 — как 1.
     Float i_crit = 0.000001_F;
+
+    /// Допустимая относительная невязка энергетического баланса.
+    /// 0 — не проверять.
+    Float energy_tolerance = 0;
   };
 
   CylinderPlasmaQuartz(const Params& params);
@@ -46,13 +65,32 @@ struct CylinderPlasmaQuartz {
     std::vector<Float> absorbed_quartz3;
     Float absorbed_mirror{};
     Float intensity_all{};
+    EnergyBalance balance{};
+    SolveTimings timings{};
   };
 
+  /// Результат берётся из ResultCache::Default(), если кеш включён.
   Result Solve();
+  /// Трассировка на потоках общего пула, не более n_threads сразу.
+  Result Solve(ThreadPool& pool);
+  /// С ходом решения и остановкой через monitor (solve_monitor.h).
+  /// @throws SolveCancelled
+  Result Solve(SolveMonitor& monitor);
+  Result Solve(SolveMonitor& monitor, ThreadPool& pool);
+
+  /// Результаты вариантов в порядке params, как у Solve() каждого. Набор
+  /// направлений и излучение плазмы считаются один раз для вариантов,
+  /// которые различаются только rho, i_crit, кварцем (delta, n_quartz,
+  /// quartz_grading, t1, eta_*), energy_tolerance и n_threads
+  /// (solve_batch.h); варианты решаются параллельно. Без pool — на
+  /// max(n_threads) потоках.
+  static std::vector<Result> SolveBatch(std::span<const Params> params);
+  static std::vector<Result> SolveBatch(std::span<const Params> params,
+                                        ThreadPool& pool);
 
  private:
   class Impl;
-  static constexpr std::size_t kSize = 528;
+  static constexpr std::size_t kSize = sizeof(Float) == 8 ? 608 : 488;
   static constexpr std::size_t kAlignment = 8;
   FastPimpl<Impl, kSize, kAlignment> pimpl_;
 };
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "base/config/float.h"
+
+/// Энергетический баланс решения:
+///   intensity_all = plasma + quartz + mirror + residual.
+/// Доли, списанные по intensity_end, уже входят в соответствующие суммы
+/// поглощения и выделены отдельно, чтобы оценить потери точности от i_crit.
+struct EnergyBalance {
+  Float absorbed_plasma{};
+  Float absorbed_quartz{};
+  Float absorbed_mirror{};
+
+  Float truncated_plasma{};
+  Float truncated_quartz{};
+  Float truncated_mirror{};
+
+  Float residual{};
+};
+
+/// Считает residual. При tolerance > 0 проверяет
+/// |residual| <= tolerance * emitted.
+/// @throws std::runtime_error Если баланс не сходится.
+void CheckEnergyBalance(EnergyBalance& balance, Float emitted, Float tolerance);
@@ -6,6 +6,7 @@
 #include "base/config/float.h"
 #include "math/linalg/vector.h"
 #include "modeling/cylinder_common.h"
+#include "modeling/ray_path.h"
 #include "modeling/worker.h"
 #include "ray_tracing/cylinder_z_infinite.h"
 
@@ -20,6 +21,10 @@ struct HollowCylinder {
     Float refractive_index_external;
     Float mirror_internal;
     Float mirror_external;
+    /// Внешние радиусы слоёв по возрастанию (radial_mesh.h), steps штук,
+    /// последний — radius_max. Пусто — steps равных слоёв; тогда
+    /// заполняется при построении.
+    std::vector<Float> radii{};
   };
 
   HollowCylinder(const Params& params,
@@ -27,7 +32,8 @@ struct HollowCylinder {
                  const IntensityFunc& intensity,
                  const AttenuationFunc& attenuation);
 
-  [[nodiscard]] WorkerResult SolveDir(const WorkerParams& params) const;
+  [[nodiscard]] WorkerResult SolveDir(const WorkerParams& params,
+                                      RayPathBuffer* path = nullptr) const;
 
   [[nodiscard]] const Params& params() const { return params_; }
 
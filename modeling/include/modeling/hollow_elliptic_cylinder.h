@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "base/config/float.h"
+#include "math/linalg/vector.h"
+#include "modeling/cylinder_common.h"
+#include "modeling/ray_path.h"
+#include "modeling/worker.h"
+#include "ray_tracing/elliptic_cylinder_z_infinite.h"
+
+/// Стенка эллиптической трубки: как HollowCylinder, но границы слоёв —
+/// эллипсы с полуосями a_min + d, b_min + d, d = thickness * i / steps.
+/// Температура задаётся от относительной глубины в стенке z в [0, 1].
+struct HollowEllipticCylinder {
+  struct Params {
+    Vec3 center;
+    Float a_min;
+    Float b_min;
+    Float thickness;
+    std::size_t steps;
+    Float refractive_index;
+    Float refractive_index_internal;
+    Float refractive_index_external;
+    Float mirror_internal;
+    Float mirror_external;
+  };
+
+  HollowEllipticCylinder(const Params& params,
+                         const TemperatureFunc& temperature,
+                         const IntensityFunc& intensity,
+                         const AttenuationFunc& attenuation);
+
+  [[nodiscard]] WorkerResult SolveDir(const WorkerParams& params,
+                                      RayPathBuffer* path = nullptr) const;
+
+  [[nodiscard]] const Params& params() const { return params_; }
+
+  std::vector<EllipticCylinderZInfinite> cylinders;
+  std::vector<Float> temperatures;
+  std::vector<Float> intensities;
+  std::vector<Float> attenuations;
+
+ private:
+  Params params_;
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "modeling/thread_pool.h"
+
+/// Выполняет func(task, thread) для всех task из [0, n_tasks) на n_threads
+/// потоках (thread < n_threads). Задачи раздаются динамически, поэтому
+/// результат не должен зависеть от того, какой поток взял задачу.
+/// Первое исключение из func пробрасывается после завершения всех потоков.
+///
+/// Если задан pool, помощники ставятся в его очередь, а не создаются
+/// заново; их не больше pool->size(). Вызывающий поток работает сам и
+/// ждёт только помощников, уже взявших задачу, поэтому вызов из задачи
+/// того же пула не блокируется, даже если все его потоки заняты.
+template <typename Func>
+void ParallelFor(std::size_t n_tasks,
+                 std::size_t n_threads,
+                 Func&& func,
+                 ThreadPool* pool = nullptr) {
+  n_threads = std::clamp<std::size_t>(n_threads, 1,
+                                      std::max<std::size_t>(n_tasks, 1));
+  if (pool != nullptr) {
+    n_threads = std::min(n_threads, pool->size() + 1);
+  }
+  if (n_threads == 1) {
+    for (std::size_t task = 0; task < n_tasks; ++task) {
+      func(task, std::size_t{0});
+    }
+    return;
+  }
+
+  // Помощник из пула может начать работу уже после возврата, поэтому
+  // общее состояние живёт, пока на него ссылается хоть одна задача.
+  struct State {
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> helpers{0};
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t active{};
+    std::exception_ptr error;
+  };
+  const auto state = std::make_shared<State>();
+
+  const auto run = [n_tasks, &func](State& s, std::size_t thread) {
+    try {
+      for (auto task = s.next++; task < n_tasks; task = s.next++) {
+        func(task, thread);
+      }
+    } catch (...) {
+      const std::lock_guard lock{s.mutex};
+      if (!s.error) {
+        s.error = std::current_exception();
+      }
+      s.next = n_tasks;
+    }
+  };
+
+  if (pool != nullptr) {
+    for (std::size_t i = 1; i < n_threads; ++i) {
+      pool->Submit([state, run, n_tasks] {
+        {
+          const std::lock_guard lock{state->mutex};
+          if (state->next >= n_tasks) {
+            return;
+          }
+          ++state->active;
+        }
+        run(*state, ++state->helpers);
+        {
+          const std::lock_guard lock{state->mutex};
+          --state->active;
+        }
+        state->done.notify_one();
+      });
+    }
+    run(*state, 0);
+    std::unique_lock lock{state->mutex};
+    state->done.wait(lock, [&] { return state->active == 0; });
+  } else {
+    std::vector<std::jthread> threads;
+    threads.reserve(n_threads - 1);
+    for (std::size_t thread = 1; thread < n_threads; ++thread) {
+      threads.emplace_back(run, std::ref(*state), thread);
+    }
+    run(*state, 0);
+  }
+
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "base/config/float.h"
+#include "math/fast_pow.h"
+#include "modeling/cylinder_common.h"
+#include "physics/params/plasma.h"
+
+/// Радиальные сетки слоёв цилиндров. Сетка задаётся внешними границами
+/// слоёв по возрастанию; слой i лежит между radii[i - 1] и radii[i],
+/// нулевой — от внутренней границы тела до radii[0].
+
+/// ratio = 1 (равные слои) с учётом того, что ratio задаёт пользователь.
+[[nodiscard]] constexpr bool IsUniformGrading(Float ratio) noexcept {
+  return !(ratio < 1 || ratio > 1);
+}
+
+/// n слоёв между from и to, ширины которых меняются в геометрической
+/// прогрессии: последний слой в ratio раз шире первого. ratio < 1 сгущает
+/// слои к to, ratio > 1 — к from. При ratio = 1 границы те же, что у
+/// прежней равной сетки: from + step * i. Последняя граница — ровно to.
+/// @throws std::invalid_argument при n = 0 или ratio <= 0
+[[nodiscard]] std::vector<Float> GradedRadii(Float from,
+                                             Float to,
+                                             std::size_t n,
+                                             Float ratio);
+
+/// Поглощение слоёв, отнесённое к площади их сечения. Масштаб — как у
+/// 2 pi absorbed / r_avg на равной сетке с тем же числом слоёв (площадь
+/// кольца 2 pi r_avg step заменена точной), так что профили на разных
+/// сетках сравнимы. inner — внутренняя граница слоя 0.
+[[nodiscard]] std::vector<Float> ShellDensities(std::span<const Float> absorbed,
+                                                Float inner,
+                                                std::span<const Float> radii);
+
+/// Требования к слоям адаптивной сетки столба плазмы.
+struct AdaptiveMesh {
+  Float max_depth = 0.5_F;  ///< Оптическая толщина слоя по радиусу.
+  Float max_dt = 200;       ///< Перепад температуры в слое, К.
+};
+
+/// Отрезков мелкой равной сетки, на которой AdaptiveRadii оценивает
+/// профиль.
+inline constexpr std::size_t kAdaptiveMeshSamples = 4096;
+
+/// Сетка столба плазмы радиуса radius по профилю температуры и
+/// поглощению при ней (как у SolidCylinder). Границы сгущаются там, где
+/// быстрее всего меняются температура и поглощение, а ровное ядро профиля
+/// с большим m остаётся редким.
+///
+/// n = 0 — наименьшее число слоёв (не меньше двух), при котором каждый
+/// слой укладывается в mesh с точностью до разрешения
+/// kAdaptiveMeshSamples: слои набираются жадно по мелкой сетке, пока
+/// оптическая толщина и перепад температуры слоя не выйдут за mesh, затем
+/// предел равномерно снижается, пока слоёв столько же.
+///
+/// n > 0 — n слоёв с равной долей требований mesh в каждом (доля отрезка
+/// мелкой сетки — большая из долей max_depth и max_dt).
+/// @throws std::invalid_argument при max_depth <= 0 или max_dt <= 0
+[[nodiscard]] std::vector<Float> AdaptiveRadii(
+    Float radius,
+    const TemperatureFunc& temperature,
+    const AttenuationFunc& attenuation,
+    const AdaptiveMesh& mesh,
+    std::size_t n = 0);
+
+/// Сетка столба плазмы решателя с параметрами p: AdaptiveRadii с
+/// p.n_plasma слоями и требованиями AdaptiveMesh{} по умолчанию, если
+/// задан p.adaptive_plasma, иначе GradedRadii с p.plasma_grading. Профиль
+/// температуры и поглощение — те же, что у столба.
+/// @throws std::invalid_argument при n_plasma = 0
+template <typename Params>
+[[nodiscard]] std::vector<Float> PlasmaRadii(const Params& p) {
+  if (!p.adaptive_plasma) {
+    return GradedRadii(kZero, p.r, p.n_plasma, p.plasma_grading);
+  }
+  if (p.n_plasma == 0) {
+    throw std::invalid_argument("radial mesh needs at least one shell");
+  }
+  return AdaptiveRadii(
+      p.r,
+      [&p](Float z) { return p.t0 + (p.tw - p.t0) * FastPow(z, p.m); },
+      [&p](Float t) {
+        return params::plasma::AbsorptionCoefficient(p.nu, t);
+      },
+      AdaptiveMesh{}, p.n_plasma);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "base/config/float.h"
+#include "math/linalg/vector.h"
+#include "ray_tracing/cylinder_z_infinite.h"
+
+/// Бинарная запись траекторий лучей.
+///
+/// Включается во время выполнения переменными окружения:
+///   MT_RAY_PATH        — путь к файлу; `{}` заменяется на номер решателя;
+///   MT_RAY_PATH_SAMPLE — записывать каждое N-е направление (по умолчанию 1);
+///   MT_RAY_PATH_RAYS   — список направлений через запятую (вместо SAMPLE).
+/// Без MT_RAY_PATH запись выключена и не стоит ничего, кроме проверки
+/// указателя на шаг.
+
+enum class RayPathBody : std::uint8_t {
+  kPlasma,
+  kQuartz,
+};
+
+enum class RayPathEvent : std::uint8_t {
+  kStart,    ///< Луч вошёл в тело.
+  kStep,     ///< Луч дошёл до следующей цилиндрической поверхности.
+  kReflect,  ///< Отражение на границе тела.
+  kRelease,  ///< Преломлённая часть луча покинула тело.
+  kEnd,      ///< Интенсивность упала ниже intensity_end.
+};
+
+struct RayPathRecord {
+  std::uint32_t ray;
+  RayPathEvent event;
+  RayPathBody body;
+  std::uint16_t shell;
+  std::array<float, 3> pos;
+  float intensity;
+};
+static_assert(sizeof(RayPathRecord) == 24);
+
+struct RayPathHeader {
+  static constexpr std::array<char, 4> kMagic{'M', 'T', 'R', 'P'};
+  static constexpr std::uint32_t kVersion = 1;
+
+  std::array<char, 4> magic = kMagic;
+  std::uint32_t version = kVersion;
+  std::uint32_t n_plasma{};  ///< Радиусов плазмы следом за заголовком.
+  std::uint32_t n_quartz{};  ///< Радиусов кварца следом за радиусами плазмы.
+};
+static_assert(sizeof(RayPathHeader) == 16);
+
+class RayPathRecorder;
+
+/// Буфер одного потока. Сбрасывается в файл крупными блоками из целых
+/// подлучей: от kStart до kEnd одного вызова SolveDir.
+class RayPathBuffer {
+ public:
+  explicit RayPathBuffer(RayPathRecorder& recorder);
+  RayPathBuffer(const RayPathBuffer&) = delete;
+  RayPathBuffer(RayPathBuffer&&) = delete;
+  RayPathBuffer& operator=(const RayPathBuffer&) = delete;
+  RayPathBuffer& operator=(RayPathBuffer&&) = delete;
+  ~RayPathBuffer();
+
+  void Record(std::uint32_t ray,
+              RayPathEvent event,
+              RayPathBody body,
+              std::size_t shell,
+              Vec3 pos,
+              Float intensity);
+  void Flush();
+
+ private:
+  static constexpr std::size_t kCapacity = 16384;
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+  RayPathRecorder& recorder_;
+  std::vector<RayPathRecord> records_;
+};
+
+class RayPathRecorder {
+ public:
+  struct Config {
+    std::string path;
+    std::size_t sample = 1;
+    std::vector<std::uint32_t> rays;
+  };
+
+  /// @returns nullptr, если MT_RAY_PATH не задана.
+  [[nodiscard]] static std::unique_ptr<RayPathRecorder> FromEnv(
+      const std::vector<CylinderZInfinite>& plasma,
+      const std::vector<CylinderZInfinite>& quartz,
+      std::size_t n_threads);
+
+  RayPathRecorder(const Config& config,
+                  const std::vector<CylinderZInfinite>& plasma,
+                  const std::vector<CylinderZInfinite>& quartz,
+                  std::size_t n_threads);
+  RayPathRecorder(const RayPathRecorder&) = delete;
+  RayPathRecorder(RayPathRecorder&&) = delete;
+  RayPathRecorder& operator=(const RayPathRecorder&) = delete;
+  RayPathRecorder& operator=(RayPathRecorder&&) = delete;
+  ~RayPathRecorder() = default;
+
+  /// @returns Буфер потока @p thread, если направление @p ray выбрано.
+  [[nodiscard]] RayPathBuffer* Sample(std::uint32_t ray, std::size_t thread);
+
+ private:
+  friend class RayPathBuffer;
+  void Write(const std::vector<RayPathRecord>& records);
+
+  Config config_;
+  std::mutex mutex_;
+  std::ofstream out_;
+  std::vector<std::unique_ptr<RayPathBuffer>> buffers_;
+};
+
+struct RayPath {
+  std::vector<Float> plasma_radii;
+  std::vector<Float> quartz_radii;
+  std::vector<RayPathRecord> records;
+};
+
+/// Читает файл MT_RAY_PATH. Записи одного направления идут подряд, внутри
+/// него — подлучи (отражённые и преломлённые части), каждый от kStart до
+/// kEnd без разрывов.
+/// @throws std::runtime_error Если файл не открывается или повреждён.
+[[nodiscard]] RayPath ReadRayPath(const std::string& path);
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/energy_balance.h"
+#include "modeling/solve_monitor.h"
+#include "modeling/twin_plasma_quartz.h"
+
+/// Кеш результатов Solve на диске, адресуемый содержимым: файл
+/// <dir>/<FNV-1a ключа>.mtr хранит ключ и Result в двоичном виде.
+/// Ключ (CacheKey) — каноническая запись Params без n_threads и
+/// energy_tolerance, версия решателя, sizeof(Float), ключи сборки,
+/// меняющие физику или арифметику (MT_USE_DIFFUSE_REFLECTION,
+/// CONSTANT_TEMPERATURE, -Ofast), и отпечаток таблицы поглощения. Время
+/// этапов в кеш не попадает.
+///
+/// Размер каталога ограничен: после записи удаляются файлы, к которым
+/// дольше всего не обращались (время изменения файла обновляется при
+/// каждом попадании). Каталог можно делить между процессами.
+///
+/// Решатели берут кеш из Default(): переменные окружения
+///   MT_CACHE_DIR  — каталог; без неё кеш выключен;
+///   MT_CACHE_SIZE — предел, МиБ (по умолчанию 1024; неверное значение
+///                   заменяется им с предупреждением в std::cerr).
+/// При записи траекторий (MT_RAY_PATH) кеш не используется.
+class ResultCache {
+ public:
+  /// Меняется при любом изменении решателей или физики, меняющем
+  /// результат при тех же Params.
+  static constexpr std::uint32_t kSolverVersion = 2;
+  static constexpr std::uint64_t kDefaultMaxBytes = std::uint64_t{1} << 30;
+
+  /// @returns nullptr, если MT_CACHE_DIR не задана или после
+  /// DisableDefault().
+  [[nodiscard]] static ResultCache* Default();
+  /// Выключает Default() до конца процесса, какой бы ни была MT_CACHE_DIR:
+  /// бенчмаркам и тестам нужны настоящие расчёты.
+  static void DisableDefault() noexcept;
+
+  /// Создаёт dir, если его нет.
+  explicit ResultCache(std::filesystem::path dir,
+                       std::uint64_t max_bytes = kDefaultMaxBytes);
+
+  /// Result — CylinderPlasma::Result или CylinderPlasmaQuartz::Result
+  /// (он же TwinPlasmaQuartz::Result).
+  /// Повреждённый или чужой файл считается промахом и удаляется.
+  template <typename Result>
+  [[nodiscard]] std::optional<Result> Find(std::string_view key);
+
+  /// Ошибки записи не исключения: кеш лишь ускоряет повторные запуски.
+  /// @returns false, если записать не удалось.
+  template <typename Result>
+  bool Store(std::string_view key, const Result& result);
+
+  [[nodiscard]] std::filesystem::path PathFor(std::string_view key) const;
+
+ private:
+  /// Удаляет самые старые файлы, пока каталог больше max_bytes_.
+  void Evict();
+
+  std::filesystem::path dir_;
+  std::uint64_t max_bytes_;
+  std::mutex mutex_;
+};
+
+[[nodiscard]] std::string CacheKey(const CylinderPlasma::Params& params);
+[[nodiscard]] std::string CacheKey(const CylinderPlasmaQuartz::Params& params);
+[[nodiscard]] std::string CacheKey(const TwinPlasmaQuartz::Params& params);
+
+/// Result compute() через cache (если он не nullptr): при попадании баланс
+/// энергии лишь проверяется с params.energy_tolerance. Результат,
+/// прерванный через monitor, не сохраняется.
+template <typename Params, typename Compute>
+auto SolveCached(ResultCache* cache,
+                 const Params& params,
+                 Compute&& compute,
+                 const SolveMonitor* monitor = nullptr)
+    -> decltype(compute()) {
+  if (cache == nullptr) {
+    return compute();
+  }
+  using Result = decltype(compute());
+  const auto key = CacheKey(params);
+  if (auto r = cache->Find<Result>(key)) {
+    CheckEnergyBalance(r->balance, r->intensity_all, params.energy_tolerance);
+    return *std::move(r);
+  }
+  auto r = std::forward<Compute>(compute)();
+  if (monitor == nullptr || !monitor->stopped()) {
+    cache->Store(key, r);
+  }
+  return r;
+}
@@ -6,6 +6,7 @@
 #include "base/config/float.h"
 #include "math/linalg/vector.h"
 #include "modeling/cylinder_common.h"
+#include "modeling/ray_path.h"
 #include "modeling/worker.h"
 #include "ray_tracing/cylinder_z_infinite.h"
 
@@ -17,6 +18,10 @@ struct SolidCylinder {
     Float refractive_index;
     Float refractive_index_external;
     Float mirror{};
+    /// Внешние радиусы слоёв по возрастанию (radial_mesh.h), steps штук,
+    /// последний — radius. Пусто — steps равных слоёв; тогда заполняется
+    /// при построении.
+    std::vector<Float> radii{};
   };
 
   SolidCylinder(const Params& params,
@@ -24,7 +29,8 @@ struct SolidCylinder {
                 const IntensityFunc& intensity,
                 const AttenuationFunc& attenuation);
 
-  [[nodiscard]] WorkerResult SolveDir(const WorkerParams& params) const;
+  [[nodiscard]] WorkerResult SolveDir(const WorkerParams& params,
+                                      RayPathBuffer* path = nullptr) const;
   [[nodiscard]] Float CalculateIntensity(Vec3 initial_pos,
                                          Vec3 dir,
                                          std::size_t sphere_points) const;
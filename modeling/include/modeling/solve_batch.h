@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base/config/float.h"
+#include "math/linalg/vector.h"
+#include "modeling/energy_balance.h"
+#include "modeling/parallel_for.h"
+#include "modeling/result_cache.h"
+#include "modeling/solve_monitor.h"
+#include "modeling/thread_pool.h"
+
+/// Направления трассировки: точки сферы Фибоначчи с x > 0. Общие для всех
+/// вариантов с тем же n_meridian * n_latitude.
+using Directions = std::shared_ptr<const std::vector<Vec3>>;
+
+/// Последний построенный набор отдаётся повторно, пока число точек то же.
+[[nodiscard]] Directions MakeDirections(std::size_t sphere_points);
+
+/// Излучение плазмы по направлениям (первый проход решателя). Зависит
+/// только от EmissionKey: rho, i_crit и кварц на него не влияют.
+struct Emission {
+  std::vector<Float> is;
+  Float intensity_all{};
+  Float max_intensity{};
+  double seconds{};
+};
+
+using EmissionKeyTuple = std::tuple<Float,
+                                    std::size_t,
+                                    Float,
+                                    bool,
+                                    Float,
+                                    Float,
+                                    int,
+                                    Float,
+                                    Float,
+                                    std::size_t,
+                                    std::size_t>;
+
+template <typename Params>
+[[nodiscard]] EmissionKeyTuple EmissionKey(const Params& p) {
+  return {p.r,    p.n_plasma, p.plasma_grading, p.adaptive_plasma,
+          p.t0,   p.tw,       p.m,              p.nu,
+          p.d_nu, p.n_meridian, p.n_latitude};
+}
+
+/// Излучение последних решений в памяти процесса. Этапы решения зависят от
+/// полей Params так:
+///   направления — n_meridian * n_latitude (MakeDirections);
+///   излучение (Emit) — EmissionKey;
+///   трассировка (Transport) — от всех полей, кроме n_threads и
+///   energy_tolerance.
+/// Поэтому повторное решение, в котором изменились только rho, i_crit,
+/// eta_* или кварц, сразу начинается с трассировки. Излучение не зависит
+/// от решателя (у всех один и тот же столб плазмы), кеш у них общий.
+class EmissionCache {
+ public:
+  static constexpr std::size_t kCapacity = 8;
+
+  [[nodiscard]] static EmissionCache& Default();
+
+  /// Найденное излучение считается мгновенным: seconds = 0.
+  [[nodiscard]] std::optional<Emission> Find(const EmissionKeyTuple& key);
+  /// Вытесняет вариант, к которому дольше всего не обращались.
+  void Store(const EmissionKeyTuple& key, const Emission& emission);
+  void Clear();
+
+ private:
+  std::mutex mutex_;
+  /// Свежие — первыми.
+  std::list<std::pair<EmissionKeyTuple, Emission>> entries_;
+};
+
+/// impl.Emit(pool, monitor) через EmissionCache::Default(). При попадании
+/// этап излучения пропускается.
+template <typename Impl, typename Params>
+[[nodiscard]] Emission EmitCached(const Impl& impl,
+                                  const Params& params,
+                                  ThreadPool* pool,
+                                  SolveMonitor* monitor = nullptr) {
+  auto& cache = EmissionCache::Default();
+  const auto key = EmissionKey(params);
+  if (auto e = cache.Find(key)) {
+    return *std::move(e);
+  }
+  // Остановленное излучение не возвращается: Emit бросает SolveCancelled.
+  auto e = impl.Emit(pool, monitor);
+  cache.Store(key, e);
+  return e;
+}
+
+/// Решает варианты params по общим частям: Directions строятся один раз на
+/// число направлений, Emission — один раз на группу с одинаковым
+/// EmissionKey (или берётся из EmissionCache::Default()), затем варианты
+/// трассируются параллельно на pool. Попадания в ResultCache::Default() не
+/// считаются вовсе. Результаты в порядке params и совпадают с Solve()
+/// каждого варианта.
+///
+/// Impl(params, directions) даёт recording(), Emit(pool) и
+/// Transport(emission, pool).
+/// @throws std::runtime_error Первое исключение варианта (баланс энергии).
+template <typename Result, typename Impl, typename Params>
+std::vector<Result> SolveBatch(std::span<const Params> params,
+                               ThreadPool& pool) {
+  std::map<std::size_t, Directions> directions;
+  std::vector<std::unique_ptr<Impl>> impls;
+  impls.reserve(params.size());
+  for (const auto& p : params) {
+    auto& dirs = directions[p.n_meridian * p.n_latitude];
+    if (!dirs) {
+      dirs = MakeDirections(p.n_meridian * p.n_latitude);
+    }
+    impls.push_back(std::make_unique<Impl>(p, dirs));
+  }
+
+  std::vector<Result> results(params.size());
+  std::vector<ResultCache*> caches(params.size());
+  std::vector<std::size_t> misses;
+  for (std::size_t i = 0; i < params.size(); ++i) {
+    // Траектории записываются только при настоящем расчёте.
+    caches[i] = impls[i]->recording() ? nullptr : ResultCache::Default();
+    if (caches[i] != nullptr) {
+      if (auto r = caches[i]->Find<Result>(CacheKey(params[i]))) {
+        CheckEnergyBalance(r->balance, r->intensity_all,
+                           params[i].energy_tolerance);
+        results[i] = *std::move(r);
+        continue;
+      }
+    }
+    misses.push_back(i);
+  }
+
+  std::map<decltype(EmissionKey(params.front())), std::size_t> groups;
+  std::vector<std::size_t> leaders;
+  std::vector<std::size_t> group_of;
+  group_of.reserve(misses.size());
+  for (const auto i : misses) {
+    const auto [it, inserted] =
+        groups.try_emplace(EmissionKey(params[i]), leaders.size());
+    if (inserted) {
+      leaders.push_back(i);
+    }
+    group_of.push_back(it->second);
+  }
+
+  std::vector<Emission> emissions(leaders.size());
+  ParallelFor(
+      leaders.size(), pool.size() + 1,
+      [&](std::size_t g, std::size_t /*thread*/) {
+        const auto i = leaders[g];
+        emissions[g] = EmitCached(*impls[i], params[i], &pool);
+      },
+      &pool);
+
+  ParallelFor(
+      misses.size(), pool.size() + 1,
+      [&](std::size_t k, std::size_t /*thread*/) {
+        const auto i = misses[k];
+        results[i] = impls[i]->Transport(emissions[group_of[k]], &pool);
+        if (caches[i] != nullptr) {
+          caches[i]->Store(CacheKey(params[i]), results[i]);
+        }
+      },
+      &pool);
+  return results;
+}
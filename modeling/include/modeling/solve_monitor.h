@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+#include "base/config/float.h"
+
+enum class SolveStage : std::uint8_t {
+  kEmission,   ///< Излучение плазмы по направлениям.
+  kTransport,  ///< Трассировка направлений.
+  kDone,
+};
+
+struct SolveProgress {
+  SolveStage stage = SolveStage::kEmission;
+  std::size_t directions_done{};  ///< Направлений текущего этапа.
+  std::size_t directions_total{};
+  std::size_t queued_rays{};  ///< Лучей каскада в очередях потоков.
+};
+
+/// Решение остановлено по запросу, и результата нет.
+class SolveCancelled : public std::runtime_error {
+ public:
+  SolveCancelled() : std::runtime_error{"solve cancelled"} {}
+};
+
+/// Связь решения с наблюдателем из другого потока: ход решения и запрос
+/// остановки. Решатель проверяет stop между направлениями.
+///
+/// При остановке во время трассировки с partial решатель возвращает
+/// результат, экстраполированный по пройденным направлениям: суммы
+/// умножаются на отношение всего излучения к излучению пройденных. Без
+/// partial (и при остановке на излучении) — SolveCancelled. Неполный
+/// результат не попадает в ResultCache.
+class SolveMonitor {
+ public:
+  SolveMonitor() = default;
+  explicit SolveMonitor(std::stop_token stop, bool partial = false)
+      : stop_{std::move(stop)}, partial_{partial} {}
+
+  SolveMonitor(const SolveMonitor&) = delete;
+  SolveMonitor(SolveMonitor&&) = delete;
+  SolveMonitor& operator=(const SolveMonitor&) = delete;
+  SolveMonitor& operator=(SolveMonitor&&) = delete;
+  ~SolveMonitor() = default;
+
+  [[nodiscard]] SolveProgress progress() const noexcept {
+    return {.stage = stage_.load(std::memory_order_relaxed),
+            .directions_done = done_.load(std::memory_order_relaxed),
+            .directions_total = total_.load(std::memory_order_relaxed),
+            .queued_rays = queued_.load(std::memory_order_relaxed)};
+  }
+
+  /// Решение прервано: результат неполный или его нет.
+  [[nodiscard]] bool stopped() const noexcept { return stopped_; }
+
+  // Для решателя.
+
+  [[nodiscard]] bool stop_requested() const noexcept {
+    return stop_.stop_requested();
+  }
+  [[nodiscard]] bool partial() const noexcept { return partial_; }
+
+  void BeginStage(SolveStage stage, std::size_t total) noexcept {
+    done_.store(0, std::memory_order_relaxed);
+    total_.store(total, std::memory_order_relaxed);
+    stage_.store(stage, std::memory_order_relaxed);
+  }
+  void AddDone(std::size_t n) noexcept {
+    done_.fetch_add(n, std::memory_order_relaxed);
+  }
+  /// n — изменение длины очереди (по модулю 2^N, как у unsigned).
+  void AddQueued(std::size_t n) noexcept {
+    queued_.fetch_add(n, std::memory_order_relaxed);
+  }
+  void Finish() noexcept {
+    stage_.store(SolveStage::kDone, std::memory_order_relaxed);
+  }
+
+  /// Отмечает остановку на трассировке. emitted_done — излучение
+  /// пройденных направлений по блокам.
+  /// @returns Множитель сумм пройденных направлений до полного результата.
+  /// @throws SolveCancelled Без partial или если ничего не пройдено.
+  [[nodiscard]] Float Stop(Float intensity_all,
+                           std::span<const Float> emitted_done) {
+    stopped_ = true;
+    Float emitted{};
+    for (const auto e : emitted_done) {
+      emitted += e;
+    }
+    if (!partial_ || !(emitted > 0)) {
+      throw SolveCancelled{};
+    }
+    return intensity_all / emitted;
+  }
+
+  /// Отмечает остановку на излучении.
+  [[noreturn]] void Cancel() {
+    stopped_ = true;
+    throw SolveCancelled{};
+  }
+
+ private:
+  std::stop_token stop_;
+  bool partial_{};
+  std::atomic<SolveStage> stage_{SolveStage::kEmission};
+  std::atomic<std::size_t> done_{0};
+  std::atomic<std::size_t> total_{0};
+  std::atomic<std::size_t> queued_{0};
+  std::atomic<bool> stopped_{false};
+};
+
+/// Порядок обхода [0, n) с двоично-обратными номерами (ван дер Корпут):
+/// любой префикс покрывает весь отрезок почти равномерно. Направления
+/// сферы Фибоначчи идут по широте, поэтому по пройденным в таком порядке
+/// блокам можно экстраполировать результат.
+[[nodiscard]] inline std::vector<std::size_t> SpreadOrder(std::size_t n) {
+  std::size_t bits = 0;
+  while ((std::size_t{1} << bits) < n) {
+    ++bits;
+  }
+  std::vector<std::size_t> order;
+  order.reserve(n);
+  for (std::size_t i = 0; order.size() < n; ++i) {
+    std::size_t reversed = 0;
+    for (std::size_t b = 0; b < bits; ++b) {
+      reversed |= ((i >> b) & 1) << (bits - 1 - b);
+    }
+    if (reversed < n) {
+      order.push_back(reversed);
+    }
+  }
+  return order;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+/// Время этапов Solve, с.
+struct SolveTimings {
+  double emission{};   ///< Испускаемая интенсивность по направлениям.
+  double transport{};  ///< Трассировка лучей.
+  double post{};       ///< Последовательная постобработка результата.
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Пул потоков с общей очередью задач.
+///
+/// Задачи не должны ждать друг друга через пул: ParallelFor с пулом
+/// выполняет работу и в вызывающем потоке, поэтому вложенные вызовы
+/// (задания на пуле, внутри которых Solve на том же пуле) не блокируются.
+class ThreadPool {
+ public:
+  explicit ThreadPool(std::size_t n_threads);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+  /// Выполняет оставшиеся задачи и дожидается потоков.
+  ~ThreadPool();
+
+  [[nodiscard]] std::size_t size() const noexcept { return threads_.size(); }
+
+  void Submit(std::function<void()> task);
+
+ private:
+  void Work();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stop_{false};
+  std::vector<std::jthread> threads_;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+
+#include "base/config/float.h"
+#include "base/fast_pimpl.h"
+
+#include "modeling/cylinder_plasma_quartz.h"
+#include "physics/params/air.h"
+#include "physics/params/plasma.h"
+#include "physics/params/quartz.h"
+
+class SolveMonitor;
+class ThreadPool;
+
+/// Два одинаковых столба плазмы в кварцевой трубке эллиптического сечения.
+/// Столбы радиуса r стоят на большой оси трубки симметрично относительно
+/// её центра, между их поверхностями — gap; между столбами и трубкой — газ.
+struct TwinPlasmaQuartz {
+  struct Params {
+    Float r = 0.35_F;
+    std::size_t n_plasma = 40;
+    Float gap = 0.1_F;  ///< Зазор между поверхностями столбов.
+    /// Ширина слоя плазмы у стенки относительно центрального слоя
+    /// (radial_mesh.h): < 1 сгущает слои к стенке, 1 — равные слои.
+    Float plasma_grading = 1;
+    /// Слои плазмы по профилю температуры и поглощения (PlasmaRadii в
+    /// radial_mesh.h) вместо plasma_grading.
+    bool adaptive_plasma = false;
+
+    Float a = 0.9_F;  ///< Полуоси внутренней поверхности трубки.
+    Float b = 0.6_F;
+    Float delta = 0.1_F;  ///< Толщина стенки.
+    std::size_t n_quartz = 15;
+
+    Float t0 = 10000.0_F;
+    Float tw = 2000.0_F;
+    int m = 4;
+    Float t1 = 700.0_F;
+
+    Float eta_plasma = params::plasma::kEta;
+    Float eta_quartz = params::quartz::kEta;
+    Float eta_gas = params::air::kEta;
+    Float rho = 0.95_F;
+
+    Float nu = 1e+15_F;
+    Float d_nu = 1e+15_F;
+
+    std::size_t n_meridian = 100;
+    std::size_t n_latitude = 100;
+
+    std::size_t n_threads = 4;  ///< Потоков трассировки, 0 — как 1.
+    Float i_crit = 0.000001_F;
+
+    /// Допустимая относительная невязка энергетического баланса.
+    /// 0 — не проверять.
+    Float energy_tolerance = 0;
+  };
+
+  /// @throws std::invalid_argument Столбы пересекаются или не помещаются
+  /// в трубку.
+  TwinPlasmaQuartz(const Params& params);
+  ~TwinPlasmaQuartz();
+
+  /// Как у CylinderPlasmaQuartz, по обоим столбам: absorbed_plasma — сумма
+  /// слоёв двух столбов, absorbed_quartz — целые эллиптические кольца,
+  /// intensity_all — излучение обоих столбов. absorbed_plasma3 — на один
+  /// столб.
+  using Result = CylinderPlasmaQuartz::Result;
+
+  /// Результат берётся из ResultCache::Default(), если кеш включён.
+  Result Solve();
+  /// Трассировка на потоках общего пула, не более n_threads сразу.
+  Result Solve(ThreadPool& pool);
+  /// С ходом решения и остановкой через monitor (solve_monitor.h).
+  /// @throws SolveCancelled
+  Result Solve(SolveMonitor& monitor);
+  Result Solve(SolveMonitor& monitor, ThreadPool& pool);
+
+ private:
+  class Impl;
+  static constexpr std::size_t kSize = sizeof(Float) == 8 ? 776 : 616;
+  static constexpr std::size_t kAlignment = 8;
+  FastPimpl<Impl, kSize, kAlignment> pimpl_;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "base/config/float.h"
@@ -11,10 +12,16 @@ struct WorkerParams {
   Float intensity{};
   Float intensity_end{};
   bool use_prev{false};
+  std::uint32_t ray{};  ///< Номер исходного направления.
 };
 
 struct WorkerResult {
   std::vector<WorkerParams> released_rays;
   std::vector<Float> absorbed;
   Float absorbed_at_the_border{};
+
+  /// Доли absorbed и absorbed_at_the_border, списанные по intensity_end.
+  Float truncated{};
+  Float truncated_inner{};  ///< Из truncated: попавшее в absorbed.front().
+  Float truncated_at_the_border{};
 };
@@ -1,65 +1,38 @@
 #include "modeling/cylinder_plasma.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <span>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
-#include "base/erase_remove_if.h"
-#include "math/consts/pi.h"
 #include "math/fast_pow.h"
 #include "math/linalg/vector.h"
-#include "modeling/fibonacci_sphere.h"
+#include "modeling/energy_balance.h"
+#include "modeling/parallel_for.h"
+#include "modeling/radial_mesh.h"
+#include "modeling/ray_path.h"
+#include "modeling/result_cache.h"
 #include "modeling/solid_cylinder.h"
+#include "modeling/solve_batch.h"
+#include "modeling/solve_monitor.h"
+#include "modeling/thread_pool.h"
 #include "modeling/worker.h"
 #include "physics/params/air.h"
 #include "physics/params/plasma.h"
 #include "physics/plancks_law.h"
 
-// #define ENABLE_DEBUG_OUTPUT
-// #define ENABLE_GEOGEBRA_OUTPUT
-// #define ENABLE_GEOGEBRA_OUTPUT_2D
-// #define ENABLE_GEOGEBRA_OUTPUT_SPHERE
-
-#ifdef ENABLE_DEBUG_OUTPUT
-#include "math/linalg/vector_io.h"
-#endif
-
 namespace {
 
-struct DummyOut {};
-[[maybe_unused]] DummyOut gDummyOut;  // NOLINT
-
-template <typename T>
-DummyOut& operator<<(DummyOut& dummy_out, T&&) noexcept {  // NOLINT
-  return dummy_out;
-}
-
-#ifdef ENABLE_DEBUG_OUTPUT
-#include <iostream>
-#define DEBUG_OUT std::cout
-#else
-#define DEBUG_OUT gDummyOut
-#endif
-
-#ifdef ENABLE_GEOGEBRA_OUTPUT
-#include <iostream>
-#define GEOGEBRA_OUT std::cout
-#else
-#define GEOGEBRA_OUT gDummyOut
-#endif
-
-#ifdef ENABLE_GEOGEBRA_OUTPUT_2D
-#include <iostream>
-#define GEOGEBRA_OUT_2D std::cout
-#else
-#define GEOGEBRA_OUT_2D gDummyOut
-#endif
-
 // TODO(a.kerimov): Выяснить, что происходит при 400000+ и CONSTANT_TEMPERATURE
 
-// TODO(a.kerimov): Написать тесты.
 
 constexpr auto kOrigin = Vec3{};
 
@@ -68,6 +41,9 @@ constexpr auto kOrigin = Vec3{};
 class CylinderPlasma::Impl {
  public:
   explicit Impl(const Params& params)
+      : Impl{params, MakeDirections(params.n_meridian * params.n_latitude)} {}
+
+  Impl(const Params& params, Directions dirs)
       : params_{params},
         sphere_points_{params_.n_meridian * params_.n_latitude},
         plasma_{
@@ -76,7 +52,8 @@ class CylinderPlasma::Impl {
              .steps = params.n_plasma,
              .refractive_index = params::plasma::kEta,
              .refractive_index_external = params::air::kEta,
-             .mirror = params.rho},
+             .mirror = params.rho,
+             .radii = PlasmaRadii(params)},
             [this](Float z) {
               assert(0 <= z && z <= 1);
               return params_.t0 +
@@ -85,84 +62,230 @@ class CylinderPlasma::Impl {
             [this](Float t) { return func::I(params_.nu, params_.d_nu, t); },
             [this](Float t) {
               return params::plasma::AbsorptionCoefficient(params_.nu, t);
-            }} {
-    InitDirs();
+            }},
+        recorder_{RayPathRecorder::FromEnv(plasma_.cylinders, {},
+                                           params_.n_threads)},
+        dirs_{std::move(dirs)} {}
+
+  Result Solve(ThreadPool* pool, SolveMonitor* monitor = nullptr) {
+    // Траектории записываются только при настоящем расчёте.
+    auto* cache = recorder_ ? nullptr : ResultCache::Default();
+    auto r = SolveCached(
+        cache, params_,
+        [&] {
+          return Transport(EmitCached(*this, params_, pool, monitor), pool,
+                           monitor);
+        },
+        monitor);
+    if (monitor != nullptr) {
+      monitor->Finish();
+    }
+    return r;
   }
 
-  Result Solve() {
+  [[nodiscard]] bool recording() const { return recorder_ != nullptr; }
+
+  /// Первый проход: излучение плазмы по направлениям.
+  [[nodiscard]] Emission Emit(ThreadPool* pool,
+                              SolveMonitor* monitor = nullptr) const {
+    const auto start = Clock::now();
+    Emission e{.is = std::vector<Float>(dirs_->size())};
+    const auto order = ChunkOrder(monitor);
+    std::atomic<bool> stopped{false};
+    if (monitor != nullptr) {
+      monitor->BeginStage(SolveStage::kEmission, dirs_->size());
+    }
+    ParallelFor(
+        NChunks(), params_.n_threads,
+        [&](std::size_t task, std::size_t /*thread*/) {
+          const auto chunk = order.empty() ? task : order[task];
+          for (auto j = ChunkBegin(chunk); j < ChunkEnd(chunk); ++j) {
+            if (monitor != nullptr) {
+              if (monitor->stop_requested()) {
+                stopped = true;
+                return;
+              }
+            }
+            e.is[j] = plasma_.CalculateIntensity(InitialPos(), (*dirs_)[j],
+                                                 sphere_points_);
+            if (monitor != nullptr) {
+              monitor->AddDone(1);
+            }
+          }
+        },
+        pool);
+    if (stopped) {
+      monitor->Cancel();
+    }
+
+    for (const auto i : e.is) {
+      e.intensity_all += i;
+      e.max_intensity = std::max(i, e.max_intensity);
+    }
+    e.seconds = Seconds(Clock::now() - start);
+    return e;
+  }
+
+  /// Трассировка и итоги по излучению e (Emit этого или равного по
+  /// EmissionKey варианта).
+  [[nodiscard]] Result Transport(const Emission& e,
+                                 ThreadPool* pool,
+                                 SolveMonitor* monitor = nullptr) const {
     Result r{
         .absorbed_plasma = std::vector<Float>(params_.n_plasma),
         .absorbed_plasma3 = std::vector<Float>(params_.n_plasma),
+        .intensity_all = e.intensity_all,
     };
 
-    const auto initial_pos = Vec3{params_.r, 0, 0};
-
-    std::vector<Float> is;
-    is.reserve(dirs_.size());
-    Float max_intensity{};
-    for (const auto dir : dirs_) {
-      const auto i =
-          plasma_.CalculateIntensity(initial_pos, dir, sphere_points_);
-      is.push_back(i);
-      r.intensity_all += i;
-      max_intensity = std::max(i, max_intensity);
+    const auto initial_pos = InitialPos();
+    const auto n_chunks = NChunks();
+    const auto& is = e.is;
+    const auto max_intensity = e.max_intensity;
+    const auto emitted = Clock::now();
+
+    // Частичные суммы по блокам складываются в порядке блоков, поэтому
+    // результат не зависит от числа потоков и порядка обхода блоков.
+    std::vector<Result> partials(n_chunks);
+    const auto order = ChunkOrder(monitor);
+    std::vector<Float> emitted_done(monitor != nullptr ? n_chunks : 0);
+    std::atomic<bool> stopped{false};
+    if (monitor != nullptr) {
+      monitor->BeginStage(SolveStage::kTransport, dirs_->size());
     }
-
-    std::size_t jj = 0;
-    for (const auto not_reflected_dir : dirs_) {
-      // Reflect the mirror.
-      auto dir = not_reflected_dir;
-      dir.x() = -dir.x();
-
-      const auto intensity_before_reflection = is[jj];
-      const auto intensity_after_reflection =
-          params_.rho * intensity_before_reflection;
-      r.absorbed_mirror +=
-          intensity_before_reflection - intensity_after_reflection;
-
-      auto res = plasma_.SolveDir({initial_pos, dir, intensity_after_reflection,
-                                   params_.i_crit * max_intensity});
-      r.absorbed_mirror += res.absorbed_at_the_border;
-
-      static_assert(std::is_trivially_copyable_v<WorkerParams>);
-      for (auto released : res.released_rays) {
-        assert(!released.use_prev);
-        r.absorbed_mirror += released.intensity;
+    ParallelFor(
+        n_chunks, params_.n_threads,
+        [&](std::size_t task, std::size_t thread) {
+          const auto chunk = order.empty() ? task : order[task];
+          auto& partial = partials[chunk];
+          partial.absorbed_plasma.resize(params_.n_plasma);
+          for (auto j = ChunkBegin(chunk); j < ChunkEnd(chunk); ++j) {
+            if (monitor != nullptr) {
+              if (monitor->stop_requested()) {
+                stopped = true;
+                return;
+              }
+              emitted_done[chunk] += is[j];
+            }
+            SolveRay(initial_pos, j, is[j], params_.i_crit * max_intensity,
+                     thread, partial);
+            if (monitor != nullptr) {
+              monitor->AddDone(1);
+            }
+          }
+        },
+        pool);
+    for (const auto& partial : partials) {
+      for (std::size_t i = 0; i < params_.n_plasma; ++i) {
+        r.absorbed_plasma[i] += partial.absorbed_plasma[i];
       }
-
-      assert(r.absorbed_plasma.size() == res.absorbed.size());
-      DEBUG_OUT << "ABSORBED:\n";
-      for (size_t i = 0; i < res.absorbed.size(); ++i) {
-        r.absorbed_plasma[i] += res.absorbed[i];
-        DEBUG_OUT << res.absorbed[i] << '\n';
+      r.absorbed_mirror += partial.absorbed_mirror;
+      r.balance.truncated_plasma += partial.balance.truncated_plasma;
+      r.balance.truncated_mirror += partial.balance.truncated_mirror;
+    }
+    if (stopped) {
+      const auto scale = monitor->Stop(r.intensity_all, emitted_done);
+      for (auto& ap : r.absorbed_plasma) {
+        ap *= scale;
       }
-
-      ++jj;
+      r.absorbed_mirror *= scale;
+      r.balance.truncated_plasma *= scale;
+      r.balance.truncated_mirror *= scale;
     }
+    const auto transported = Clock::now();
 
-    const auto step = params_.r / static_cast<Float>(params_.n_plasma);
-    for (std::size_t i = 0; i < params_.n_plasma; ++i) {
-      const auto r_avg = step * (static_cast<Float>(i) + 0.5_F);
-      r.absorbed_plasma3[i] = 2 * consts::kPi * r.absorbed_plasma[i] / r_avg;
-    }
+    r.balance.absorbed_plasma = std::accumulate(
+        r.absorbed_plasma.begin(), r.absorbed_plasma.end(), kZero);
+    r.balance.absorbed_mirror = r.absorbed_mirror;
+    CheckEnergyBalance(r.balance, r.intensity_all, params_.energy_tolerance);
+
+    r.absorbed_plasma3 =
+        ShellDensities(r.absorbed_plasma, kZero, plasma_.params().radii);
 
+    r.timings = {
+        .emission = e.seconds,
+        .transport = Seconds(transported - emitted),
+        .post = Seconds(Clock::now() - transported),
+    };
     return r;
   }
 
  private:
-  void InitDirs() {
-    dirs_ = FibonacciSphere(sphere_points_);
-    EraseRemoveIf(dirs_, [](Vec3 dir) { return dir.x() <= 0; });
-    for (const auto dir : dirs_) {
-      DEBUG_OUT << dir << '\n';
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::size_t kChunkSize = 64;
+
+  [[nodiscard]] static double Seconds(Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+  }
+
+  [[nodiscard]] static std::size_t ChunkBegin(std::size_t chunk) {
+    return chunk * kChunkSize;
+  }
+
+  [[nodiscard]] std::size_t ChunkEnd(std::size_t chunk) const {
+    return std::min(ChunkBegin(chunk) + kChunkSize, dirs_->size());
+  }
+
+  [[nodiscard]] std::size_t NChunks() const {
+    return (dirs_->size() + kChunkSize - 1) / kChunkSize;
+  }
+
+  /// С наблюдателем блоки обходятся вразброс (SpreadOrder), чтобы
+  /// пройденные до остановки покрывали всю сферу; пусто — по порядку.
+  [[nodiscard]] std::vector<std::size_t> ChunkOrder(
+      const SolveMonitor* monitor) const {
+    return monitor != nullptr ? SpreadOrder(NChunks())
+                              : std::vector<std::size_t>{};
+  }
+
+  [[nodiscard]] Vec3 InitialPos() const { return {params_.r, 0, 0}; }
+
+  void SolveRay(Vec3 initial_pos,
+                std::size_t jj,
+                Float intensity_before_reflection,
+                Float intensity_end,
+                std::size_t thread,
+                Result& r) const {
+    // Reflect the mirror.
+    auto dir = (*dirs_)[jj];
+    dir.x() = -dir.x();
+
+    const auto intensity_after_reflection =
+        params_.rho * intensity_before_reflection;
+    r.absorbed_mirror +=
+        intensity_before_reflection - intensity_after_reflection;
+
+    const auto ray = static_cast<std::uint32_t>(jj);
+    auto res = plasma_.SolveDir({initial_pos, dir, intensity_after_reflection,
+                                 intensity_end, false, ray},
+                                PathFor(ray, thread));
+    r.absorbed_mirror += res.absorbed_at_the_border;
+    r.balance.truncated_mirror += res.truncated_at_the_border;
+    r.balance.truncated_plasma += res.truncated;
+
+    static_assert(std::is_trivially_copyable_v<WorkerParams>);
+    for (auto released : res.released_rays) {
+      assert(!released.use_prev);
+      r.absorbed_mirror += released.intensity;
     }
+
+    assert(r.absorbed_plasma.size() == res.absorbed.size());
+    for (size_t i = 0; i < res.absorbed.size(); ++i) {
+      r.absorbed_plasma[i] += res.absorbed[i];
+    }
+  }
+
+  [[nodiscard]] RayPathBuffer* PathFor(std::uint32_t ray,
+                                       std::size_t thread) const {
+    return recorder_ ? recorder_->Sample(ray, thread) : nullptr;
   }
 
   CylinderPlasma::Params params_;
   std::size_t sphere_points_;
 
   SolidCylinder plasma_;
-  std::vector<Vec3> dirs_;
+  std::unique_ptr<RayPathRecorder> recorder_;
+  Directions dirs_;
 };
 
 CylinderPlasma::CylinderPlasma(const Params& params) : pimpl_{params} {}
@@ -170,5 +293,33 @@ CylinderPlasma::CylinderPlasma(const Params& params) : pimpl_{params} {}
 CylinderPlasma::~CylinderPlasma() = default;
 
 auto CylinderPlasma::Solve() -> Result {
-  return pimpl_->Solve();
+  return pimpl_->Solve(nullptr);
+}
+
+auto CylinderPlasma::Solve(ThreadPool& pool) -> Result {
+  return pimpl_->Solve(&pool);
+}
+
+auto CylinderPlasma::Solve(SolveMonitor& monitor) -> Result {
+  return pimpl_->Solve(nullptr, &monitor);
+}
+
+auto CylinderPlasma::Solve(SolveMonitor& monitor, ThreadPool& pool)
+    -> Result {
+  return pimpl_->Solve(&pool, &monitor);
+}
+
+auto CylinderPlasma::SolveBatch(std::span<const Params> params)
+    -> std::vector<Result> {
+  std::size_t n_threads = 1;
+  for (const auto& p : params) {
+    n_threads = std::max(n_threads, p.n_threads);
+  }
+  ThreadPool pool{n_threads - 1};
+  return SolveBatch(params, pool);
+}
+
+auto CylinderPlasma::SolveBatch(std::span<const Params> params,
+                                ThreadPool& pool) -> std::vector<Result> {
+  return ::SolveBatch<Result, Impl>(params, pool);
 }
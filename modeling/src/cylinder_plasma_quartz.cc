@@ -1,76 +1,58 @@
 #include "modeling/cylinder_plasma_quartz.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <numeric>
+#include <span>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
-#include "base/erase_remove_if.h"
-#include "math/consts/pi.h"
 #include "math/fast_pow.h"
 #include "math/linalg/vector.h"
-#include "modeling/fibonacci_sphere.h"
+#include "modeling/energy_balance.h"
+#include "modeling/parallel_for.h"
 #include "modeling/hollow_cylinder.h"
+#include "modeling/radial_mesh.h"
+#include "modeling/ray_path.h"
+#include "modeling/result_cache.h"
 #include "modeling/solid_cylinder.h"
+#include "modeling/solve_batch.h"
+#include "modeling/solve_monitor.h"
+#include "modeling/thread_pool.h"
 #include "modeling/worker.h"
 #include "physics/params/air.h"
 #include "physics/params/plasma.h"
 #include "physics/params/quartz.h"
 #include "physics/plancks_law.h"
 
-// #define ENABLE_DEBUG_OUTPUT
-// #define ENABLE_GEOGEBRA_OUTPUT
-// #define ENABLE_GEOGEBRA_OUTPUT_2D
-// #define ENABLE_GEOGEBRA_OUTPUT_SPHERE
-
-#ifdef ENABLE_DEBUG_OUTPUT
-#include "math/linalg/vector_io.h"
-#endif
-
 namespace {
 
-struct DummyOut {};
-[[maybe_unused]] DummyOut gDummyOut;  // NOLINT
-
-template <typename T>
-DummyOut& operator<<(DummyOut& dummy_out, T&&) noexcept {  // NOLINT
-  return dummy_out;
-}
-
-#ifdef ENABLE_DEBUG_OUTPUT
-#include <iostream>
-#define DEBUG_OUT std::cout
-#else
-#define DEBUG_OUT gDummyOut
-#endif
-
-#ifdef ENABLE_GEOGEBRA_OUTPUT
-#include <iostream>
-#define GEOGEBRA_OUT std::cout
-#else
-#define GEOGEBRA_OUT gDummyOut
-#endif
-
-#ifdef ENABLE_GEOGEBRA_OUTPUT_2D
-#include <iostream>
-#define GEOGEBRA_OUT_2D std::cout
-#else
-#define GEOGEBRA_OUT_2D gDummyOut
-#endif
-
 // TODO(a.kerimov): Выяснить, что происходит при 400000+ и CONSTANT_TEMPERATURE
-// TODO(a.kerimov): Написать тесты.
 
 constexpr auto kOrigin = Vec3{};
 
+/// Усечённое в кварце: absorbed.front() затем переносится в плазму.
+void AddTruncatedQuartz(EnergyBalance& balance, const WorkerResult& res) {
+  balance.truncated_mirror += res.truncated_at_the_border;
+  balance.truncated_quartz += res.truncated - res.truncated_inner;
+  balance.truncated_plasma += res.truncated_inner;
+}
+
 }  // namespace
 
 class CylinderPlasmaQuartz::Impl {
  public:
   Impl(const Params& params)
+      : Impl{params, MakeDirections(params.n_meridian * params.n_latitude)} {}
+
+  Impl(const Params& params, Directions dirs)
       : params_{params},
         b_{params.r / params.delta * std::log(params.tw / params.t1)},
         a_{params.tw * std::exp(b_)},
@@ -81,7 +63,8 @@ class CylinderPlasmaQuartz::Impl {
              .steps = params.n_plasma,
              .refractive_index = params.eta_plasma,
              .refractive_index_external = params.eta_quartz,
-             .mirror = kZero},
+             .mirror = kZero,
+             .radii = PlasmaRadii(params)},
             [this](Float z) {
               assert(0 <= z && z <= 1);
               return params_.t0 +
@@ -100,7 +83,9 @@ class CylinderPlasmaQuartz::Impl {
              .refractive_index_internal = params.eta_plasma,
              .refractive_index_external = params::air::kEta,
              .mirror_internal = kZero,
-             .mirror_external = params.rho},
+             .mirror_external = params.rho,
+             .radii = GradedRadii(params.r, params.r + params.delta,
+                                  params.n_quartz, 1 / params.quartz_grading)},
             [this](Float z) {
               if (z <= 1) {
                 return params_.tw;
@@ -111,112 +96,160 @@ class CylinderPlasmaQuartz::Impl {
             [this](Float t) { return func::I(params_.nu, params_.d_nu, t); },
             [this](Float t) {
               return params::quartz::AbsorptionCoefficient(params_.nu, t);
-            }} {
-    InitDirs();
+            }},
+        recorder_{RayPathRecorder::FromEnv(plasma_.cylinders, quartz_.cylinders,
+                                           params_.n_threads)},
+        dirs_{std::move(dirs)} {}
+
+  Result Solve(ThreadPool* pool, SolveMonitor* monitor = nullptr) {
+    // Траектории записываются только при настоящем расчёте.
+    auto* cache = recorder_ ? nullptr : ResultCache::Default();
+    auto r = SolveCached(
+        cache, params_,
+        [&] {
+          return Transport(EmitCached(*this, params_, pool, monitor), pool,
+                           monitor);
+        },
+        monitor);
+    if (monitor != nullptr) {
+      monitor->Finish();
+    }
+    return r;
+  }
+
+  [[nodiscard]] bool recording() const { return recorder_ != nullptr; }
+
+  /// Первый проход: излучение плазмы по направлениям.
+  [[nodiscard]] Emission Emit(ThreadPool* pool,
+                              SolveMonitor* monitor = nullptr) const {
+    const auto start = Clock::now();
+    Emission e{.is = std::vector<Float>(dirs_->size())};
+    const auto order = ChunkOrder(monitor);
+    std::atomic<bool> stopped{false};
+    if (monitor != nullptr) {
+      monitor->BeginStage(SolveStage::kEmission, dirs_->size());
+    }
+    ParallelFor(
+        NChunks(), params_.n_threads,
+        [&](std::size_t task, std::size_t /*thread*/) {
+          const auto chunk = order.empty() ? task : order[task];
+          for (auto j = ChunkBegin(chunk); j < ChunkEnd(chunk); ++j) {
+            if (monitor != nullptr && monitor->stop_requested()) {
+              stopped = true;
+              return;
+            }
+            e.is[j] = plasma_.CalculateIntensity(InitialPos(), (*dirs_)[j],
+                                                 sphere_points_);
+            if (monitor != nullptr) {
+              monitor->AddDone(1);
+            }
+          }
+        },
+        pool);
+    if (stopped) {
+      monitor->Cancel();
+    }
+
+    for (const auto i : e.is) {
+      e.intensity_all += i;
+      e.max_intensity = std::max(i, e.max_intensity);
+    }
+    e.seconds = Seconds(Clock::now() - start);
+    return e;
   }
 
-  Result Solve() {
+  /// Трассировка и итоги по излучению e (Emit этого или равного по
+  /// EmissionKey варианта).
+  [[nodiscard]] Result Transport(const Emission& e,
+                                 ThreadPool* pool,
+                                 SolveMonitor* monitor = nullptr) const {
     Result r{
         .absorbed_plasma = std::vector<Float>(params_.n_plasma),
         .absorbed_plasma3 = std::vector<Float>(params_.n_plasma),
         .absorbed_quartz = std::vector<Float>(params_.n_quartz + 1),
         .absorbed_quartz3 = std::vector<Float>(params_.n_quartz + 1),
+        .intensity_all = e.intensity_all,
     };
-    std::vector<WorkerParams> wait_plasma;
-    std::vector<WorkerParams> wait_quartz;
 
-    const auto initial_pos = Vec3{params_.r, 0, 0};
-
-    std::vector<Float> is;
-    is.reserve(dirs_.size());
-    Float max_intensity{};
-    for (const auto dir : dirs_) {
-      const auto i =
-          plasma_.CalculateIntensity(initial_pos, dir, sphere_points_);
-      is.push_back(i);
-      r.intensity_all += i;
-      max_intensity = std::max(i, max_intensity);
+    const auto initial_pos = InitialPos();
+    const auto n_chunks = NChunks();
+    const auto& is = e.is;
+    const auto max_intensity = e.max_intensity;
+    const auto emitted = Clock::now();
+
+    // Каскады разных направлений независимы. Частичные суммы по блокам
+    // складываются в порядке блоков, поэтому результат не зависит от числа
+    // потоков и порядка обхода блоков.
+    std::vector<Result> partials(n_chunks);
+    const auto order = ChunkOrder(monitor);
+    std::vector<Float> emitted_done(monitor != nullptr ? n_chunks : 0);
+    std::atomic<bool> stopped{false};
+    if (monitor != nullptr) {
+      monitor->BeginStage(SolveStage::kTransport, dirs_->size());
     }
-
-    std::size_t jj = 0;
-    for (const auto dir : dirs_) {
-      auto res = quartz_.SolveDir(
-          {initial_pos, dir, is[jj], params_.i_crit * max_intensity});
-      r.absorbed_mirror += res.absorbed_at_the_border;
-      static_assert(std::is_trivially_copyable_v<WorkerParams>);
-      for (auto released : res.released_rays) {
-        if (!released.use_prev) {
-          r.absorbed_mirror += released.intensity;
-        } else {
-          wait_plasma.push_back(released);
-        }
+    ParallelFor(
+        n_chunks, params_.n_threads,
+        [&](std::size_t task, std::size_t thread) {
+          const auto chunk = order.empty() ? task : order[task];
+          auto& partial = partials[chunk];
+          partial.absorbed_plasma.resize(params_.n_plasma);
+          partial.absorbed_quartz.resize(params_.n_quartz + 1);
+          for (auto j = ChunkBegin(chunk); j < ChunkEnd(chunk); ++j) {
+            if (monitor != nullptr) {
+              if (monitor->stop_requested()) {
+                stopped = true;
+                return;
+              }
+              emitted_done[chunk] += is[j];
+            }
+            SolveRay(initial_pos, j, is[j], params_.i_crit * max_intensity,
+                     thread, partial, monitor);
+            if (monitor != nullptr) {
+              monitor->AddDone(1);
+            }
+          }
+        },
+        pool);
+    for (const auto& partial : partials) {
+      for (std::size_t i = 0; i < params_.n_plasma; ++i) {
+        r.absorbed_plasma[i] += partial.absorbed_plasma[i];
       }
-
-      assert(r.absorbed_quartz.size() == res.absorbed.size());
-      DEBUG_OUT << "ABSORBED:\n";
-      for (size_t i = 0; i < res.absorbed.size(); ++i) {
-        r.absorbed_quartz[i] += res.absorbed[i];
-        DEBUG_OUT << res.absorbed[i] << '\n';
+      for (std::size_t i = 0; i <= params_.n_quartz; ++i) {
+        r.absorbed_quartz[i] += partial.absorbed_quartz[i];
       }
-
-      ++jj;
+      r.absorbed_mirror += partial.absorbed_mirror;
+      r.balance.truncated_plasma += partial.balance.truncated_plasma;
+      r.balance.truncated_quartz += partial.balance.truncated_quartz;
+      r.balance.truncated_mirror += partial.balance.truncated_mirror;
     }
-
-    DEBUG_OUT << "[[wait]]\n";
-    // NOLINTNEXTLINE(modernize-loop-convert)
-    while (!wait_plasma.empty() || !wait_quartz.empty()) {
-      while (!wait_plasma.empty()) {
-        auto last = wait_plasma.back();
-        wait_plasma.pop_back();
-
-        auto res = plasma_.SolveDir(last);
-        r.absorbed_quartz[1] += res.absorbed_at_the_border;
-        for (auto released : res.released_rays) {
-          assert(!released.use_prev);
-          wait_quartz.push_back(released);
-        }
-
-        assert(r.absorbed_plasma.size() == res.absorbed.size());
-        DEBUG_OUT << "ABSORBED:\n";
-        for (size_t j = 0; j < res.absorbed.size(); ++j) {
-          r.absorbed_plasma[j] += res.absorbed[j];
-          DEBUG_OUT << res.absorbed[j] << '\n';
-        }
+    if (stopped) {
+      const auto scale = monitor->Stop(r.intensity_all, emitted_done);
+      for (auto& ap : r.absorbed_plasma) {
+        ap *= scale;
       }
-
-      while (!wait_quartz.empty()) {
-        auto last = wait_quartz.back();
-        wait_quartz.pop_back();
-
-        auto res = quartz_.SolveDir(last);
-        r.absorbed_mirror += res.absorbed_at_the_border;
-        for (auto released : res.released_rays) {
-          if (!released.use_prev) {
-            r.absorbed_mirror += released.intensity;
-          } else {
-            wait_plasma.push_back(released);
-          }
-        }
-
-        assert(r.absorbed_quartz.size() == res.absorbed.size());
-        DEBUG_OUT << "ABSORBED:\n";
-        for (size_t i = 0; i < res.absorbed.size(); ++i) {
-          r.absorbed_quartz[i] += res.absorbed[i];
-          DEBUG_OUT << res.absorbed[i] << '\n';
-        }
+      for (auto& aq : r.absorbed_quartz) {
+        aq *= scale;
       }
+      r.absorbed_mirror *= scale;
+      r.balance.truncated_plasma *= scale;
+      r.balance.truncated_quartz *= scale;
+      r.balance.truncated_mirror *= scale;
     }
+    const auto transported = Clock::now();
 
-    // !!!!!!!!!!!!!!
     r.absorbed_plasma.back() += r.absorbed_quartz.front();
     r.absorbed_quartz.front() = 0;
 
-    if (params_.n_quartz > 2) {
+    // Поправка слоёв у границ линейной экстраполяцией по номеру слоя: на
+    // равной сетке пограничный слой не разрешён. Неравной сетке (*_grading)
+    // она не нужна и по номеру слоя неверна.
+    // !!!!!!!!!!!!!!
+    if (params_.n_quartz > 2 && IsUniformGrading(params_.quartz_grading)) {
       const auto quartz_first =
           r.absorbed_quartz[2] +
           std::abs(r.absorbed_quartz[2] - r.absorbed_quartz[3]);
       auto d_quartz_linear = r.absorbed_quartz[1] - quartz_first;
-      if (d_quartz_linear > 0) {
+      if (d_quartz_linear > 0 && quartz_first > 0) {
         r.absorbed_quartz[1] = quartz_first;
 
         const auto quartz_sum = std::accumulate(r.absorbed_quartz.begin() + 1,
@@ -238,81 +271,162 @@ class CylinderPlasmaQuartz::Impl {
       }
     }
 
-    auto plasma_last = 2 * r.absorbed_plasma[params_.n_plasma - 2] -
-                             r.absorbed_plasma[params_.n_plasma - 3];
-    if (plasma_last < 0) {
-      plasma_last = r.absorbed_plasma[params_.n_plasma - 2] * 0.95;
-    }
-    const auto d_plasma_linear = r.absorbed_plasma.back() - plasma_last;
-    if (d_plasma_linear > 0) {
-      r.absorbed_plasma.back() = plasma_last;
+    if (!params_.adaptive_plasma &&
+        IsUniformGrading(params_.plasma_grading)) {
+      auto plasma_last = 2 * r.absorbed_plasma[params_.n_plasma - 2] -
+                         r.absorbed_plasma[params_.n_plasma - 3];
+      if (plasma_last < 0) {
+        plasma_last = r.absorbed_plasma[params_.n_plasma - 2] * 0.95_F;
+      }
+      const auto d_plasma_linear = r.absorbed_plasma.back() - plasma_last;
+      // Без поглощения во внутренних слоях перераспределять нечего.
+      if (d_plasma_linear > 0 && plasma_last > 0) {
+        r.absorbed_plasma.back() = plasma_last;
 
-      const auto plasma_sum = std::accumulate(r.absorbed_plasma.begin(),
-                                              r.absorbed_plasma.end(), kZero);
-      const auto d_plasma = d_plasma_linear / plasma_sum + 1;
+        const auto plasma_sum = std::accumulate(
+            r.absorbed_plasma.begin(), r.absorbed_plasma.end(), kZero);
+        const auto d_plasma = d_plasma_linear / plasma_sum + 1;
 
-      for (auto& ap : r.absorbed_plasma) {
-        ap *= d_plasma;
+        for (auto& ap : r.absorbed_plasma) {
+          ap *= d_plasma;
+        }
       }
     }
     // !!!!!!!!!!!!!!
 
-    const auto step_plasma = params_.r / static_cast<Float>(params_.n_plasma);
-    Float r_avg = kZero;
-    for (std::size_t i = 0; i < params_.n_plasma; ++i) {
-      r_avg = step_plasma * (static_cast<Float>(i) + 0.5_F);
-      r.absorbed_plasma3[i] = 2 * consts::kPi * r.absorbed_plasma[i] / r_avg;
-    }
+    r.balance.absorbed_plasma = std::accumulate(
+        r.absorbed_plasma.begin(), r.absorbed_plasma.end(), kZero);
+    r.balance.absorbed_quartz = std::accumulate(
+        r.absorbed_quartz.begin(), r.absorbed_quartz.end(), kZero);
+    r.balance.absorbed_mirror = r.absorbed_mirror;
+    CheckEnergyBalance(r.balance, r.intensity_all, params_.energy_tolerance);
+
+    r.absorbed_plasma3 =
+        ShellDensities(r.absorbed_plasma, kZero, plasma_.params().radii);
+
+    // Первый узел кварца пуст (перенесён в плазму).
+    const auto quartz3 =
+        ShellDensities(std::span{r.absorbed_quartz}.subspan(1), params_.r,
+                       quartz_.params().radii);
+    std::ranges::copy(quartz3, r.absorbed_quartz3.begin() + 1);
+
+    r.timings = {
+        .emission = e.seconds,
+        .transport = Seconds(transported - emitted),
+        .post = Seconds(Clock::now() - transported),
+    };
 
-    //    r.absorbed_quartz3.front() =
-    //        2 * consts::kPi * r.absorbed_plasma.front() / r_avg;
+    return r;
+  }
 
-    const auto step_quartz =
-        params_.delta / static_cast<Float>(params_.n_quartz);
-    for (std::size_t i = 0; i < params_.n_quartz; ++i) {
-      r_avg = params_.r + step_quartz * (static_cast<Float>(i) + 0.5_F);
-      r.absorbed_quartz3[i + 1] =
-          2 * consts::kPi * r.absorbed_quartz[i + 1] / r_avg;
-    }
+ private:
+  using Clock = std::chrono::steady_clock;
 
-#ifndef XENON_TABLE_COEFFICIENT
-    Float total_plasma = 0;
-    std::cout << "TOTAL ABSORBED PLASMA:\n";
-    for (const auto i : r.absorbed_plasma) {
-      std::cout << i << '\n';
-      total_plasma += i;
-    }
-    // TODO(a.kerimov): First quartz is the last plasma.
-    Float total_quartz = 0;
-    std::cout << "TOTAL ABSORBED QUARTZ:\n";
-    for (const auto i : r.absorbed_quartz) {
-      std::cout << i << '\n';
-      total_quartz += i;
-    }
+  static constexpr std::size_t kChunkSize = 64;
 
-    std::cout << "ABSORBED QUARTZ: " << r.absorbed_mirror << '\n';
-    std::cout << "SUM: " << total_plasma + total_quartz + r.absorbed_mirror
-              << '\n';
-    std::cout << "INTENSITY ALL: " << r.intensity_all << '\n';
-#endif
+  [[nodiscard]] static double Seconds(Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+  }
 
-    return r;
+  [[nodiscard]] static std::size_t ChunkBegin(std::size_t chunk) {
+    return chunk * kChunkSize;
   }
 
- private:
-  void InitDirs() {
-    dirs_ = FibonacciSphere(sphere_points_);
-    EraseRemoveIf(dirs_, [](Vec3 dir) { return dir.x() <= 0; });
-    for (const auto dir : dirs_) {
-      DEBUG_OUT << dir << '\n';
-#ifdef ENABLE_GEOGEBRA_OUTPUT_SPHERE
-      static int i = 0;
-      std::cout << geogebra::Point3D(std::format("P{}", i), dir);
-      ++i;
-#endif
+  [[nodiscard]] std::size_t ChunkEnd(std::size_t chunk) const {
+    return std::min(ChunkBegin(chunk) + kChunkSize, dirs_->size());
+  }
+
+  [[nodiscard]] std::size_t NChunks() const {
+    return (dirs_->size() + kChunkSize - 1) / kChunkSize;
+  }
+
+  /// С наблюдателем блоки обходятся вразброс (SpreadOrder), чтобы
+  /// пройденные до остановки покрывали всю сферу; пусто — по порядку.
+  [[nodiscard]] std::vector<std::size_t> ChunkOrder(
+      const SolveMonitor* monitor) const {
+    return monitor != nullptr ? SpreadOrder(NChunks())
+                              : std::vector<std::size_t>{};
+  }
+
+  [[nodiscard]] Vec3 InitialPos() const { return {params_.r, 0, 0}; }
+
+  void SolveRay(Vec3 initial_pos,
+                std::size_t jj,
+                Float intensity,
+                Float intensity_end,
+                std::size_t thread,
+                Result& r,
+                SolveMonitor* monitor) const {
+    std::vector<WorkerParams> wait_plasma;
+    std::vector<WorkerParams> wait_quartz;
+
+    const auto ray = static_cast<std::uint32_t>(jj);
+    wait_quartz.push_back(
+        {initial_pos, (*dirs_)[jj], intensity, intensity_end, false, ray});
+
+    // Длина очередей каскада для monitor: изменение с прошлого отчёта.
+    std::size_t queued = 0;
+    const auto report = [&] {
+      if (monitor != nullptr) {
+        const auto now = wait_plasma.size() + wait_quartz.size();
+        monitor->AddQueued(now - queued);
+        queued = now;
+      }
+    };
+    report();
+
+    // NOLINTNEXTLINE(modernize-loop-convert)
+    while (!wait_plasma.empty() || !wait_quartz.empty()) {
+      while (!wait_quartz.empty()) {
+        auto last = wait_quartz.back();
+        wait_quartz.pop_back();
+
+        auto res = quartz_.SolveDir(last, PathFor(last.ray, thread));
+        r.absorbed_mirror += res.absorbed_at_the_border;
+        AddTruncatedQuartz(r.balance, res);
+        static_assert(std::is_trivially_copyable_v<WorkerParams>);
+        for (auto released : res.released_rays) {
+          if (!released.use_prev) {
+            r.absorbed_mirror += released.intensity;
+          } else {
+            wait_plasma.push_back(released);
+          }
+        }
+
+        assert(r.absorbed_quartz.size() == res.absorbed.size());
+        for (size_t i = 0; i < res.absorbed.size(); ++i) {
+          r.absorbed_quartz[i] += res.absorbed[i];
+        }
+        report();
+      }
+
+      while (!wait_plasma.empty()) {
+        auto last = wait_plasma.back();
+        wait_plasma.pop_back();
+
+        auto res = plasma_.SolveDir(last, PathFor(last.ray, thread));
+        r.absorbed_quartz[1] += res.absorbed_at_the_border;
+        r.balance.truncated_quartz += res.truncated_at_the_border;
+        r.balance.truncated_plasma += res.truncated;
+        for (auto released : res.released_rays) {
+          assert(!released.use_prev);
+          wait_quartz.push_back(released);
+        }
+
+        assert(r.absorbed_plasma.size() == res.absorbed.size());
+        for (size_t j = 0; j < res.absorbed.size(); ++j) {
+          r.absorbed_plasma[j] += res.absorbed[j];
+        }
+        report();
+      }
     }
   }
 
+  [[nodiscard]] RayPathBuffer* PathFor(std::uint32_t ray,
+                                       std::size_t thread) const {
+    return recorder_ ? recorder_->Sample(ray, thread) : nullptr;
+  }
+
   Params params_;
   Float b_;
   Float a_;
@@ -320,7 +434,8 @@ class CylinderPlasmaQuartz::Impl {
 
   SolidCylinder plasma_;
   HollowCylinder quartz_;
-  std::vector<Vec3> dirs_;
+  std::unique_ptr<RayPathRecorder> recorder_;
+  Directions dirs_;
 };
 
 CylinderPlasmaQuartz::CylinderPlasmaQuartz(const Params& params)
@@ -329,5 +444,33 @@ CylinderPlasmaQuartz::CylinderPlasmaQuartz(const Params& params)
 CylinderPlasmaQuartz::~CylinderPlasmaQuartz() = default;
 
 auto CylinderPlasmaQuartz::Solve() -> Result {
-  return pimpl_->Solve();
+  return pimpl_->Solve(nullptr);
+}
+
+auto CylinderPlasmaQuartz::Solve(ThreadPool& pool) -> Result {
+  return pimpl_->Solve(&pool);
+}
+
+auto CylinderPlasmaQuartz::Solve(SolveMonitor& monitor) -> Result {
+  return pimpl_->Solve(nullptr, &monitor);
+}
+
+auto CylinderPlasmaQuartz::Solve(SolveMonitor& monitor, ThreadPool& pool)
+    -> Result {
+  return pimpl_->Solve(&pool, &monitor);
+}
+
+auto CylinderPlasmaQuartz::SolveBatch(std::span<const Params> params)
+    -> std::vector<Result> {
+  std::size_t n_threads = 1;
+  for (const auto& p : params) {
+    n_threads = std::max(n_threads, p.n_threads);
+  }
+  ThreadPool pool{n_threads - 1};
+  return SolveBatch(params, pool);
+}
+
+auto CylinderPlasmaQuartz::SolveBatch(std::span<const Params> params,
+                                      ThreadPool& pool) -> std::vector<Result> {
+  return ::SolveBatch<Result, Impl>(params, pool);
 }
@@ -0,0 +1,24 @@
+#include "modeling/energy_balance.h"
+
+#include <cmath>
+#include <format>
+#include <stdexcept>
+
+void CheckEnergyBalance(EnergyBalance& balance,
+                        Float emitted,
+                        Float tolerance) {
+  balance.residual = emitted - balance.absorbed_plasma -
+                     balance.absorbed_quartz - balance.absorbed_mirror;
+
+  // NaN в невязке тоже нарушение.
+  if (tolerance > 0 && !(std::abs(balance.residual) <= tolerance * emitted)) {
+    throw std::runtime_error(std::format(
+        "Energy balance violated: emitted {:g}, residual {:g} "
+        "(plasma {:g}, quartz {:g}, mirror {:g}; "
+        "truncated plasma {:g}, quartz {:g}, mirror {:g})",
+        emitted, balance.residual, balance.absorbed_plasma,
+        balance.absorbed_quartz, balance.absorbed_mirror,
+        balance.truncated_plasma, balance.truncated_quartz,
+        balance.truncated_mirror));
+  }
+}
@@ -48,7 +48,8 @@ std::vector<Vec3> FibonacciSphere(std::size_t n) {
     const auto theta = 2 * consts::kPi * ii / consts::kPhi;
     const auto phi = std::acos(1 - 2 * (ii + epsilon) / (nn - 1 + 2 * epsilon));
 
-    const Vec3 p{cos(theta) * sin(phi), sin(theta) * sin(phi), cos(phi)};
+    const Vec3 p{std::cos(theta) * std::sin(phi),
+                 std::sin(theta) * std::sin(phi), std::cos(phi)};
 
     points.push_back(p);
   }
@@ -4,16 +4,15 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
-#include <iostream>
-#include <string>
+#include <cstdint>
 #include <vector>
 
 #include "base/config/float.h"
 #include "base/ignore_unused.h"
 #include "math/float/compare.h"
-#include "math/float/eps.h"
 #include "math/linalg/vector.h"
-#include "math/linalg/vector_io.h"
+#include "modeling/radial_mesh.h"
+#include "modeling/ray_path.h"
 #include "ray_tracing/cylinder_z_infinite.h"
 #include "ray_tracing/utils.h"
 
@@ -21,13 +20,12 @@ namespace {
 
 // TODO(a.kerimov): Написать тесты.
 
-constexpr auto kDebugLevel = 0;
-static_assert(0 <= kDebugLevel && kDebugLevel <= 2);
-
 class HollowCylinderWorker {
  public:
-  explicit constexpr HollowCylinderWorker(const HollowCylinder& c) noexcept
-      : c_{c} {}
+  explicit constexpr HollowCylinderWorker(
+      const HollowCylinder& c,
+      RayPathBuffer* path = nullptr) noexcept
+      : c_{c}, path_{path} {}
 
   // NOLINTNEXTLINE(readability-function-cognitive-complexity)
   WorkerResult SolveDir(const WorkerParams& params) {
@@ -43,18 +41,13 @@ class HollowCylinderWorker {
 
     pos_ = params.pos;
     dir_ = params.dir;
-    // TODO(a.kerimov): Revive geogebra output (see git history).
+    ray_ = params.ray;
+    Record(RayPathEvent::kStart, intensity);
 
     use_prev_ = params.use_prev;
     assert(!use_prev_);
 
-    for ([[maybe_unused]] size_t i = 0; intensity > params.intensity_end; ++i) {
-      if constexpr (kDebugLevel >= 2) {
-        std::cout << "[HollowCylinder iteration=" << i
-                  << ", intensity=" << intensity << ", use_prev=" << use_prev_
-                  << "]\n";
-      }
-
+    while (intensity > params.intensity_end) {
       Intersect();
 
       const auto idx = use_prev_ ? prev_cylinder_idx_ : current_cylinder_idx_;
@@ -65,12 +58,7 @@ class HollowCylinderWorker {
       intensity *= exp;
       result.absorbed[idx] += prev_intensity - intensity;
       assert(idx != 0);
-
-      if constexpr (kDebugLevel >= 2) {
-        std::cout << "NEW POS: " << pos_ << " [ti=" << t_min_idx_
-                  << "][ci=" << current_cylinder_idx_ << "][dir=" << dir_
-                  << "]\n";
-      }
+      Record(RayPathEvent::kStep, intensity);
 
       const auto outward = current_cylinder_idx_ == border_idx;
       if (outward || current_cylinder_idx_ == 0) {
@@ -85,12 +73,17 @@ class HollowCylinderWorker {
         if (res.T > 0) {
           if (const auto new_i = intensity * res.T;
               new_i > params.intensity_end) {
-            result.released_rays.push_back(
-                {pos_, res.refracted, new_i, params.intensity_end, use_prev_});
+            result.released_rays.push_back({pos_, res.refracted, new_i,
+                                            params.intensity_end, use_prev_,
+                                            params.ray});
+            Record(RayPathEvent::kRelease, new_i);
           } else if (outward) {
             result.absorbed_at_the_border += new_i;
+            result.truncated_at_the_border += new_i;
           } else {
             result.absorbed[0] += new_i;
+            result.truncated += new_i;
+            result.truncated_inner += new_i;
           }
         }
 
@@ -98,35 +91,26 @@ class HollowCylinderWorker {
         dir_ = res.reflected;
         intensity *= res.R;
         use_prev_ = outward;
-
-        if constexpr (kDebugLevel >= 2) {
-          std::cout << "REFLECT, new dir " << dir_ << '\n';
-        }
+        Record(RayPathEvent::kReflect, intensity);
       }
     }
 
-    if constexpr (kDebugLevel >= 2) {
-      std::cout << "[HollowCylinder iteration=LAST, intensity=" << intensity
-                << "]\n";
-    }
-
     Intersect();
 
     const auto idx = use_prev_ ? prev_cylinder_idx_ : current_cylinder_idx_;
     result.absorbed[idx] += intensity;
+    result.truncated += intensity;
     assert(idx != 0);
+    Record(RayPathEvent::kEnd, intensity);
 
     return result;
   }
 
  private:
-  void PrintT(const char* prompt, Float t) const {
-    if constexpr (kDebugLevel >= 2) {
-      std::cout << prompt << t;
-      if (t > kEps) {
-        std::cout << ' ' << pos_ + t * dir_;
-      }
-      std::cout << '\n';
+  void Record(RayPathEvent event, Float intensity) {
+    if (path_ != nullptr) [[unlikely]] {
+      path_->Record(ray_, event, RayPathBody::kQuartz, current_cylinder_idx_,
+                    pos_, intensity);
     }
   }
 
@@ -135,8 +119,6 @@ class HollowCylinderWorker {
       const auto t =
           c_.cylinders[current_cylinder_idx_ - 1].Intersect(pos_, dir_);
       ts_[kIdxPrevCylinder] = t;
-
-      PrintT("PrevCylinder  ", t);
     } else {
       ts_[kIdxPrevCylinder] = -1;
     }
@@ -147,8 +129,6 @@ class HollowCylinderWorker {
       const auto t =
           c_.cylinders[current_cylinder_idx_ + 1].Intersect(pos_, dir_);
       ts_[kIdxNextCylinder] = t;
-
-      PrintT("NextCylinder  ", t);
     } else {
       ts_[kIdxNextCylinder] = -1;
     }
@@ -158,8 +138,6 @@ class HollowCylinderWorker {
     const auto t =
         c_.cylinders[current_cylinder_idx_].IntersectCurr(pos_, dir_);
     ts_[kIdxCurrCylinder] = IsZero(t) ? -1 : t;
-
-    PrintT("CurrCylinder* ", t);
   }
 
   void Intersect() {
@@ -187,6 +165,8 @@ class HollowCylinderWorker {
 
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
   const HollowCylinder& c_;
+  RayPathBuffer* path_;
+  std::uint32_t ray_{};
 
   Vec3 pos_;
   Vec3 dir_;
@@ -213,57 +193,46 @@ HollowCylinder::HollowCylinder(const Params& params,
     : params_{params} {
   assert(params_.radius_max > params_.radius_min);
   assert(params_.steps > 1);
+  if (params_.radii.empty()) {
+    params_.radii = GradedRadii(params_.radius_min, params_.radius_max,
+                                params_.steps, 1);
+  }
+  assert(params_.radii.size() == params_.steps);
   cylinders.reserve(params_.steps + 1);
   temperatures.reserve(params_.steps + 1);
   intensities.reserve(params_.steps + 1);
   attenuations.reserve(params_.steps + 1);
 
-  const auto step = (params_.radius_max - params_.radius_min) /
-                    static_cast<Float>(params_.steps);
-
-  const auto insert_cylinder = [&temperature, &intensity, &attenuation, this,
-                                step](const Float radius) {
+  const auto insert_cylinder = [&temperature, &intensity, &attenuation,
+                                this](Float radius, Float middle) {
     cylinders.emplace_back(params_.center, radius);
-    const auto t = temperature((radius - step / 2) / params_.radius_min);
+    const auto t = temperature(middle / params_.radius_min);
     temperatures.emplace_back(t);
     intensities.emplace_back(intensity(t));
     attenuations.emplace_back(attenuation(t));
   };
 
-  insert_cylinder(params_.radius_min);
-
-  for (std::size_t i = 1; i < params_.steps; ++i) {
-    insert_cylinder(params_.radius_min + step * static_cast<Float>(i));
+  // Слой 0 внутри radius_min лучи не пересекают; его температура — на
+  // полслоя внутрь, как у слоя 1 наружу.
+  const auto first_width = params_.radii.front() - params_.radius_min;
+  insert_cylinder(params_.radius_min, params_.radius_min - first_width / 2);
+
+  // Температура слоя — на середине между его границами.
+  auto inner = params_.radius_min;
+  for (const auto radius : params_.radii) {
+    assert(inner < radius);
+    insert_cylinder(radius, (inner + radius) / 2);
+    inner = radius;
   }
 
-  insert_cylinder(params_.radius_max);
-
   assert(cylinders.size() == params_.steps + 1);
   assert(temperatures.size() == params_.steps + 1);
   assert(intensities.size() == params_.steps + 1);
   assert(attenuations.size() == params_.steps + 1);
-
-  if constexpr (kDebugLevel >= 1) {
-    std::cout << "[HollowCylinder]\n"
-                 "Cylinders:\n";
-    for (auto& cylinder : cylinders) {
-      std::cout << cylinder.center() << ' ' << std::sqrt(cylinder.radius2())
-                << '\n';
-    }
-
-    std::cout << "T:\n";
-    for (const auto t : temperatures) {
-      std::cout << t << '\n';
-    }
-
-    std::cout << "I:\n";
-    for (const auto i : intensities) {
-      std::cout << i << '\n';
-    }
-  }
 }
 
-WorkerResult HollowCylinder::SolveDir(const WorkerParams& params) const {
-  HollowCylinderWorker worker{*this};
+WorkerResult HollowCylinder::SolveDir(const WorkerParams& params,
+                                      RayPathBuffer* path) const {
+  HollowCylinderWorker worker{*this, path};
   return worker.SolveDir(params);
 }
@@ -0,0 +1,222 @@
+#include "modeling/hollow_elliptic_cylinder.h"
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/config/float.h"
+#include "base/ignore_unused.h"
+#include "math/float/compare.h"
+#include "math/linalg/vector.h"
+#include "modeling/ray_path.h"
+#include "ray_tracing/elliptic_cylinder_z_infinite.h"
+#include "ray_tracing/utils.h"
+
+namespace {
+
+class HollowEllipticCylinderWorker {
+ public:
+  explicit constexpr HollowEllipticCylinderWorker(
+      const HollowEllipticCylinder& c,
+      RayPathBuffer* path = nullptr) noexcept
+      : c_{c}, path_{path} {}
+
+  // NOLINTNEXTLINE(readability-function-cognitive-complexity)
+  WorkerResult SolveDir(const WorkerParams& params) {
+    WorkerResult result;
+    result.absorbed.resize(c_.cylinders.size());
+
+    auto intensity = params.intensity;
+
+    // TODO(a.kerimov): Move to params if needed.
+    assert(c_.cylinders.size() > 2);
+    const auto border_idx = c_.cylinders.size() - 1;
+    current_cylinder_idx_ = 0;
+
+    pos_ = params.pos;
+    dir_ = params.dir;
+    ray_ = params.ray;
+    Record(RayPathEvent::kStart, intensity);
+
+    use_prev_ = params.use_prev;
+    assert(!use_prev_);
+
+    while (intensity > params.intensity_end) {
+      Intersect();
+
+      const auto idx = use_prev_ ? prev_cylinder_idx_ : current_cylinder_idx_;
+      const auto dr = Vec3::Distance(prev_pos_, pos_);
+      const auto k = c_.attenuations[idx];
+      const auto exp = std::exp(-k * dr);
+      const auto prev_intensity = intensity;
+      intensity *= exp;
+      result.absorbed[idx] += prev_intensity - intensity;
+      assert(idx != 0);
+      Record(RayPathEvent::kStep, intensity);
+
+      const auto outward = current_cylinder_idx_ == border_idx;
+      if (outward || current_cylinder_idx_ == 0) {
+        assert(outward == !use_prev_);
+        const auto& p = c_.params();
+        const auto eta_t =
+            outward ? p.refractive_index_external : p.refractive_index_internal;
+        const auto mirror = outward ? p.mirror_external : p.mirror_internal;
+        const auto res = c_.cylinders[current_cylinder_idx_].Refract(
+            pos_, dir_, p.refractive_index, eta_t, mirror, outward);
+
+        if (res.T > 0) {
+          if (const auto new_i = intensity * res.T;
+              new_i > params.intensity_end) {
+            result.released_rays.push_back({pos_, res.refracted, new_i,
+                                            params.intensity_end, use_prev_,
+                                            params.ray});
+            Record(RayPathEvent::kRelease, new_i);
+          } else if (outward) {
+            result.absorbed_at_the_border += new_i;
+            result.truncated_at_the_border += new_i;
+          } else {
+            result.absorbed[0] += new_i;
+            result.truncated += new_i;
+            result.truncated_inner += new_i;
+          }
+        }
+
+        assert(res.R > 0);
+        dir_ = res.reflected;
+        intensity *= res.R;
+        use_prev_ = outward;
+        Record(RayPathEvent::kReflect, intensity);
+      }
+    }
+
+    Intersect();
+
+    const auto idx = use_prev_ ? prev_cylinder_idx_ : current_cylinder_idx_;
+    result.absorbed[idx] += intensity;
+    result.truncated += intensity;
+    assert(idx != 0);
+    Record(RayPathEvent::kEnd, intensity);
+
+    return result;
+  }
+
+ private:
+  void Record(RayPathEvent event, Float intensity) {
+    if (path_ != nullptr) [[unlikely]] {
+      path_->Record(ray_, event, RayPathBody::kQuartz, current_cylinder_idx_,
+                    pos_, intensity);
+    }
+  }
+
+  void IntersectPrevCylinder() {
+    if (current_cylinder_idx_ > 0) {
+      const auto t =
+          c_.cylinders[current_cylinder_idx_ - 1].Intersect(pos_, dir_);
+      ts_[kIdxPrevCylinder] = t;
+    } else {
+      ts_[kIdxPrevCylinder] = -1;
+    }
+  }
+
+  void IntersectNextCylinder() {
+    if (current_cylinder_idx_ + 1 < c_.cylinders.size()) {
+      const auto t =
+          c_.cylinders[current_cylinder_idx_ + 1].Intersect(pos_, dir_);
+      ts_[kIdxNextCylinder] = t;
+    } else {
+      ts_[kIdxNextCylinder] = -1;
+    }
+  }
+
+  void IntersectCurrCylinder() {
+    const auto t =
+        c_.cylinders[current_cylinder_idx_].IntersectCurr(pos_, dir_);
+    ts_[kIdxCurrCylinder] = IsZero(t) ? -1 : t;
+  }
+
+  void Intersect() {
+    IntersectPrevCylinder();
+    IntersectNextCylinder();
+    IntersectCurrCylinder();
+
+    t_min_idx_ = FindIndexOfMinimalNonNegative(ts_);
+    assert(t_min_idx_ <= kIdxLastCylinder);
+    IgnoreUnused(kIdxLastCylinder);
+    prev_pos_ = pos_;
+    // TODO(a.kerimov): Fix all Point-s.
+    pos_ = pos_ + ts_[t_min_idx_] * dir_;
+
+    prev_cylinder_idx_ = current_cylinder_idx_;
+
+    if (t_min_idx_ == kIdxPrevCylinder) {
+      --current_cylinder_idx_;
+    } else if (t_min_idx_ == kIdxNextCylinder) {
+      ++current_cylinder_idx_;
+    }
+
+    use_prev_ = current_cylinder_idx_ <= prev_cylinder_idx_;
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+  const HollowEllipticCylinder& c_;
+  RayPathBuffer* path_;
+  std::uint32_t ray_{};
+
+  Vec3 pos_;
+  Vec3 dir_;
+  Vec3 prev_pos_;
+
+  static constexpr size_t kIdxPrevCylinder = 0;
+  static constexpr size_t kIdxNextCylinder = 1;
+  static constexpr size_t kIdxCurrCylinder = 2;
+  static constexpr size_t kIdxLastCylinder = kIdxCurrCylinder;
+  std::array<Float, 3> ts_{};
+  std::size_t t_min_idx_{};
+
+  std::size_t current_cylinder_idx_{};
+  std::size_t prev_cylinder_idx_{};
+  bool use_prev_{false};
+};
+
+}  // namespace
+
+HollowEllipticCylinder::HollowEllipticCylinder(
+    const Params& params,
+    const TemperatureFunc& temperature,
+    const IntensityFunc& intensity,
+    const AttenuationFunc& attenuation)
+    : params_{params} {
+  assert(params_.thickness > 0);
+  assert(params_.steps > 1);
+  cylinders.reserve(params_.steps + 1);
+  temperatures.reserve(params_.steps + 1);
+  intensities.reserve(params_.steps + 1);
+  attenuations.reserve(params_.steps + 1);
+
+  const auto n = static_cast<Float>(params_.steps);
+  for (std::size_t i = 0; i <= params_.steps; ++i) {
+    const auto k = static_cast<Float>(i);
+    const auto d = params_.thickness * k / n;
+    cylinders.emplace_back(params_.center, params_.a_min + d,
+                           params_.b_min + d);
+    // Слой i лежит между границами i - 1 и i; нулевой ничего не поглощает.
+    const auto t = temperature(i == 0 ? kZero : (k - 0.5_F) / n);
+    temperatures.emplace_back(t);
+    intensities.emplace_back(intensity(t));
+    attenuations.emplace_back(attenuation(t));
+  }
+
+  assert(cylinders.size() == params_.steps + 1);
+  assert(temperatures.size() == params_.steps + 1);
+  assert(intensities.size() == params_.steps + 1);
+  assert(attenuations.size() == params_.steps + 1);
+}
+
+WorkerResult HollowEllipticCylinder::SolveDir(const WorkerParams& params,
+                                              RayPathBuffer* path) const {
+  HollowEllipticCylinderWorker worker{*this, path};
+  return worker.SolveDir(params);
+}
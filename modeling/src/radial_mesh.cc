@@ -0,0 +1,186 @@
+#include "modeling/radial_mesh.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "base/config/float.h"
+#include "math/consts/pi.h"
+#include "modeling/cylinder_common.h"
+
+std::vector<Float> GradedRadii(Float from,
+                               Float to,
+                               std::size_t n,
+                               Float ratio) {
+  if (n == 0) {
+    throw std::invalid_argument("radial mesh needs at least one shell");
+  }
+  if (!(ratio > 0)) {
+    throw std::invalid_argument(
+        std::format("grading {} must be > 0", ratio));
+  }
+  assert(from < to);
+
+  std::vector<Float> radii;
+  radii.reserve(n);
+  if (IsUniformGrading(ratio) || n == 1) {
+    const auto step = (to - from) / static_cast<Float>(n);
+    for (std::size_t i = 1; i < n; ++i) {
+      radii.push_back(from + step * static_cast<Float>(i));
+    }
+  } else {
+    // Ширины w q^i, i < n, q^(n - 1) = ratio.
+    const auto q = std::pow(ratio, 1 / static_cast<Float>(n - 1));
+    const auto total = std::pow(q, static_cast<Float>(n)) - 1;
+    for (std::size_t i = 1; i < n; ++i) {
+      const auto part = (std::pow(q, static_cast<Float>(i)) - 1) / total;
+      radii.push_back(from + (to - from) * part);
+    }
+  }
+  radii.push_back(to);
+  return radii;
+}
+
+std::vector<Float> ShellDensities(std::span<const Float> absorbed,
+                                  Float inner,
+                                  std::span<const Float> radii) {
+  assert(absorbed.size() == radii.size());
+  assert(!radii.empty());
+  const auto step =
+      (radii.back() - inner) / static_cast<Float>(radii.size());
+
+  std::vector<Float> densities(absorbed.size());
+  for (std::size_t i = 0; i < radii.size(); ++i) {
+    const auto outer = radii[i];
+    // (2 pi)^2 step absorbed / (pi (outer^2 - inner^2)).
+    densities[i] = 4 * consts::kPi * step * absorbed[i] /
+                   ((outer - inner) * (outer + inner));
+    inner = outer;
+  }
+  return densities;
+}
+
+namespace {
+
+/// Внешние границы слоёв, набираемых жадно по отрезкам мелкой сетки шага
+/// h: слой растёт, пока суммы его depth и dt (в долях mesh) не превышают
+/// limit. Внутри отрезка обе суммы растут линейно.
+[[nodiscard]] std::vector<Float> GreedyRadii(std::span<const Float> depth,
+                                             std::span<const Float> dt,
+                                             Float h,
+                                             Float limit) {
+  std::vector<Float> radii;
+  Float sum_depth = 0;
+  Float sum_dt = 0;
+  for (std::size_t j = 0; j < depth.size(); ++j) {
+    Float used = 0;  // Доля отрезка j в уже закрытых слоях.
+    while (true) {
+      const auto rest = 1 - used;
+      if (sum_depth + depth[j] * rest <= limit &&
+          sum_dt + dt[j] * rest <= limit) {
+        sum_depth += depth[j] * rest;
+        sum_dt += dt[j] * rest;
+        break;
+      }
+      auto part = rest;
+      if (depth[j] > 0) {
+        part = std::min(part, (limit - sum_depth) / depth[j]);
+      }
+      if (dt[j] > 0) {
+        part = std::min(part, (limit - sum_dt) / dt[j]);
+      }
+      used += part;
+      radii.push_back(h * (static_cast<Float>(j) + used));
+      sum_depth = 0;
+      sum_dt = 0;
+    }
+  }
+  if (sum_depth > 0 || sum_dt > 0 || radii.empty()) {
+    radii.push_back(h * static_cast<Float>(depth.size()));
+  }
+  return radii;
+}
+
+}  // namespace
+
+std::vector<Float> AdaptiveRadii(Float radius,
+                                 const TemperatureFunc& temperature,
+                                 const AttenuationFunc& attenuation,
+                                 const AdaptiveMesh& mesh,
+                                 std::size_t n) {
+  if (!(mesh.max_depth > 0) || !(mesh.max_dt > 0)) {
+    throw std::invalid_argument(
+        std::format("max_depth {} and max_dt {} must be > 0", mesh.max_depth,
+                    mesh.max_dt));
+  }
+  assert(radius > 0);
+
+  // Доли требований mesh на отрезках мелкой сетки.
+  constexpr auto kSamples = static_cast<Float>(kAdaptiveMeshSamples);
+  const auto h = radius / kSamples;
+  std::vector<Float> depth(kAdaptiveMeshSamples);
+  std::vector<Float> dt(kAdaptiveMeshSamples);
+  auto t_inner = temperature(0);
+  for (std::size_t j = 0; j < kAdaptiveMeshSamples; ++j) {
+    const auto z = static_cast<Float>(j);
+    const auto t_outer = temperature((z + 1) / kSamples);
+    depth[j] =
+        attenuation(temperature((z + 0.5_F) / kSamples)) * h / mesh.max_depth;
+    dt[j] = std::abs(t_outer - t_inner) / mesh.max_dt;
+    t_inner = t_outer;
+  }
+
+  constexpr std::size_t kMinShells = 2;
+  if (n == 0) {
+    // Жадный набор даёт наименьшее число слоёв. Затем предел слоя
+    // снижается, пока слоёв столько же: последний слой не остаётся узким.
+    const auto shells = GreedyRadii(depth, dt, h, 1).size();
+    if (shells >= kMinShells) {
+      constexpr int kBisections = 40;
+      Float low = 0;
+      Float high = 1;
+      for (int i = 0; i < kBisections; ++i) {
+        const auto mid = (low + high) / 2;
+        if (GreedyRadii(depth, dt, h, mid).size() <= shells) {
+          high = mid;
+        } else {
+          low = mid;
+        }
+      }
+      auto radii = GreedyRadii(depth, dt, h, high);
+      radii.back() = radius;
+      return radii;
+    }
+    n = kMinShells;
+  }
+
+  // n слоёв с равной долей суммы max(depth, dt) по отрезкам.
+  std::vector<Float> cost(kAdaptiveMeshSamples + 1);
+  for (std::size_t j = 0; j < kAdaptiveMeshSamples; ++j) {
+    cost[j + 1] = cost[j] + std::max(depth[j], dt[j]);
+  }
+  const auto total = cost.back();
+  if (!(total > 0)) {
+    return GradedRadii(0, radius, n, 1);
+  }
+
+  std::vector<Float> radii;
+  radii.reserve(n);
+  std::size_t j = 0;
+  for (std::size_t i = 1; i < n; ++i) {
+    const auto target = total * static_cast<Float>(i) / static_cast<Float>(n);
+    while (cost[j + 1] < target) {
+      ++j;
+    }
+    // cost[j] < target <= cost[j + 1]: линейно внутри отрезка j.
+    const auto part = (target - cost[j]) / (cost[j + 1] - cost[j]);
+    radii.push_back(h * (static_cast<Float>(j) + part));
+  }
+  radii.push_back(radius);
+  return radii;
+}
@@ -0,0 +1,193 @@
+#include "modeling/ray_path.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+#include <ios>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+namespace {
+
+std::atomic<std::size_t> gRecorderCounter{0};  // NOLINT
+
+[[nodiscard]] std::size_t ParseSize(std::string_view str) {
+  std::size_t value{};
+  const auto [ptr, ec] =
+      std::from_chars(str.data(), str.data() + str.size(), value);
+  if (ec != std::errc{} || ptr != str.data() + str.size()) {
+    throw std::invalid_argument(std::format("Bad number '{}'", str));
+  }
+  return value;
+}
+
+void WriteRadii(std::ofstream& out,
+                const std::vector<CylinderZInfinite>& cylinders) {
+  for (const auto& cylinder : cylinders) {
+    const auto r = static_cast<float>(std::sqrt(cylinder.radius2()));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    out.write(reinterpret_cast<const char*>(&r), sizeof r);
+  }
+}
+
+[[nodiscard]] std::vector<Float> ReadRadii(std::ifstream& in, std::size_t n) {
+  std::vector<float> raw(n);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  in.read(reinterpret_cast<char*>(raw.data()),
+          static_cast<std::streamsize>(n * sizeof(float)));
+  return {raw.begin(), raw.end()};
+}
+
+}  // namespace
+
+RayPathBuffer::RayPathBuffer(RayPathRecorder& recorder) : recorder_{recorder} {
+  records_.reserve(kCapacity);
+}
+
+RayPathBuffer::~RayPathBuffer() {
+  Flush();
+}
+
+void RayPathBuffer::Record(std::uint32_t ray,
+                           RayPathEvent event,
+                           RayPathBody body,
+                           std::size_t shell,
+                           Vec3 pos,
+                           Float intensity) {
+  records_.push_back({
+      .ray = ray,
+      .event = event,
+      .body = body,
+      .shell = static_cast<std::uint16_t>(shell),
+      .pos = {static_cast<float>(pos.x()), static_cast<float>(pos.y()),
+              static_cast<float>(pos.z())},
+      .intensity = static_cast<float>(intensity),
+  });
+  // Блок файла — целые подлучи (kStart ... kEnd): иначе подлуч того же
+  // направления из другого потока мог бы лечь между частями этого.
+  if (event == RayPathEvent::kEnd && records_.size() >= kCapacity) {
+    Flush();
+  }
+}
+
+void RayPathBuffer::Flush() {
+  if (!records_.empty()) {
+    recorder_.Write(records_);
+    records_.clear();
+  }
+}
+
+std::unique_ptr<RayPathRecorder> RayPathRecorder::FromEnv(
+    const std::vector<CylinderZInfinite>& plasma,
+    const std::vector<CylinderZInfinite>& quartz,
+    std::size_t n_threads) {
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  const auto* path = std::getenv("MT_RAY_PATH");
+  if (path == nullptr || *path == '\0') {
+    return nullptr;
+  }
+
+  Config config;
+  config.path = path;
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  if (const auto* sample = std::getenv("MT_RAY_PATH_SAMPLE")) {
+    config.sample = std::max<std::size_t>(ParseSize(sample), 1);
+  }
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  if (const auto* rays = std::getenv("MT_RAY_PATH_RAYS")) {
+    std::string_view str{rays};
+    while (!str.empty()) {
+      const auto comma = std::min(str.find(','), str.size());
+      config.rays.push_back(
+          static_cast<std::uint32_t>(ParseSize(str.substr(0, comma))));
+      str.remove_prefix(std::min(comma + 1, str.size()));
+    }
+    std::ranges::sort(config.rays);
+  }
+
+  return std::make_unique<RayPathRecorder>(config, plasma, quartz, n_threads);
+}
+
+RayPathRecorder::RayPathRecorder(const Config& config,
+                                 const std::vector<CylinderZInfinite>& plasma,
+                                 const std::vector<CylinderZInfinite>& quartz,
+                                 std::size_t n_threads)
+    : config_{config} {
+  auto path = config_.path;
+  if (const auto pos = path.find("{}"); pos != std::string::npos) {
+    path.replace(pos, 2, std::to_string(gRecorderCounter++));
+  }
+
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  if (!out_) {
+    throw std::runtime_error(std::format("Can't open '{}'", path));
+  }
+
+  const RayPathHeader header{
+      .n_plasma = static_cast<std::uint32_t>(plasma.size()),
+      .n_quartz = static_cast<std::uint32_t>(quartz.size()),
+  };
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  out_.write(reinterpret_cast<const char*>(&header), sizeof header);
+  WriteRadii(out_, plasma);
+  WriteRadii(out_, quartz);
+
+  buffers_.reserve(n_threads);
+  for (std::size_t i = 0; i < std::max<std::size_t>(n_threads, 1); ++i) {
+    buffers_.push_back(std::make_unique<RayPathBuffer>(*this));
+  }
+}
+
+RayPathBuffer* RayPathRecorder::Sample(std::uint32_t ray, std::size_t thread) {
+  const auto sampled = config_.rays.empty()
+                           ? ray % config_.sample == 0
+                           : std::ranges::binary_search(config_.rays, ray);
+  return sampled ? buffers_[thread].get() : nullptr;
+}
+
+void RayPathRecorder::Write(const std::vector<RayPathRecord>& records) {
+  const std::lock_guard lock{mutex_};
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  out_.write(reinterpret_cast<const char*>(records.data()),
+             static_cast<std::streamsize>(records.size() *
+                                          sizeof(RayPathRecord)));
+}
+
+RayPath ReadRayPath(const std::string& path) {
+  std::ifstream in{path, std::ios::binary};
+  if (!in) {
+    throw std::runtime_error(std::format("Can't open '{}'", path));
+  }
+
+  RayPathHeader header;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  in.read(reinterpret_cast<char*>(&header), sizeof header);
+  if (!in || header.magic != RayPathHeader::kMagic ||
+      header.version != RayPathHeader::kVersion) {
+    throw std::runtime_error(std::format("'{}' is not a ray path file", path));
+  }
+
+  RayPath ray_path{
+      .plasma_radii = ReadRadii(in, header.n_plasma),
+      .quartz_radii = ReadRadii(in, header.n_quartz),
+      .records = {},
+  };
+  if (!in) {
+    throw std::runtime_error(std::format("'{}' is truncated", path));
+  }
+
+  RayPathRecord record{};
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  while (in.read(reinterpret_cast<char*>(&record), sizeof record)) {
+    ray_path.records.push_back(record);
+  }
+
+  // Блоки разных потоков перемешаны, но каждый состоит из целых подлучей:
+  // после устойчивой сортировки подлучи направления идут подряд.
+  std::ranges::stable_sort(ray_path.records, {}, &RayPathRecord::ray);
+  return ray_path;
+}
@@ -0,0 +1,348 @@
+#include "modeling/result_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "base/config/float.h"
+#include "base/fnv1a.h"
+#include "io/atomic_file.h"
+#include "physics/absorption_table.h"
+
+namespace {
+
+constexpr std::string_view kExtension = ".mtr";
+
+/// Заголовок файла кеша. За ним ключ, затем Result: intensity_all,
+/// absorbed_mirror, 7 полей balance и массивы absorbed_* в порядке
+/// объявления, каждый — число элементов (uint64) и Float[n].
+struct ResultCacheHeader {
+  static constexpr std::array<char, 8> kMagic = {'M', 'T', 'R', 'C',
+                                                 'A', 'C', 'H', 'E'};
+  static constexpr std::uint32_t kVersion = 1;
+
+  std::array<char, 8> magic = kMagic;
+  std::uint32_t version = kVersion;
+  std::uint32_t float_size = sizeof(Float);
+  std::uint64_t key_size{};
+  std::uint64_t checksum{};  ///< FNV-1a всего, что после заголовка.
+};
+static_assert(sizeof(ResultCacheHeader) == 32);
+
+template <typename Result>
+[[nodiscard]] auto Scalars(Result& r) {
+  auto& b = r.balance;
+  return std::array{&r.intensity_all,     &r.absorbed_mirror,
+                    &b.absorbed_plasma,   &b.absorbed_quartz,
+                    &b.absorbed_mirror,   &b.truncated_plasma,
+                    &b.truncated_quartz,  &b.truncated_mirror,
+                    &b.residual};
+}
+
+template <typename Result>
+[[nodiscard]] auto Vectors(Result& r) {
+  if constexpr (requires { r.absorbed_quartz; }) {
+    return std::array{&r.absorbed_plasma, &r.absorbed_plasma3,
+                      &r.absorbed_quartz, &r.absorbed_quartz3};
+  } else {
+    return std::array{&r.absorbed_plasma, &r.absorbed_plasma3};
+  }
+}
+
+template <typename T>
+void Put(std::string& out, const T& value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof value);  // NOLINT
+}
+
+/// Последовательное чтение; выход за конец данных — исключение.
+class Reader {
+ public:
+  explicit Reader(std::string_view data) : data_{data} {}
+
+  [[nodiscard]] std::string_view Take(std::size_t size) {
+    if (size > data_.size()) {
+      throw std::runtime_error("truncated");
+    }
+    const auto taken = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return taken;
+  }
+
+  template <typename T>
+  [[nodiscard]] T Get() {
+    T value;
+    std::memcpy(&value, Take(sizeof value).data(), sizeof value);
+    return value;
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return data_.empty(); }
+
+ private:
+  std::string_view data_;
+};
+
+template <typename Result>
+[[nodiscard]] Result Parse(std::string_view data, std::string_view key) {
+  Reader reader{data};
+  const auto header = reader.Get<ResultCacheHeader>();
+  if (header.magic != ResultCacheHeader::kMagic ||
+      header.version != ResultCacheHeader::kVersion ||
+      header.float_size != sizeof(Float)) {
+    throw std::runtime_error("unsupported format");
+  }
+  if (Fnv1a(data.substr(sizeof header)) != header.checksum) {
+    throw std::runtime_error("bad checksum");
+  }
+  if (reader.Take(header.key_size) != key) {
+    throw std::runtime_error("other key");
+  }
+
+  Result r;
+  for (auto* value : Scalars(r)) {
+    *value = reader.Get<Float>();
+  }
+  for (auto* values : Vectors(r)) {
+    const auto n = reader.Get<std::uint64_t>();
+    const auto bytes = reader.Take(n * sizeof(Float));
+    values->resize(n);
+    std::memcpy(values->data(), bytes.data(), bytes.size());
+  }
+  if (!reader.empty()) {
+    throw std::runtime_error("trailing data");
+  }
+  return r;
+}
+
+void Touch(const std::filesystem::path& path) {
+  std::error_code ec;
+  std::filesystem::last_write_time(
+      path, std::filesystem::file_time_type::clock::now(), ec);
+}
+
+/// Ключи сборки, меняющие результат при тех же Params (см. корневой
+/// CMakeLists.txt). -Ofast определяет __FAST_MATH__.
+constexpr std::string_view kBuildFlags = ""
+#ifdef MT_USE_DIFFUSE_REFLECTION
+                                         " diffuse"
+#endif
+#ifdef CONSTANT_TEMPERATURE
+                                         " constant_t"
+#endif
+#ifdef XENON_TABLE_COEFFICIENT
+                                         " xenon_table"
+#endif
+#ifdef __FAST_MATH__
+                                         " fast_math"
+#endif
+    ;
+
+/// Окружение, от которого зависит результат помимо Params.
+[[nodiscard]] std::string Environment() {
+  return std::format(" solver={} float={} table={:016x} build={{{} }}",
+                     ResultCache::kSolverVersion, sizeof(Float),
+                     AbsorptionTable::Default().Hash(), kBuildFlags);
+}
+
+std::atomic<bool> default_disabled{false};  // NOLINT(*-non-const-global-*)
+
+/// Предел из MT_CACHE_SIZE (МиБ) в байтах. Из-за опечатки в переменной
+/// расчёт не останавливается: остаётся kDefaultMaxBytes и предупреждение.
+[[nodiscard]] std::uint64_t ParseMaxBytes(std::string_view mib) {
+  constexpr auto kMax = std::numeric_limits<std::uint64_t>::max() >> 20;
+  std::uint64_t value{};
+  const auto* end = mib.data() + mib.size();
+  const auto [ptr, ec] = std::from_chars(mib.data(), end, value);
+  if (ec != std::errc{} || ptr != end || value > kMax) {
+    std::cerr << std::format(
+        "MT_CACHE_SIZE='{}' is not a size in MiB up to {}, using {}\n", mib,
+        kMax, ResultCache::kDefaultMaxBytes >> 20);
+    return ResultCache::kDefaultMaxBytes;
+  }
+  return value << 20;
+}
+
+}  // namespace
+
+void ResultCache::DisableDefault() noexcept {
+  default_disabled = true;
+}
+
+ResultCache* ResultCache::Default() {
+  if (default_disabled) {
+    return nullptr;
+  }
+  static const auto cache = []() -> std::unique_ptr<ResultCache> {
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    const auto* dir = std::getenv("MT_CACHE_DIR");
+    if (dir == nullptr || *dir == '\0') {
+      return nullptr;
+    }
+    auto max_bytes = kDefaultMaxBytes;
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    if (const auto* size = std::getenv("MT_CACHE_SIZE")) {
+      max_bytes = ParseMaxBytes(size);
+    }
+    return std::make_unique<ResultCache>(dir, max_bytes);
+  }();
+  return cache.get();
+}
+
+ResultCache::ResultCache(std::filesystem::path dir, std::uint64_t max_bytes)
+    : dir_{std::move(dir)}, max_bytes_{max_bytes} {
+  std::error_code ec;
+  std::filesystem::create_directories(dir_, ec);
+}
+
+template <typename Result>
+std::optional<Result> ResultCache::Find(std::string_view key) {
+  const auto path = PathFor(key);
+  const std::lock_guard lock{mutex_};
+  std::ifstream file{path, std::ios::binary};
+  if (!file) {
+    return std::nullopt;
+  }
+  const std::string data{std::istreambuf_iterator<char>{file}, {}};
+  file.close();
+
+  try {
+    auto result = Parse<Result>(data, key);
+    Touch(path);
+    return result;
+  } catch (const std::runtime_error&) {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    return std::nullopt;
+  }
+}
+
+template <typename Result>
+bool ResultCache::Store(std::string_view key, const Result& result) {
+  std::string payload{key};
+  for (const auto* value : Scalars(result)) {
+    Put(payload, *value);
+  }
+  for (const auto* values : Vectors(result)) {
+    Put(payload, std::uint64_t{values->size()});
+    payload.append(reinterpret_cast<const char*>(values->data()),  // NOLINT
+                   values->size() * sizeof(Float));
+  }
+
+  const ResultCacheHeader header{
+      .key_size = key.size(),
+      .checksum = Fnv1a(payload),
+  };
+  std::string data;
+  Put(data, header);
+  data += payload;
+
+  const auto path = PathFor(key);
+  const std::lock_guard lock{mutex_};
+  try {
+    WriteFileAtomically(path, data);
+    Touch(path);
+    Evict();
+  } catch (const std::runtime_error&) {
+    return false;
+  }
+  return true;
+}
+
+std::filesystem::path ResultCache::PathFor(std::string_view key) const {
+  return dir_ / std::format("{:016x}{}", Fnv1a(key), kExtension);
+}
+
+void ResultCache::Evict() {
+  struct Entry {
+    std::filesystem::path path;
+    std::uint64_t size;
+    std::filesystem::file_time_type time;
+  };
+  std::vector<Entry> entries;
+  std::uint64_t total{};
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator{dir_, ec}) {
+    if (entry.path().extension() != kExtension) {
+      continue;
+    }
+    const auto size = entry.file_size(ec);
+    const auto time = entry.last_write_time(ec);
+    if (!ec) {
+      entries.push_back({.path = entry.path(), .size = size, .time = time});
+      total += size;
+    }
+  }
+  if (total <= max_bytes_) {
+    return;
+  }
+
+  std::ranges::sort(entries, {}, &Entry::time);
+  for (const auto& entry : entries) {
+    if (total <= max_bytes_) {
+      break;
+    }
+    if (std::filesystem::remove(entry.path, ec)) {
+      total -= entry.size;
+    }
+  }
+}
+
+template std::optional<CylinderPlasma::Result> ResultCache::Find(
+    std::string_view key);
+template std::optional<CylinderPlasmaQuartz::Result> ResultCache::Find(
+    std::string_view key);
+template bool ResultCache::Store(std::string_view key,
+                                 const CylinderPlasma::Result& result);
+template bool ResultCache::Store(std::string_view key,
+                                 const CylinderPlasmaQuartz::Result& result);
+
+// n_threads и energy_tolerance на результат не влияют.
+
+std::string CacheKey(const CylinderPlasma::Params& p) {
+  return std::format(
+             "xe r={} n_plasma={} plasma_grading={} adaptive_plasma={} t0={} "
+             "tw={} m={} rho={} nu={} d_nu={} n_meridian={} n_latitude={} "
+             "i_crit={}",
+             p.r, p.n_plasma, p.plasma_grading, p.adaptive_plasma, p.t0, p.tw,
+             p.m, p.rho, p.nu, p.d_nu, p.n_meridian, p.n_latitude, p.i_crit) +
+         Environment();
+}
+
+std::string CacheKey(const CylinderPlasmaQuartz::Params& p) {
+  return std::format(
+             "xe-sio2 r={} n_plasma={} delta={} n_quartz={} plasma_grading={} "
+             "adaptive_plasma={} quartz_grading={} t0={} tw={} m={} t1={} "
+             "eta_plasma={} eta_quartz={} rho={} nu={} d_nu={} n_meridian={} "
+             "n_latitude={} i_crit={}",
+             p.r, p.n_plasma, p.delta, p.n_quartz, p.plasma_grading,
+             p.adaptive_plasma, p.quartz_grading, p.t0, p.tw, p.m, p.t1,
+             p.eta_plasma, p.eta_quartz, p.rho, p.nu, p.d_nu, p.n_meridian,
+             p.n_latitude, p.i_crit) +
+         Environment();
+}
+
+std::string CacheKey(const TwinPlasmaQuartz::Params& p) {
+  return std::format(
+             "xe-xe-sio2 r={} n_plasma={} gap={} plasma_grading={} "
+             "adaptive_plasma={} a={} b={} delta={} n_quartz={} t0={} tw={} "
+             "m={} t1={} eta_plasma={} eta_quartz={} eta_gas={} rho={} nu={} "
+             "d_nu={} n_meridian={} n_latitude={} i_crit={}",
+             p.r, p.n_plasma, p.gap, p.plasma_grading, p.adaptive_plasma, p.a,
+             p.b, p.delta, p.n_quartz, p.t0, p.tw, p.m, p.t1, p.eta_plasma,
+             p.eta_quartz, p.eta_gas, p.rho, p.nu, p.d_nu, p.n_meridian,
+             p.n_latitude, p.i_crit) +
+         Environment();
+}
@@ -4,8 +4,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
-#include <iostream>
-#include <string>
+#include <cstdint>
 #include <vector>
 
 #include "base/config/float.h"
@@ -14,7 +13,8 @@
 #include "math/float/compare.h"
 #include "math/float/eps.h"
 #include "math/linalg/vector.h"
-#include "math/linalg/vector_io.h"
+#include "modeling/radial_mesh.h"
+#include "modeling/ray_path.h"
 #include "ray_tracing/cylinder_z_infinite.h"
 #include "ray_tracing/utils.h"
 
@@ -22,13 +22,11 @@ namespace {
 
 // TODO(a.kerimov): Написать тесты.
 
-constexpr auto kDebugLevel = 0;
-static_assert(0 <= kDebugLevel && kDebugLevel <= 2);
-
 class SolidCylinderWorker {
  public:
-  explicit constexpr SolidCylinderWorker(const SolidCylinder& c) noexcept
-      : c_{c} {}
+  explicit constexpr SolidCylinderWorker(const SolidCylinder& c,
+                                         RayPathBuffer* path = nullptr) noexcept
+      : c_{c}, path_{path} {}
 
   // NOLINTNEXTLINE(readability-function-cognitive-complexity)
   WorkerResult SolveDir(const WorkerParams& params) {
@@ -44,17 +42,12 @@ class SolidCylinderWorker {
 
     pos_ = params.pos;
     dir_ = params.dir;
-    // TODO(a.kerimov): Revive geogebra output (see git history).
+    ray_ = params.ray;
+    Record(RayPathEvent::kStart, intensity);
 
     use_prev_ = params.use_prev;
 
-    for ([[maybe_unused]] size_t i = 0; intensity > params.intensity_end; ++i) {
-      if constexpr (kDebugLevel >= 2) {
-        std::cout << "[SolidCylinder iteration=" << i
-                  << ", intensity=" << intensity << ", use_prev=" << use_prev_
-                  << "]\n";
-      }
-
+    while (intensity > params.intensity_end) {
       Intersect();
 
       const auto idx = use_prev_ ? prev_cylinder_idx_ : current_cylinder_idx_;
@@ -64,12 +57,7 @@ class SolidCylinderWorker {
       const auto prev_intensity = intensity;
       intensity *= exp;
       result.absorbed[idx] += prev_intensity - intensity;
-
-      if constexpr (kDebugLevel >= 2) {
-        std::cout << "NEW POS: " << pos_ << " [ti=" << t_min_idx_
-                  << "][ci=" << current_cylinder_idx_ << "][dir=" << dir_
-                  << "]\n";
-      }
+      Record(RayPathEvent::kStep, intensity);
 
       if (current_cylinder_idx_ == border_idx) {
         const auto& p = c_.params();
@@ -81,32 +69,31 @@ class SolidCylinderWorker {
         if (res.T > 0) {
           if (const auto new_i = intensity * res.T;
               new_i > params.intensity_end) {
-            result.released_rays.push_back(
-                {pos_, res.refracted, new_i, params.intensity_end, !kOutward});
+            result.released_rays.push_back({pos_, res.refracted, new_i,
+                                            params.intensity_end, !kOutward,
+                                            params.ray});
+            Record(RayPathEvent::kRelease, new_i);
           } else {
             result.absorbed_at_the_border += new_i;
+            result.truncated_at_the_border += new_i;
           }
         }
 
-        assert(res.R > 0);
+        // При равных показателях преломления (столб в газе) R = 0.
+        assert(res.R >= 0);
         dir_ = res.reflected;
         intensity *= res.R;
         use_prev_ = !use_prev_;
-        if constexpr (kDebugLevel >= 2) {
-          std::cout << "REFLECT, new dir " << dir_ << '\n';
-        }
+        Record(RayPathEvent::kReflect, intensity);
       }
     }
 
-    if constexpr (kDebugLevel >= 2) {
-      std::cout << "[SolidCylinder iteration=LAST, intensity=" << intensity
-                << "]\n";
-    }
-
     Intersect();
 
     const auto idx = use_prev_ ? prev_cylinder_idx_ : current_cylinder_idx_;
     result.absorbed[idx] += intensity;
+    result.truncated += intensity;
+    Record(RayPathEvent::kEnd, intensity);
 
     return result;
   }
@@ -121,7 +108,12 @@ class SolidCylinderWorker {
     assert(c_.cylinders.size() > 1);
     const auto border_idx = c_.cylinders.size() - 1;
     const auto t = c_.cylinders[border_idx].IntersectCurr(pos_, dir_);
-    assert(t > 0);
+    // Почти касательное направление: хорда короче ошибки округления (в
+    // float — уже на сфере 72 x 72), луч плазму не пересекает. Его вклад
+    // пропорционален dir.x() и всё равно ничтожен.
+    if (!(t > 0)) {
+      return 0;
+    }
 
     pos_ = pos_ + t * dir_;
     dir_ = dir;
@@ -130,12 +122,7 @@ class SolidCylinderWorker {
     Float intensity{};
     use_prev_ = true;
 
-    for ([[maybe_unused]] size_t i = 0;; ++i) {
-      if constexpr (kDebugLevel >= 2) {
-        std::cout << "[SolidCylinder::CalculateIntensity, iteration=" << i
-                  << ", intensity=" << intensity << "]\n";
-      }
-
+    for (;;) {
       Intersect();
 
       const auto idx = use_prev_ ? prev_cylinder_idx_ : current_cylinder_idx_;
@@ -145,12 +132,6 @@ class SolidCylinderWorker {
       intensity *= exp;
       intensity += c_.intensities[idx] * (1 - exp);
 
-      if constexpr (kDebugLevel >= 2) {
-        std::cout << "NEW POS: " << pos_ << " [ti=" << t_min_idx_
-                  << "][ci=" << current_cylinder_idx_ << "][dir=" << dir_
-                  << "]\n";
-      }
-
       if (current_cylinder_idx_ == border_idx) {
         break;
       }
@@ -159,22 +140,17 @@ class SolidCylinderWorker {
     // const auto cos_theta = dir.z();
     // const auto sin_phi = std::sqrt(Sqr(dir.x()) + Sqr(dir.y()));
 
-    // std::cout << "INTENSITY BEFORE COSINE: " << intensity << "\n";
-
     intensity *=
-        2 * 2 * consts::kPi / static_cast<int>(sphere_points) * dir.x();
+        2 * 2 * consts::kPi / static_cast<Float>(sphere_points) * dir.x();
 
     return intensity;
   }
 
  private:
-  void PrintT(const char* prompt, Float t) const {
-    if constexpr (kDebugLevel >= 2) {
-      std::cout << prompt << t;
-      if (t > kEps) {
-        std::cout << ' ' << pos_ + t * dir_;
-      }
-      std::cout << '\n';
+  void Record(RayPathEvent event, Float intensity) {
+    if (path_ != nullptr) [[unlikely]] {
+      path_->Record(ray_, event, RayPathBody::kPlasma, current_cylinder_idx_,
+                    pos_, intensity);
     }
   }
 
@@ -183,8 +159,6 @@ class SolidCylinderWorker {
       const auto t =
           c_.cylinders[current_cylinder_idx_ - 1].Intersect(pos_, dir_);
       ts_[kIdxPrevCylinder] = t;
-
-      PrintT("PrevCylinder  ", t);
     } else {
       ts_[kIdxPrevCylinder] = -1;
     }
@@ -195,8 +169,6 @@ class SolidCylinderWorker {
       const auto t =
           c_.cylinders[current_cylinder_idx_ + 1].Intersect(pos_, dir_);
       ts_[kIdxNextCylinder] = t;
-
-      PrintT("NextCylinder  ", t);
     } else {
       ts_[kIdxNextCylinder] = -1;
     }
@@ -206,8 +178,6 @@ class SolidCylinderWorker {
     const auto t =
         c_.cylinders[current_cylinder_idx_].IntersectCurr(pos_, dir_);
     ts_[kIdxCurrCylinder] = IsZero(t, kEps) ? -1 : t;
-
-    PrintT("CurrCylinder* ", t);
   }
 
   void Intersect() {
@@ -234,6 +204,8 @@ class SolidCylinderWorker {
 
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
   const SolidCylinder& c_;
+  RayPathBuffer* path_;
+  std::uint32_t ray_{};
 
   Vec3 pos_;
   Vec3 dir_;
@@ -259,55 +231,36 @@ SolidCylinder::SolidCylinder(const Params& params,
                              const AttenuationFunc& attenuation)
     : params_{params} {
   assert(params_.steps > 1);
+  if (params_.radii.empty()) {
+    params_.radii = GradedRadii(0, params_.radius, params_.steps, 1);
+  }
+  assert(params_.radii.size() == params_.steps);
   cylinders.reserve(params_.steps);
   temperatures.reserve(params_.steps);
   intensities.reserve(params_.steps);
   attenuations.reserve(params_.steps);
 
-  const auto step = params_.radius / static_cast<Float>(params_.steps);
-
-  const auto insert_cylinder = [&temperature, &intensity, &attenuation, this,
-                                step](const Float radius) {
+  // Температура слоя — на середине между его границами.
+  Float inner = 0;
+  for (const auto radius : params_.radii) {
+    assert(inner < radius);
     cylinders.emplace_back(params_.center, radius);
-    const auto t = temperature((radius - step / 2) / params_.radius);
+    const auto t = temperature((inner + radius) / 2 / params_.radius);
     temperatures.emplace_back(t);
     intensities.emplace_back(intensity(t));
     attenuations.emplace_back(attenuation(t));
-  };
-
-  for (std::size_t i = 1; i < params_.steps; ++i) {
-    insert_cylinder(step * static_cast<Float>(i));
+    inner = radius;
   }
 
-  insert_cylinder(params_.radius);
-
   assert(cylinders.size() == params_.steps);
   assert(temperatures.size() == params_.steps);
   assert(intensities.size() == params_.steps);
   assert(attenuations.size() == params_.steps);
-
-  if constexpr (kDebugLevel >= 1) {
-    std::cout << "[SolidCylinder]\n"
-                 "Cylinders:\n";
-    for (auto& cylinder : cylinders) {
-      std::cout << cylinder.center() << ' ' << std::sqrt(cylinder.radius2())
-                << '\n';
-    }
-
-    std::cout << "T:\n";
-    for (const auto t : temperatures) {
-      std::cout << t << '\n';
-    }
-
-    std::cout << "I:\n";
-    for (const auto i : intensities) {
-      std::cout << i << '\n';
-    }
-  }
 }
 
-WorkerResult SolidCylinder::SolveDir(const WorkerParams& params) const {
-  SolidCylinderWorker worker{*this};
+WorkerResult SolidCylinder::SolveDir(const WorkerParams& params,
+                                     RayPathBuffer* path) const {
+  SolidCylinderWorker worker{*this, path};
   return worker.SolveDir(params);
 }
 
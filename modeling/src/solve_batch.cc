@@ -0,0 +1,62 @@
+#include "modeling/solve_batch.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "base/erase_remove_if.h"
+#include "math/linalg/vector.h"
+#include "modeling/fibonacci_sphere.h"
+
+Directions MakeDirections(std::size_t sphere_points) {
+  static std::mutex mutex;
+  static std::size_t last_points = 0;
+  static Directions last;
+
+  const std::lock_guard lock{mutex};
+  if (last && last_points == sphere_points) {
+    return last;
+  }
+  auto dirs = FibonacciSphere(sphere_points);
+  EraseRemoveIf(dirs, [](Vec3 dir) { return dir.x() <= 0; });
+  last = std::make_shared<const std::vector<Vec3>>(std::move(dirs));
+  last_points = sphere_points;
+  return last;
+}
+
+EmissionCache& EmissionCache::Default() {
+  static EmissionCache cache;
+  return cache;
+}
+
+std::optional<Emission> EmissionCache::Find(const EmissionKeyTuple& key) {
+  const std::lock_guard lock{mutex_};
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->first == key) {
+      entries_.splice(entries_.begin(), entries_, it);
+      auto e = it->second;
+      e.seconds = 0;
+      return e;
+    }
+  }
+  return std::nullopt;
+}
+
+void EmissionCache::Store(const EmissionKeyTuple& key,
+                          const Emission& emission) {
+  const std::lock_guard lock{mutex_};
+  std::erase_if(entries_,
+                [&](const auto& entry) { return entry.first == key; });
+  entries_.emplace_front(key, emission);
+  if (entries_.size() > kCapacity) {
+    entries_.pop_back();
+  }
+}
+
+void EmissionCache::Clear() {
+  const std::lock_guard lock{mutex_};
+  entries_.clear();
+}
@@ -0,0 +1,522 @@
+#include "modeling/twin_plasma_quartz.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "math/area.h"
+#include "math/consts/pi.h"
+#include "math/fast_pow.h"
+#include "math/linalg/vector.h"
+#include "modeling/energy_balance.h"
+#include "modeling/hollow_elliptic_cylinder.h"
+#include "modeling/parallel_for.h"
+#include "modeling/radial_mesh.h"
+#include "modeling/result_cache.h"
+#include "modeling/solid_cylinder.h"
+#include "modeling/solve_batch.h"
+#include "modeling/solve_monitor.h"
+#include "modeling/thread_pool.h"
+#include "modeling/worker.h"
+#include "physics/params/air.h"
+#include "physics/params/plasma.h"
+#include "physics/params/quartz.h"
+#include "physics/plancks_law.h"
+
+namespace {
+
+constexpr auto kOrigin = Vec3{};
+
+/// Излучают оба столба, левый — зеркальное отражение правого (x -> -x).
+/// Трассируется излучение правого с удвоенной интенсивностью: поглощённое
+/// в сумме по слоям обоих столбов и в целых кольцах кварца от этого не
+/// меняется.
+constexpr auto kColumns = 2;
+
+/// Номер тела, от поверхности которого идёт луч в газе: столб 0 (левый),
+/// столб 1 (правый) или трубка.
+constexpr std::size_t kTube = 2;
+
+/// Обратная запись j в двоичной системе как дробь из [0, 1).
+[[nodiscard]] Float RadicalInverse2(std::uint32_t j) {
+  j = (j << 16U) | (j >> 16U);
+  j = ((j & 0x00ff00ffU) << 8U) | ((j & 0xff00ff00U) >> 8U);
+  j = ((j & 0x0f0f0f0fU) << 4U) | ((j & 0xf0f0f0f0U) >> 4U);
+  j = ((j & 0x33333333U) << 2U) | ((j & 0xccccccccU) >> 2U);
+  j = ((j & 0x55555555U) << 1U) | ((j & 0xaaaaaaaaU) >> 1U);
+  return static_cast<Float>(static_cast<double>(j) * 0x1p-32);
+}
+
+[[nodiscard]] Vec3 RotateZ(Vec3 v, Float cos_phi, Float sin_phi) {
+  return {v.x() * cos_phi - v.y() * sin_phi, v.x() * sin_phi + v.y() * cos_phi,
+          v.z()};
+}
+
+/// Усечённое в кварце: absorbed.front() затем переносится в первое кольцо.
+void AddTruncatedQuartz(EnergyBalance& balance, const WorkerResult& res) {
+  balance.truncated_mirror += res.truncated_at_the_border;
+  balance.truncated_quartz += res.truncated;
+}
+
+}  // namespace
+
+class TwinPlasmaQuartz::Impl {
+ public:
+  Impl(const Params& params)
+      : Impl{params, MakeDirections(params.n_meridian * params.n_latitude)} {}
+
+  Impl(const Params& params, Directions dirs)
+      : params_{Checked(params)},
+        sphere_points_{params_.n_meridian * params_.n_latitude},
+        plasma_{MakePlasma(-1), MakePlasma(1)},
+        quartz_{
+            {.center = kOrigin,
+             .a_min = params.a,
+             .b_min = params.b,
+             .thickness = params.delta,
+             .steps = params.n_quartz,
+             .refractive_index = params.eta_quartz,
+             .refractive_index_internal = params.eta_gas,
+             .refractive_index_external = params::air::kEta,
+             .mirror_internal = kZero,
+             .mirror_external = params.rho},
+            [this](Float z) {
+              assert(0 <= z && z <= 1);
+              return params_.tw * std::pow(params_.t1 / params_.tw, z);
+            },
+            [this](Float t) { return func::I(params_.nu, params_.d_nu, t); },
+            [this](Float t) {
+              return params::quartz::AbsorptionCoefficient(params_.nu, t);
+            }},
+        dirs_{std::move(dirs)} {}
+
+  Result Solve(ThreadPool* pool, SolveMonitor* monitor = nullptr) {
+    auto r = SolveCached(
+        ResultCache::Default(), params_,
+        [&] {
+          return Transport(EmitCached(*this, params_, pool, monitor), pool,
+                           monitor);
+        },
+        monitor);
+    if (monitor != nullptr) {
+      monitor->Finish();
+    }
+    return r;
+  }
+
+  /// Первый проход: излучение столба по направлениям. Столб симметричен,
+  /// поэтому оно не зависит от точки его поверхности. Считается для столба
+  /// в начале координат — точно как у CylinderPlasma, с которым у него
+  /// общий EmissionCache.
+  [[nodiscard]] Emission Emit(ThreadPool* pool,
+                              SolveMonitor* monitor = nullptr) const {
+    const auto start = Clock::now();
+    Emission e{.is = std::vector<Float>(dirs_->size())};
+    const auto order = ChunkOrder(monitor);
+    std::atomic<bool> stopped{false};
+    if (monitor != nullptr) {
+      monitor->BeginStage(SolveStage::kEmission, dirs_->size());
+    }
+    const auto column = MakePlasma(0);
+    const Vec3 initial_pos{params_.r, kZero, kZero};
+    ParallelFor(
+        NChunks(), params_.n_threads,
+        [&](std::size_t task, std::size_t /*thread*/) {
+          const auto chunk = order.empty() ? task : order[task];
+          for (auto j = ChunkBegin(chunk); j < ChunkEnd(chunk); ++j) {
+            if (monitor != nullptr && monitor->stop_requested()) {
+              stopped = true;
+              return;
+            }
+            e.is[j] = column.CalculateIntensity(initial_pos, (*dirs_)[j],
+                                                sphere_points_);
+            if (monitor != nullptr) {
+              monitor->AddDone(1);
+            }
+          }
+        },
+        pool);
+    if (stopped) {
+      monitor->Cancel();
+    }
+
+    for (const auto i : e.is) {
+      e.intensity_all += i;
+      e.max_intensity = std::max(i, e.max_intensity);
+    }
+    e.seconds = Seconds(Clock::now() - start);
+    return e;
+  }
+
+  /// Трассировка и итоги по излучению e.
+  [[nodiscard]] Result Transport(const Emission& e,
+                                 ThreadPool* pool,
+                                 SolveMonitor* monitor = nullptr) const {
+    Result r{
+        .absorbed_plasma = std::vector<Float>(params_.n_plasma),
+        .absorbed_plasma3 = std::vector<Float>(params_.n_plasma),
+        .absorbed_quartz = std::vector<Float>(params_.n_quartz + 1),
+        .absorbed_quartz3 = std::vector<Float>(params_.n_quartz + 1),
+        .intensity_all = kColumns * e.intensity_all,
+    };
+
+    const auto n_chunks = NChunks();
+    const auto& is = e.is;
+    const auto intensity_end = params_.i_crit * kColumns * e.max_intensity;
+    const auto emitted = Clock::now();
+
+    // Частичные суммы по блокам складываются в порядке блоков, поэтому
+    // результат не зависит от числа потоков и порядка обхода блоков.
+    std::vector<Result> partials(n_chunks);
+    const auto order = ChunkOrder(monitor);
+    std::vector<Float> emitted_done(monitor != nullptr ? n_chunks : 0);
+    std::atomic<bool> stopped{false};
+    if (monitor != nullptr) {
+      monitor->BeginStage(SolveStage::kTransport, dirs_->size());
+    }
+    ParallelFor(
+        n_chunks, params_.n_threads,
+        [&](std::size_t task, std::size_t /*thread*/) {
+          const auto chunk = order.empty() ? task : order[task];
+          auto& partial = partials[chunk];
+          partial.absorbed_plasma.resize(params_.n_plasma);
+          partial.absorbed_quartz.resize(params_.n_quartz + 1);
+          for (auto j = ChunkBegin(chunk); j < ChunkEnd(chunk); ++j) {
+            const auto intensity = kColumns * is[j];
+            if (monitor != nullptr) {
+              if (monitor->stop_requested()) {
+                stopped = true;
+                return;
+              }
+              emitted_done[chunk] += intensity;
+            }
+            SolveRay(j, intensity, intensity_end, partial, monitor);
+            if (monitor != nullptr) {
+              monitor->AddDone(1);
+            }
+          }
+        },
+        pool);
+    for (const auto& partial : partials) {
+      for (std::size_t i = 0; i < params_.n_plasma; ++i) {
+        r.absorbed_plasma[i] += partial.absorbed_plasma[i];
+      }
+      for (std::size_t i = 0; i <= params_.n_quartz; ++i) {
+        r.absorbed_quartz[i] += partial.absorbed_quartz[i];
+      }
+      r.absorbed_mirror += partial.absorbed_mirror;
+      r.balance.truncated_plasma += partial.balance.truncated_plasma;
+      r.balance.truncated_quartz += partial.balance.truncated_quartz;
+      r.balance.truncated_mirror += partial.balance.truncated_mirror;
+    }
+    if (stopped) {
+      const auto scale = monitor->Stop(r.intensity_all, emitted_done);
+      for (auto& ap : r.absorbed_plasma) {
+        ap *= scale;
+      }
+      for (auto& aq : r.absorbed_quartz) {
+        aq *= scale;
+      }
+      r.absorbed_mirror *= scale;
+      r.balance.truncated_plasma *= scale;
+      r.balance.truncated_quartz *= scale;
+      r.balance.truncated_mirror *= scale;
+    }
+    const auto transported = Clock::now();
+
+    r.absorbed_quartz[1] += r.absorbed_quartz.front();
+    r.absorbed_quartz.front() = 0;
+
+    r.balance.absorbed_plasma = std::accumulate(
+        r.absorbed_plasma.begin(), r.absorbed_plasma.end(), kZero);
+    r.balance.absorbed_quartz = std::accumulate(
+        r.absorbed_quartz.begin(), r.absorbed_quartz.end(), kZero);
+    r.balance.absorbed_mirror = r.absorbed_mirror;
+    CheckEnergyBalance(r.balance, r.intensity_all, params_.energy_tolerance);
+
+    r.absorbed_plasma3 =
+        ShellDensities(r.absorbed_plasma, kZero, plasma_[0].params().radii);
+    for (auto& ap3 : r.absorbed_plasma3) {
+      ap3 /= kColumns;
+    }
+
+    // Как 2 pi absorbed / r_avg у круглой трубки, где площадь кольца
+    // 2 pi r_avg step заменена точной площадью эллиптического.
+    const auto step_quartz =
+        params_.delta / static_cast<Float>(params_.n_quartz);
+    auto inner = area::Of({.a = params_.a, .b = params_.b});
+    for (std::size_t i = 0; i < params_.n_quartz; ++i) {
+      const auto d = step_quartz * static_cast<Float>(i + 1);
+      const auto outer = area::Of({.a = params_.a + d, .b = params_.b + d});
+      r.absorbed_quartz3[i + 1] = Sqr(2 * consts::kPi) * step_quartz *
+                                  r.absorbed_quartz[i + 1] / (outer - inner);
+      inner = outer;
+    }
+
+    r.timings = {
+        .emission = e.seconds,
+        .transport = Seconds(transported - emitted),
+        .post = Seconds(Clock::now() - transported),
+    };
+    return r;
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::size_t kChunkSize = 64;
+
+  [[nodiscard]] static double Seconds(Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+  }
+
+  [[nodiscard]] static const Params& Checked(const Params& params) {
+    const auto x = params.r + params.gap / 2;
+    if (params.gap < 0 ||
+        !area::Contains({.a = params.a, .b = params.b},
+                        {.x = x, .r = params.r})) {
+      throw std::invalid_argument(
+          "Plasma columns must not overlap and must fit into the tube");
+    }
+    return params;
+  }
+
+  [[nodiscard]] SolidCylinder MakePlasma(Float side) const {
+    return {{.center = {side * (params_.r + params_.gap / 2), kZero, kZero},
+             .radius = params_.r,
+             .steps = params_.n_plasma,
+             .refractive_index = params_.eta_plasma,
+             .refractive_index_external = params_.eta_gas,
+             .mirror = kZero,
+             .radii = PlasmaRadii(params_)},
+            [this](Float z) {
+              assert(0 <= z && z <= 1);
+              return params_.t0 +
+                     (params_.tw - params_.t0) * FastPow(z, params_.m);
+            },
+            [this](Float t) { return func::I(params_.nu, params_.d_nu, t); },
+            [this](Float t) {
+              return params::plasma::AbsorptionCoefficient(params_.nu, t);
+            }};
+  }
+
+  [[nodiscard]] static std::size_t ChunkBegin(std::size_t chunk) {
+    return chunk * kChunkSize;
+  }
+
+  [[nodiscard]] std::size_t ChunkEnd(std::size_t chunk) const {
+    return std::min(ChunkBegin(chunk) + kChunkSize, dirs_->size());
+  }
+
+  [[nodiscard]] std::size_t NChunks() const {
+    return (dirs_->size() + kChunkSize - 1) / kChunkSize;
+  }
+
+  /// С наблюдателем блоки обходятся вразброс (SpreadOrder), чтобы
+  /// пройденные до остановки покрывали всю сферу; пусто — по порядку.
+  [[nodiscard]] std::vector<std::size_t> ChunkOrder(
+      const SolveMonitor* monitor) const {
+    return monitor != nullptr ? SpreadOrder(NChunks())
+                              : std::vector<std::size_t>{};
+  }
+
+  /// Луч в газе и тело, от поверхности которого он идёт.
+  struct GasRay {
+    WorkerParams ray;
+    std::size_t from;
+  };
+
+  /// Направление jj выходит из точки правого столба на азимуте
+  /// RadicalInverse2(jj): у одиночного столба все точки поверхности
+  /// равноправны, здесь — нет.
+  void SolveRay(std::size_t jj,
+                Float intensity,
+                Float intensity_end,
+                Result& r,
+                SolveMonitor* monitor) const {
+    std::vector<GasRay> wait_gas;
+    std::array<std::vector<WorkerParams>, 2> wait_plasma;
+    std::vector<WorkerParams> wait_quartz;
+
+    const auto ray = static_cast<std::uint32_t>(jj);
+    const auto phi = 2 * consts::kPi * RadicalInverse2(ray);
+    const auto cos_phi = std::cos(phi);
+    const auto sin_phi = std::sin(phi);
+    wait_gas.push_back(
+        {{plasma_[1].params().center +
+              RotateZ({params_.r, kZero, kZero}, cos_phi, sin_phi),
+          RotateZ((*dirs_)[jj], cos_phi, sin_phi), intensity, intensity_end,
+          false, ray},
+         1});
+
+    // Длина очередей каскада для monitor: изменение с прошлого отчёта.
+    std::size_t queued = 0;
+    const auto report = [&] {
+      if (monitor != nullptr) {
+        const auto now = wait_gas.size() + wait_plasma[0].size() +
+                         wait_plasma[1].size() + wait_quartz.size();
+        monitor->AddQueued(now - queued);
+        queued = now;
+      }
+    };
+    report();
+
+    while (!wait_gas.empty() || !wait_plasma[0].empty() ||
+           !wait_plasma[1].empty() || !wait_quartz.empty()) {
+      while (!wait_gas.empty()) {
+        const auto last = wait_gas.back();
+        wait_gas.pop_back();
+        SolveGas(last, wait_plasma, wait_quartz, r);
+        report();
+      }
+
+      for (std::size_t k = 0; k < plasma_.size(); ++k) {
+        while (!wait_plasma[k].empty()) {
+          const auto last = wait_plasma[k].back();
+          wait_plasma[k].pop_back();
+
+          auto res = plasma_[k].SolveDir(last);
+          r.absorbed_plasma.back() += res.absorbed_at_the_border;
+          r.balance.truncated_plasma +=
+              res.truncated + res.truncated_at_the_border;
+          static_assert(std::is_trivially_copyable_v<WorkerParams>);
+          for (auto released : res.released_rays) {
+            assert(!released.use_prev);
+            wait_gas.push_back({released, k});
+          }
+
+          assert(r.absorbed_plasma.size() == res.absorbed.size());
+          for (size_t i = 0; i < res.absorbed.size(); ++i) {
+            r.absorbed_plasma[i] += res.absorbed[i];
+          }
+          report();
+        }
+      }
+
+      while (!wait_quartz.empty()) {
+        const auto last = wait_quartz.back();
+        wait_quartz.pop_back();
+
+        auto res = quartz_.SolveDir(last);
+        r.absorbed_mirror += res.absorbed_at_the_border;
+        AddTruncatedQuartz(r.balance, res);
+        for (auto released : res.released_rays) {
+          if (!released.use_prev) {
+            r.absorbed_mirror += released.intensity;
+          } else {
+            wait_gas.push_back({released, kTube});
+          }
+        }
+
+        assert(r.absorbed_quartz.size() == res.absorbed.size());
+        for (size_t i = 0; i < res.absorbed.size(); ++i) {
+          r.absorbed_quartz[i] += res.absorbed[i];
+        }
+        report();
+      }
+    }
+  }
+
+  /// Ведёт луч в газе до поглощения по intensity_end: на каждой встреченной
+  /// поверхности преломлённая часть уходит в очередь тела, отражённая
+  /// идёт дальше. Выпуклое тело, от которого луч идёт, он не встретит.
+  void SolveGas(GasRay gas,
+                std::array<std::vector<WorkerParams>, 2>& wait_plasma,
+                std::vector<WorkerParams>& wait_quartz,
+                Result& r) const {
+    auto& [p, from] = gas;
+    const auto& tube = quartz_.cylinders.front();
+    for (;;) {
+      auto t = from == kTube ? tube.IntersectCurr(p.pos, p.dir)
+                             : tube.Intersect(p.pos, p.dir);
+      assert(t > 0);
+      auto hit = kTube;
+      for (std::size_t k = 0; k < plasma_.size(); ++k) {
+        if (k == from) {
+          continue;
+        }
+        const auto t_k = plasma_[k].cylinders.back().Intersect(p.pos, p.dir);
+        if (t_k > 0 && t_k < t) {
+          t = t_k;
+          hit = k;
+        }
+      }
+      p.pos += t * p.dir;
+
+      const auto to_tube = hit == kTube;
+      const auto& shape = to_tube
+                              ? static_cast<const Shape&>(tube)
+                              : plasma_[hit].cylinders.back();
+      const auto eta_t = to_tube ? params_.eta_quartz : params_.eta_plasma;
+      const auto res = shape.Refract(p.pos, p.dir, params_.eta_gas, eta_t,
+                                     kZero, to_tube);
+
+      // Ниже intensity_end остаток поглощается телом на границе.
+      auto& absorbed = to_tube ? r.absorbed_quartz[1]
+                               : r.absorbed_plasma.back();
+      auto& truncated = to_tube ? r.balance.truncated_quartz
+                                : r.balance.truncated_plasma;
+      if (res.T > 0) {
+        if (const auto new_i = p.intensity * res.T; new_i > p.intensity_end) {
+          const WorkerParams refracted{p.pos, res.refracted, new_i,
+                                       p.intensity_end, !to_tube, p.ray};
+          if (to_tube) {
+            wait_quartz.push_back(refracted);
+          } else {
+            wait_plasma[hit].push_back(refracted);
+          }
+        } else {
+          absorbed += new_i;
+          truncated += new_i;
+        }
+      }
+
+      p.dir = res.reflected;
+      p.intensity *= res.R;
+      from = hit;
+      if (p.intensity <= p.intensity_end) {
+        absorbed += p.intensity;
+        truncated += p.intensity;
+        return;
+      }
+    }
+  }
+
+  Params params_;
+  std::size_t sphere_points_;
+
+  std::array<SolidCylinder, 2> plasma_;
+  HollowEllipticCylinder quartz_;
+  Directions dirs_;
+};
+
+TwinPlasmaQuartz::TwinPlasmaQuartz(const Params& params) : pimpl_{params} {}
+
+TwinPlasmaQuartz::~TwinPlasmaQuartz() = default;
+
+auto TwinPlasmaQuartz::Solve() -> Result {
+  return pimpl_->Solve(nullptr);
+}
+
+auto TwinPlasmaQuartz::Solve(ThreadPool& pool) -> Result {
+  return pimpl_->Solve(&pool);
+}
+
+auto TwinPlasmaQuartz::Solve(SolveMonitor& monitor) -> Result {
+  return pimpl_->Solve(nullptr, &monitor);
+}
+
+auto TwinPlasmaQuartz::Solve(SolveMonitor& monitor, ThreadPool& pool)
+    -> Result {
+  return pimpl_->Solve(&pool, &monitor);
+}
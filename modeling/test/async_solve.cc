@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "band_params.h"
+#include "base/config/float.h"
+#include "modeling/async_solve.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/solve_batch.h"
+#include "modeling/solve_monitor.h"
+#include "modeling/thread_pool.h"
+
+namespace {
+
+template <typename Solver>
+void WaitFinished(const AsyncSweep<Solver>& sweep) {
+  while (!sweep.finished()) {
+    std::this_thread::yield();
+  }
+}
+
+TEST(SpreadOrderTest, IsPermutationWithSpreadPrefix) {
+  for (const auto n : {0UZ, 1UZ, 5UZ, 64UZ, 100UZ}) {
+    auto order = SpreadOrder(n);
+    ASSERT_EQ(order.size(), n);
+    // Первая половина задевает обе половины отрезка поровну.
+    std::size_t low = 0;
+    for (std::size_t i = 0; i < n / 2; ++i) {
+      low += order[i] < n / 2 ? 1U : 0U;
+    }
+    EXPECT_LE(2 * low, n / 2 + 2);
+    EXPECT_GE(2 * low + 2, n / 2);
+    std::ranges::sort(order);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(order[i], i);
+    }
+  }
+}
+
+TEST(SolveMonitorTest, MonitoredSolveMatchesSolve) {
+  const auto params = Band169<CylinderPlasmaQuartz::Params>(16);
+  SolveMonitor monitor;
+  // Оба решения проходят этап излучения сами.
+  EmissionCache::Default().Clear();
+  const auto r = CylinderPlasmaQuartz{params}.Solve(monitor);
+  EmissionCache::Default().Clear();
+  const auto expected = CylinderPlasmaQuartz{params}.Solve();
+  EXPECT_EQ(r.absorbed_plasma, expected.absorbed_plasma);
+  EXPECT_EQ(r.absorbed_quartz, expected.absorbed_quartz);
+  EXPECT_EQ(r.absorbed_mirror, expected.absorbed_mirror);
+
+  const auto progress = monitor.progress();
+  EXPECT_EQ(progress.stage, SolveStage::kDone);
+  EXPECT_EQ(progress.directions_done, progress.directions_total);
+  EXPECT_GT(progress.directions_total, 0U);
+  EXPECT_EQ(progress.queued_rays, 0U);
+  EXPECT_FALSE(monitor.stopped());
+}
+
+TEST(SolveMonitorTest, StopBeforeStartThrows) {
+  std::stop_source stop;
+  stop.request_stop();
+  SolveMonitor monitor{stop.get_token(), true};
+  EXPECT_THROW(
+      (void)CylinderPlasma{Band169<CylinderPlasma::Params>(16)}.Solve(monitor),
+      SolveCancelled);
+  EXPECT_TRUE(monitor.stopped());
+}
+
+TEST(AsyncSolveTest, MatchesSolve) {
+  const auto params = Band169<CylinderPlasma::Params>(20);
+  AsyncSolve<CylinderPlasma> solve{params};
+  const auto r = solve.Get();
+  EXPECT_TRUE(solve.ready());
+  EXPECT_FALSE(solve.stopped());
+  EXPECT_EQ(r.absorbed_plasma, CylinderPlasma{params}.Solve().absorbed_plasma);
+  EXPECT_EQ(solve.progress().stage, SolveStage::kDone);
+}
+
+TEST(AsyncSolveTest, CancelReturnsPartialResult) {
+  auto params = Band169<CylinderPlasmaQuartz::Params>(120);
+  params.n_threads = 1;
+  const auto expected = CylinderPlasmaQuartz{params}.Solve();
+
+  AsyncSolve<CylinderPlasmaQuartz> solve{params, {.partial = true}};
+  // Остановка посреди трассировки.
+  for (;;) {
+    const auto p = solve.progress();
+    if (solve.ready() || (p.stage == SolveStage::kTransport &&
+                          p.directions_done * 3 >= p.directions_total)) {
+      break;
+    }
+    std::this_thread::yield();
+  }
+  solve.Cancel();
+  const auto r = solve.Get();
+
+  EXPECT_EQ(r.intensity_all, expected.intensity_all);
+  const auto sum = [](const std::vector<Float>& v) {
+    return std::accumulate(v.begin(), v.end(), Float{});
+  };
+  const auto plasma = sum(expected.absorbed_plasma);
+  const auto quartz = sum(expected.absorbed_quartz);
+  EXPECT_NEAR(sum(r.absorbed_plasma), plasma, 0.05 * plasma);
+  EXPECT_NEAR(sum(r.absorbed_quartz), quartz, 0.05 * quartz);
+  EXPECT_NEAR(r.balance.residual, 0, 1e-3 * r.intensity_all);
+  if (solve.stopped()) {
+    EXPECT_LT(solve.progress().directions_done,
+              solve.progress().directions_total);
+  }
+}
+
+TEST(AsyncSolveTest, CancelWithoutPartialThrows) {
+  AsyncSolve<CylinderPlasma> solve{Band169<CylinderPlasma::Params>(200)};
+  solve.Cancel();
+  try {
+    (void)solve.Get();
+    EXPECT_FALSE(solve.stopped());  // Успело досчитаться.
+  } catch (const SolveCancelled&) {
+    EXPECT_TRUE(solve.stopped());
+  }
+}
+
+TEST(AsyncSweepTest, MatchesSolve) {
+  std::vector<CylinderPlasmaQuartz::Params> params;
+  for (const auto band : {150UZ, 169UZ, 170UZ}) {
+    params.push_back(BandParams<CylinderPlasmaQuartz::Params>(band, 16));
+  }
+  ThreadPool pool{2};
+  AsyncSweep<CylinderPlasmaQuartz> sweep{params, pool, 2};
+  WaitFinished(sweep);
+  EXPECT_EQ(sweep.error(), nullptr);
+  EXPECT_EQ(sweep.done(), params.size());
+
+  auto done = sweep.Take();
+  ASSERT_EQ(done.size(), params.size());
+  EXPECT_TRUE(sweep.Take().empty());
+  std::ranges::sort(done, {}, &AsyncSweep<CylinderPlasmaQuartz>::Done::index);
+  for (std::size_t i = 0; i < params.size(); ++i) {
+    EXPECT_EQ(done[i].index, i);
+    const auto expected = CylinderPlasmaQuartz{params[i]}.Solve();
+    EXPECT_EQ(done[i].result.absorbed_plasma, expected.absorbed_plasma);
+    EXPECT_EQ(done[i].result.absorbed_quartz, expected.absorbed_quartz);
+  }
+}
+
+TEST(AsyncSweepTest, CancelStopsRemainingVariants) {
+  const std::vector params(8, Band169<CylinderPlasma::Params>(60));
+  ThreadPool pool{1};
+  AsyncSweep<CylinderPlasma> sweep{params, pool, 1};
+  sweep.Cancel();
+  WaitFinished(sweep);
+  EXPECT_EQ(sweep.error(), nullptr);
+  // Досчитаться успевают не все: остальные не начинаются.
+  EXPECT_LT(sweep.done(), params.size());
+  EXPECT_EQ(sweep.Take().size(), sweep.done());
+}
+
+}  // namespace
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+#include "base/config/float.h"
+#include "physics/absorption_table.h"
+
+/// Параметры решателя на полосе band таблицы AbsorptionTable::Default() с
+/// n x n направлениями на двух потоках; остальные поля — по умолчанию.
+template <typename Params>
+[[nodiscard]] Params BandParams(std::size_t band, std::size_t n) {
+  const auto center = AbsorptionTable::Default().BandCenter(band);
+  Params params;
+  params.nu = static_cast<Float>(center.nu);
+  params.d_nu = static_cast<Float>(center.d_nu);
+  params.n_meridian = n;
+  params.n_latitude = n;
+  params.n_threads = 2;
+  return params;
+}
+
+template <typename Params>
+[[nodiscard]] Params Band169(std::size_t n) {
+  return BandParams<Params>(169, n);
+}
@@ -0,0 +1,306 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/config/float.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/solve_batch.h"
+#include "physics/params/xenon_absorption_coefficient.h"
+
+// Эталонные результаты Solve. Эталон получен в сборке MT_USE_DOUBLE без
+// MT_ENABLE_UNSAFE_MATH_OPTIMIZATIONS; остальные конфигурации сверяются
+// с ним с допусками ниже.
+//
+// Обновление эталона (только в такой сборке):
+//   MT_GOLDEN_UPDATE=1 modeling_test --gtest_filter=GoldenUpdate.*
+// При несовместимом изменении формата или набора случаев увеличить
+// kGoldenVersion и переименовать файл.
+
+namespace {
+
+constexpr int kGoldenVersion = 1;
+
+/// Допуски относительно intensity_all: для сумм и для отдельных слоёв.
+struct Tolerance {
+  Float total;
+  Float shell;
+};
+
+#if defined(MT_USE_DOUBLE) && !defined(__FAST_MATH__)
+constexpr Tolerance kTolerance{.total = 1e-10_F, .shell = 1e-10_F};
+#elif defined(MT_USE_DOUBLE)
+constexpr Tolerance kTolerance{.total = 1e-6_F, .shell = 1e-6_F};
+#else
+constexpr Tolerance kTolerance{.total = 5e-3_F, .shell = 5e-3_F};
+#endif
+
+enum class Model {
+  kXe,
+  kXeSiO2,
+};
+
+struct GoldenCase {
+  std::string name;
+  Model model;
+  std::size_t band;
+  Float r = 0.35_F;
+  std::size_t n_plasma = 40;
+  Float delta = 0.1_F;
+  std::size_t n_quartz = 15;
+  int m = 4;
+  Float t1 = 700.0_F;
+  std::size_t n = 30;  ///< n_meridian = n_latitude.
+};
+
+void PrintTo(const GoldenCase& c, std::ostream* os) {
+  *os << c.name;
+}
+
+struct Golden {
+  Float intensity_all{};
+  Float absorbed_mirror{};
+  std::vector<Float> absorbed_plasma;
+  std::vector<Float> absorbed_quartz;
+};
+
+// Быстрые полосы: оптически толстая, промежуточная и почти прозрачная
+// (в последней плазма ничего не поглощает).
+const std::vector<GoldenCase> kCases = {
+    {.name = "xe_169", .model = Model::kXe, .band = 169},
+    {.name = "xe_150_r05_m8",
+     .model = Model::kXe,
+     .band = 150,
+     .r = 0.5_F,
+     .n_plasma = 20,
+     .m = 8},
+    {.name = "xesio2_169", .model = Model::kXeSiO2, .band = 169},
+    {.name = "xesio2_190_thick",
+     .model = Model::kXeSiO2,
+     .band = 190,
+     .delta = 0.2_F,
+     .n_quartz = 10,
+     .t1 = 900.0_F},
+    {.name = "xesio2_185", .model = Model::kXeSiO2, .band = 185, .n = 16},
+};
+
+constexpr std::size_t kThreads = 4;
+
+[[nodiscard]] Golden SolveCase(const GoldenCase& c, std::size_t n_threads) {
+  const auto nu_min = kXenonFrequency[c.band];
+  const auto nu_max = kXenonFrequency[c.band + 1];
+  const auto nu = (nu_min + nu_max) / 2;
+  const auto d_nu = nu_max - nu_min;
+
+  if (c.model == Model::kXe) {
+    const auto r = CylinderPlasma{{
+                                      .r = c.r,
+                                      .n_plasma = c.n_plasma,
+                                      .m = c.m,
+                                      .nu = nu,
+                                      .d_nu = d_nu,
+                                      .n_meridian = c.n,
+                                      .n_latitude = c.n,
+                                      .n_threads = n_threads,
+                                      .energy_tolerance = kTolerance.total,
+                                  }}
+                       .Solve();
+    return {
+        .intensity_all = r.intensity_all,
+        .absorbed_mirror = r.absorbed_mirror,
+        .absorbed_plasma = r.absorbed_plasma,
+        .absorbed_quartz = {},
+    };
+  }
+
+  const auto r = CylinderPlasmaQuartz{{
+                                          .r = c.r,
+                                          .n_plasma = c.n_plasma,
+                                          .delta = c.delta,
+                                          .n_quartz = c.n_quartz,
+                                          .m = c.m,
+                                          .t1 = c.t1,
+                                          .nu = nu,
+                                          .d_nu = d_nu,
+                                          .n_meridian = c.n,
+                                          .n_latitude = c.n,
+                                          .n_threads = n_threads,
+                                          .energy_tolerance = kTolerance.total,
+                                      }}
+                     .Solve();
+  return {
+      .intensity_all = r.intensity_all,
+      .absorbed_mirror = r.absorbed_mirror,
+      .absorbed_plasma = r.absorbed_plasma,
+      .absorbed_quartz = r.absorbed_quartz,
+  };
+}
+
+void WriteVector(std::ostream& out,
+                 std::string_view key,
+                 const std::vector<Float>& values) {
+  out << key << ' ' << values.size();
+  for (const auto value : values) {
+    out << std::format(" {:.17g}", value);
+  }
+  out << '\n';
+}
+
+[[nodiscard]] std::vector<Float> ReadVector(std::istream& in) {
+  std::size_t n{};
+  in >> n;
+  std::vector<Float> values(n);
+  for (auto& value : values) {
+    double v{};
+    in >> v;
+    value = static_cast<Float>(v);
+  }
+  return values;
+}
+
+[[nodiscard]] Float ReadValue(std::istream& in) {
+  double v{};
+  in >> v;
+  return static_cast<Float>(v);
+}
+
+/// Формат файла:
+///   version <N>
+///   case <name>
+///   intensity_all <value>
+///   absorbed_mirror <value>
+///   absorbed_plasma <n> <values...>
+///   absorbed_quartz <n> <values...>
+[[nodiscard]] std::map<std::string, Golden> ReadGolden(
+    const std::string& path) {
+  std::ifstream in{path};
+  if (!in) {
+    ADD_FAILURE() << "Can't open " << path;
+    return {};
+  }
+
+  std::string key;
+  int version{};
+  in >> key >> version;
+  if (key != "version" || version != kGoldenVersion) {
+    ADD_FAILURE() << path << ": expected version " << kGoldenVersion;
+    return {};
+  }
+
+  std::map<std::string, Golden> goldens;
+  Golden* golden = nullptr;
+  while (in >> key) {
+    if (key == "case") {
+      in >> key;
+      golden = &goldens[key];
+    } else if (golden == nullptr) {
+      ADD_FAILURE() << path << ": '" << key << "' outside of case";
+      return {};
+    } else if (key == "intensity_all") {
+      golden->intensity_all = ReadValue(in);
+    } else if (key == "absorbed_mirror") {
+      golden->absorbed_mirror = ReadValue(in);
+    } else if (key == "absorbed_plasma") {
+      golden->absorbed_plasma = ReadVector(in);
+    } else if (key == "absorbed_quartz") {
+      golden->absorbed_quartz = ReadVector(in);
+    } else {
+      ADD_FAILURE() << path << ": unknown key '" << key << "'";
+      return {};
+    }
+  }
+  return goldens;
+}
+
+[[nodiscard]] const std::map<std::string, Golden>& Goldens() {
+  static const auto goldens = ReadGolden(MT_GOLDEN_DATA);
+  return goldens;
+}
+
+void ExpectVectorNear(const std::vector<Float>& actual,
+                      const std::vector<Float>& expected,
+                      Float abs_error) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_NEAR(actual[i], expected[i], abs_error) << "shell " << i;
+  }
+}
+
+class GoldenTest : public testing::TestWithParam<GoldenCase> {};
+
+TEST_P(GoldenTest, MatchesReference) {
+  const auto& c = GetParam();
+  const auto it = Goldens().find(c.name);
+  ASSERT_NE(it, Goldens().end()) << "No reference for " << c.name;
+  const auto& expected = it->second;
+
+  const auto actual = SolveCase(c, kThreads);
+
+  const auto scale = expected.intensity_all;
+  EXPECT_NEAR(actual.intensity_all, scale, kTolerance.total * scale);
+  EXPECT_NEAR(actual.absorbed_mirror, expected.absorbed_mirror,
+              kTolerance.total * scale);
+  ExpectVectorNear(actual.absorbed_plasma, expected.absorbed_plasma,
+                   kTolerance.shell * scale);
+  ExpectVectorNear(actual.absorbed_quartz, expected.absorbed_quartz,
+                   kTolerance.shell * scale);
+}
+
+TEST_P(GoldenTest, IndependentOfThreads) {
+  const auto& c = GetParam();
+  // Излучение тоже сравнивается: кешированное не подходит.
+  EmissionCache::Default().Clear();
+  const auto single = SolveCase(c, 1);
+  EmissionCache::Default().Clear();
+  const auto multi = SolveCase(c, kThreads);
+
+  EXPECT_EQ(single.intensity_all, multi.intensity_all);
+  EXPECT_EQ(single.absorbed_mirror, multi.absorbed_mirror);
+  EXPECT_EQ(single.absorbed_plasma, multi.absorbed_plasma);
+  EXPECT_EQ(single.absorbed_quartz, multi.absorbed_quartz);
+}
+
+INSTANTIATE_TEST_SUITE_P(Cases,
+                         GoldenTest,
+                         testing::ValuesIn(kCases),
+                         [](const auto& case_info) {
+                           return case_info.param.name;
+                         });
+
+TEST(GoldenUpdate, Write) {
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  if (std::getenv("MT_GOLDEN_UPDATE") == nullptr) {
+    GTEST_SKIP() << "Set MT_GOLDEN_UPDATE to rewrite " << MT_GOLDEN_DATA;
+  }
+#if !defined(MT_USE_DOUBLE) || defined(__FAST_MATH__)
+  GTEST_FAIL() << "Reference must come from a double build without "
+                  "unsafe math optimizations";
+#endif
+
+  std::ostringstream out;
+  out << "version " << kGoldenVersion << '\n';
+  for (const auto& c : kCases) {
+    const auto golden = SolveCase(c, kThreads);
+    out << "\ncase " << c.name << '\n';
+    out << std::format("intensity_all {:.17g}\n", golden.intensity_all);
+    out << std::format("absorbed_mirror {:.17g}\n", golden.absorbed_mirror);
+    WriteVector(out, "absorbed_plasma", golden.absorbed_plasma);
+    WriteVector(out, "absorbed_quartz", golden.absorbed_quartz);
+  }
+
+  std::ofstream file{MT_GOLDEN_DATA};
+  ASSERT_TRUE(file) << "Can't open " << MT_GOLDEN_DATA;
+  file << out.str();
+}
+
+}  // namespace
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "modeling/parallel_for.h"
+#include "modeling/thread_pool.h"
+
+namespace {
+
+constexpr std::size_t kTasks = 1000;
+
+TEST(ParallelForTest, RunsEachTaskOnce) {
+  for (const auto n_threads : {0UZ, 1UZ, 3UZ, 8UZ}) {
+    std::vector<std::atomic<int>> counts(kTasks);
+    std::atomic<bool> bad_thread{false};
+    ParallelFor(kTasks, n_threads, [&](std::size_t task, std::size_t thread) {
+      ++counts[task];
+      if (thread >= std::max(n_threads, 1UZ)) {
+        bad_thread = true;
+      }
+    });
+    for (const auto& count : counts) {
+      EXPECT_EQ(count, 1);
+    }
+    EXPECT_FALSE(bad_thread);
+  }
+}
+
+TEST(ParallelForTest, RunsEachTaskOnceOnPool) {
+  ThreadPool pool{2};
+  std::vector<std::atomic<int>> counts(kTasks);
+  std::atomic<bool> bad_thread{false};
+  ParallelFor(
+      kTasks, 8,
+      [&](std::size_t task, std::size_t thread) {
+        ++counts[task];
+        // Не больше pool.size() помощников.
+        if (thread > pool.size()) {
+          bad_thread = true;
+        }
+      },
+      &pool);
+  for (const auto& count : counts) {
+    EXPECT_EQ(count, 1);
+  }
+  EXPECT_FALSE(bad_thread);
+}
+
+TEST(ParallelForTest, NestedOnBusyPoolCompletes) {
+  ThreadPool pool{2};
+  std::atomic<std::size_t> total{0};
+  ParallelFor(
+      8, 8,
+      [&](std::size_t /*task*/, std::size_t /*thread*/) {
+        ParallelFor(
+            100, 4,
+            [&](std::size_t /*task*/, std::size_t /*thread*/) { ++total; },
+            &pool);
+      },
+      &pool);
+  EXPECT_EQ(total, 800);
+}
+
+TEST(ParallelForTest, RethrowsFirstException) {
+  ThreadPool pool{3};
+  for (auto* p : {static_cast<ThreadPool*>(nullptr), &pool}) {
+    EXPECT_THROW(ParallelFor(
+                     kTasks, 4,
+                     [](std::size_t task, std::size_t /*thread*/) {
+                       if (task == kTasks / 2) {
+                         throw std::runtime_error("task");
+                       }
+                     },
+                     p),
+                 std::runtime_error);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "band_params.h"
+#include "base/config/float.h"
+#include "math/consts/pi.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/radial_mesh.h"
+#include "modeling/solid_cylinder.h"
+
+namespace {
+
+[[nodiscard]] Float Sum(const std::vector<Float>& v) {
+  return std::accumulate(v.begin(), v.end(), kZero);
+}
+
+constexpr Float kRadius = 0.35_F;
+
+/// Профиль с m = 8: ровное ядро и резкий спад у стенки.
+[[nodiscard]] Float Temperature(Float z) {
+  return 10000 + (2000 - 10000) * std::pow(z, 8.0_F);
+}
+
+[[nodiscard]] Float Attenuation(Float t) {
+  return 30 * std::pow(t / 10000, 3.0_F);
+}
+
+struct Shell {
+  Float depth{};
+  Float dt{};
+};
+
+/// Оптическая толщина и перепад температуры каждого слоя.
+[[nodiscard]] std::vector<Shell> Measure(const std::vector<Float>& radii) {
+  constexpr std::size_t kSteps = 256;
+  std::vector<Shell> shells;
+  Float inner = 0;
+  for (const auto outer : radii) {
+    const auto h = (outer - inner) / kSteps;
+    Shell shell{.dt = std::abs(Temperature(outer / kRadius) -
+                               Temperature(inner / kRadius))};
+    for (std::size_t i = 0; i < kSteps; ++i) {
+      const auto r = inner + h * (static_cast<Float>(i) + 0.5_F);
+      shell.depth += Attenuation(Temperature(r / kRadius)) * h;
+    }
+    shells.push_back(shell);
+    inner = outer;
+  }
+  return shells;
+}
+
+[[nodiscard]] bool Within(const std::vector<Float>& radii,
+                          const AdaptiveMesh& mesh) {
+  constexpr auto kSlack = 1.01_F;  // Разрешение мелкой сетки.
+  return std::ranges::all_of(Measure(radii), [&](const Shell& shell) {
+    return shell.depth <= mesh.max_depth * kSlack &&
+           shell.dt <= mesh.max_dt * kSlack;
+  });
+}
+
+TEST(RadialMeshTest, UniformMatchesStep) {
+  const auto radii = GradedRadii(0.35_F, 0.45_F, 4, 1);
+  const auto step = (0.45_F - 0.35_F) / 4;
+  EXPECT_EQ(radii, (std::vector<Float>{0.35_F + step, 0.35_F + step * 2,
+                                       0.35_F + step * 3, 0.45_F}));
+}
+
+TEST(RadialMeshTest, GeometricWidthsReachRatio) {
+  constexpr std::size_t kN = 10;
+  const auto radii = GradedRadii(0, 0.35_F, kN, 0.1_F);
+  ASSERT_EQ(radii.size(), kN);
+  EXPECT_EQ(radii.back(), 0.35_F);
+
+  Float inner = 0;
+  std::vector<Float> widths;
+  for (const auto radius : radii) {
+    widths.push_back(radius - inner);
+    inner = radius;
+  }
+  for (std::size_t i = 1; i < kN; ++i) {
+    EXPECT_LT(widths[i], widths[i - 1]);
+  }
+  EXPECT_NEAR(widths.back() / widths.front(), 0.1_F, 1e-4_F);
+}
+
+TEST(RadialMeshTest, RejectsBadMesh) {
+  EXPECT_THROW(static_cast<void>(GradedRadii(0, 1, 0, 1)),
+               std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(GradedRadii(0, 1, 4, 0)),
+               std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(GradedRadii(0, 1, 4, -2)),
+               std::invalid_argument);
+}
+
+TEST(RadialMeshTest, DensitiesOnUniformMeshMatchRingFormula) {
+  constexpr std::size_t kN = 8;
+  const auto radii = GradedRadii(0, 0.35_F, kN, 1);
+  const std::vector<Float> absorbed(kN, 2);
+  const auto densities = ShellDensities(absorbed, 0, radii);
+  const auto step = 0.35_F / kN;
+  for (std::size_t i = 0; i < kN; ++i) {
+    const auto r_avg = step * (static_cast<Float>(i) + 0.5_F);
+    EXPECT_NEAR(densities[i], 2 * consts::kPi * absorbed[i] / r_avg,
+                1e-4_F * densities[i]);
+  }
+}
+
+TEST(RadialMeshTest, AdaptiveShellsMeetBounds) {
+  constexpr AdaptiveMesh kMesh{.max_depth = 0.5_F, .max_dt = 200};
+  const auto radii = AdaptiveRadii(kRadius, Temperature, Attenuation, kMesh);
+  ASSERT_GE(radii.size(), 2);
+  EXPECT_EQ(radii.back(), kRadius);
+  EXPECT_TRUE(std::ranges::is_sorted(radii));
+  EXPECT_TRUE(Within(radii, kMesh));
+
+  // Ядро редкое, у стенки слои мельче.
+  EXPECT_GT(radii[0], 10 * (radii.back() - radii[radii.size() - 2]));
+
+  // Равной сетке для тех же требований мало и втрое больше слоёв.
+  const auto n_uniform = 3 * radii.size();
+  EXPECT_FALSE(Within(GradedRadii(0, kRadius, n_uniform, 1), kMesh));
+}
+
+TEST(RadialMeshTest, AdaptiveMeshOfFlatProfileIsUniform) {
+  const auto radii = AdaptiveRadii(
+      kRadius, [](Float) { return 5000.0_F; }, [](Float) { return 10.0_F; },
+      {.max_depth = 0.6_F, .max_dt = 200});
+  // Оптическая толщина столба 3.5: шесть равных слоёв не толще 0.6.
+  ASSERT_EQ(radii.size(), 6);
+  for (std::size_t i = 0; i < radii.size(); ++i) {
+    EXPECT_NEAR(radii[i], kRadius * static_cast<Float>(i + 1) / 6, 1e-5_F);
+  }
+}
+
+TEST(RadialMeshTest, AdaptiveMeshBoundsShellsNotSamples) {
+  // Ступени по 1000 К посреди восьмых долей радиуса при оптической
+  // толщине столба 8: каждому слою хватает одной ступени и толщины 1.01.
+  // Сумма по отрезкам большей из долей (~16) дала бы вдвое больше слоёв.
+  const auto radii = AdaptiveRadii(
+      kRadius,
+      [](Float z) { return 5000 + 1000 * std::floor(z * 8 + 0.5_F); },
+      [](Float) { return 8 / kRadius; }, {.max_depth = 1.01_F, .max_dt = 1000});
+  ASSERT_EQ(radii.size(), 8);
+  Float inner = 0;
+  for (std::size_t i = 0; i < radii.size(); ++i) {
+    // Ступень (2 i + 1) / 16 внутри слоя i.
+    const auto step = kRadius * static_cast<Float>(2 * i + 1) / 16;
+    EXPECT_LT(inner, step) << i;
+    EXPECT_GT(radii[i], step) << i;
+    inner = radii[i];
+  }
+}
+
+TEST(RadialMeshTest, AdaptiveMeshFeedsSolidCylinder) {
+  auto radii = AdaptiveRadii(kRadius, Temperature, Attenuation, {}, 12);
+  ASSERT_EQ(radii.size(), 12);
+  const SolidCylinder plasma{{.center = {},
+                              .radius = kRadius,
+                              .steps = radii.size(),
+                              .refractive_index = 1,
+                              .refractive_index_external = 1,
+                              .radii = std::move(radii)},
+                             Temperature,
+                             [](Float t) { return t; },
+                             Attenuation};
+  ASSERT_EQ(plasma.cylinders.size(), 12);
+  EXPECT_EQ(plasma.params().radii.back(), kRadius);
+  EXPECT_TRUE(std::ranges::is_sorted(plasma.temperatures,
+                                     std::ranges::greater{}));
+}
+
+TEST(RadialMeshTest, RejectsBadAdaptiveMesh) {
+  EXPECT_THROW(static_cast<void>(AdaptiveRadii(kRadius, Temperature,
+                                               Attenuation, {.max_depth = 0})),
+               std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(AdaptiveRadii(kRadius, Temperature,
+                                               Attenuation, {.max_dt = -1})),
+               std::invalid_argument);
+}
+
+TEST(RadialMeshTest, GradedSolveBalancesEnergy) {
+  auto params = Band169<CylinderPlasmaQuartz::Params>(30);
+  params.n_plasma = 20;
+  params.n_quartz = 8;
+  params.plasma_grading = 0.2_F;
+  params.quartz_grading = 0.3_F;
+  params.energy_tolerance = 1e-3_F;
+  const auto r = CylinderPlasmaQuartz{params}.Solve();
+
+  ASSERT_EQ(r.absorbed_plasma3.size(), params.n_plasma);
+  ASSERT_EQ(r.absorbed_quartz3.size(), params.n_quartz + 1);
+  EXPECT_EQ(r.absorbed_quartz.front(), 0);
+  EXPECT_EQ(r.absorbed_quartz3.front(), 0);
+  EXPECT_NEAR(Sum(r.absorbed_plasma) + Sum(r.absorbed_quartz) +
+                  r.absorbed_mirror,
+              r.intensity_all, 1e-3_F * r.intensity_all);
+
+  // Сгущённая к стенке сетка из 20 слоёв ближе к равной из 80, чем равная
+  // из тех же 20.
+  const auto plasma = [](const CylinderPlasmaQuartz::Params& p) {
+    const auto result = CylinderPlasmaQuartz{p}.Solve();
+    return Sum(result.absorbed_plasma) / result.intensity_all;
+  };
+  auto uniform = params;
+  uniform.plasma_grading = 1;
+  uniform.quartz_grading = 1;
+  auto fine = uniform;
+  fine.n_plasma = 80;
+  fine.n_quartz = 30;
+  const auto expected = plasma(fine);
+  EXPECT_LT(std::abs(Sum(r.absorbed_plasma) / r.intensity_all - expected),
+            std::abs(plasma(uniform) - expected));
+}
+
+TEST(RadialMeshTest, AdaptiveSolveBalancesEnergy) {
+  auto params = Band169<CylinderPlasmaQuartz::Params>(30);
+  params.n_plasma = 20;
+  params.m = 8;
+  params.adaptive_plasma = true;
+  params.energy_tolerance = 1e-3_F;
+
+  const auto radii = PlasmaRadii(params);
+  ASSERT_EQ(radii.size(), params.n_plasma);
+  EXPECT_EQ(radii.back(), params.r);
+  // Ровное ядро профиля m = 8 остаётся редким.
+  EXPECT_GT(radii.front(), params.r / static_cast<Float>(params.n_plasma));
+
+  const auto r = CylinderPlasmaQuartz{params}.Solve();
+  ASSERT_EQ(r.absorbed_plasma3.size(), params.n_plasma);
+  EXPECT_NEAR(Sum(r.absorbed_plasma) + Sum(r.absorbed_quartz) +
+                  r.absorbed_mirror,
+              r.intensity_all, 1e-3_F * r.intensity_all);
+}
+
+}  // namespace
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "base/config/float.h"
+#include "modeling/ray_path.h"
+#include "ray_tracing/cylinder_z_infinite.h"
+
+namespace {
+
+class RayPathTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    const auto* info = testing::UnitTest::GetInstance()->current_test_info();
+    path_ = std::filesystem::temp_directory_path() /
+            (std::string{"mt_ray_path_test_"} + info->name());
+  }
+
+  void TearDown() override { std::filesystem::remove(path_); }
+
+  std::filesystem::path path_;
+};
+
+const std::vector<CylinderZInfinite> kPlasma{{{}, 0.1_F}, {{}, 0.35_F}};
+const std::vector<CylinderZInfinite> kQuartz{{{}, 0.4_F}};
+
+/// Подлуч из kStart, steps шагов и kEnd: shell — номер подлуча,
+/// intensity — номер записи в нём.
+void RecordSubRay(RayPathBuffer& buffer,
+                  std::uint32_t ray,
+                  std::size_t sub,
+                  std::size_t steps) {
+  for (std::size_t k = 0; k < steps + 2; ++k) {
+    const auto event = k == 0           ? RayPathEvent::kStart
+                       : k == steps + 1 ? RayPathEvent::kEnd
+                                        : RayPathEvent::kStep;
+    buffer.Record(ray, event, RayPathBody::kPlasma, sub, {},
+                  static_cast<Float>(k));
+  }
+}
+
+TEST_F(RayPathTest, SamplesDirections) {
+  RayPathRecorder every_third{
+      {.path = path_.string(), .sample = 3, .rays = {}}, kPlasma, kQuartz, 2};
+  EXPECT_NE(every_third.Sample(0, 0), nullptr);
+  EXPECT_NE(every_third.Sample(6, 1), every_third.Sample(6, 0));
+  EXPECT_EQ(every_third.Sample(4, 0), nullptr);
+
+  RayPathRecorder listed{{.path = path_.string(), .sample = 1, .rays = {2, 7}},
+                         kPlasma, kQuartz, 1};
+  EXPECT_NE(listed.Sample(7, 0), nullptr);
+  EXPECT_EQ(listed.Sample(3, 0), nullptr);
+}
+
+TEST_F(RayPathTest, RoundTripKeepsSubRaysWhole) {
+  // Каждый поток набирает больше одного блока, и блоки потоков ложатся в
+  // файл вперемешку посреди подлучей одних и тех же направлений.
+  constexpr std::size_t kSteps = 1000;
+  constexpr std::size_t kSubRays = 48;
+  {
+    RayPathRecorder recorder{{.path = path_.string(), .sample = 1, .rays = {}},
+                             kPlasma, kQuartz, 2};
+    for (std::size_t sub = 0; sub < kSubRays; ++sub) {
+      const auto ray = static_cast<std::uint32_t>(sub / 2 % 2 * 2);
+      auto* buffer = recorder.Sample(ray, sub % 2);
+      ASSERT_NE(buffer, nullptr);
+      RecordSubRay(*buffer, ray, sub, kSteps);
+    }
+  }
+
+  const auto path = ReadRayPath(path_.string());
+  ASSERT_EQ(path.plasma_radii.size(), 2);
+  EXPECT_NEAR(path.plasma_radii[1], 0.35_F, 1e-6_F);
+  ASSERT_EQ(path.quartz_radii.size(), 1);
+  EXPECT_NEAR(path.quartz_radii[0], 0.4_F, 1e-6_F);
+  ASSERT_EQ(path.records.size(), kSubRays * (kSteps + 2));
+
+  std::vector<std::size_t> subs;
+  for (std::size_t i = 0; i < path.records.size(); i += kSteps + 2) {
+    const auto& start = path.records[i];
+    ASSERT_EQ(start.event, RayPathEvent::kStart) << i;
+    for (std::size_t k = 0; k < kSteps + 2; ++k) {
+      const auto& record = path.records[i + k];
+      ASSERT_EQ(record.ray, start.ray) << i + k;
+      ASSERT_EQ(record.shell, start.shell) << i + k;
+      ASSERT_EQ(record.intensity, static_cast<float>(k)) << i + k;
+    }
+    EXPECT_EQ(path.records[i + kSteps + 1].event, RayPathEvent::kEnd);
+    subs.push_back(start.shell);
+  }
+  EXPECT_TRUE(std::ranges::is_sorted(path.records, {}, &RayPathRecord::ray));
+  std::ranges::sort(subs);
+  std::vector<std::size_t> expected(kSubRays);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_EQ(subs, expected);
+}
+
+}  // namespace
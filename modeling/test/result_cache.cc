@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "base/config/float.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/result_cache.h"
+
+namespace {
+
+/// Остальные тесты сверяют настоящие расчёты: кеш из MT_CACHE_DIR не
+/// должен подменять их результаты.
+class NoDefaultCache : public testing::Environment {
+ public:
+  void SetUp() override { ResultCache::DisableDefault(); }
+};
+
+[[maybe_unused]] const auto* const kNoDefaultCache =
+    testing::AddGlobalTestEnvironment(new NoDefaultCache);
+
+class ResultCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    const auto* info = testing::UnitTest::GetInstance()->current_test_info();
+    dir_ = std::filesystem::temp_directory_path() /
+           (std::string{"mt_cache_test_"} + info->name());
+    std::filesystem::remove_all(dir_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir_); }
+
+  std::filesystem::path dir_;
+};
+
+[[nodiscard]] CylinderPlasmaQuartz::Result QuartzResult(Float scale) {
+  return {
+      .absorbed_plasma = {1 * scale, 2 * scale, 3 * scale},
+      .absorbed_plasma3 = {4, 5, 6},
+      .absorbed_quartz = {0.5_F, 0.25_F},
+      .absorbed_quartz3 = {7, 8},
+      .absorbed_mirror = 0.125_F,
+      .intensity_all = 10 * scale,
+      .balance = {.absorbed_plasma = 6 * scale, .residual = -1e-6_F},
+      .timings = {.emission = 1, .transport = 2, .post = 3},
+  };
+}
+
+TEST_F(ResultCacheTest, StoreFindRoundTrip) {
+  ResultCache cache{dir_};
+  const auto expected = QuartzResult(1);
+  EXPECT_FALSE(cache.Find<CylinderPlasmaQuartz::Result>("a"));
+  ASSERT_TRUE(cache.Store("a", expected));
+
+  const auto found = cache.Find<CylinderPlasmaQuartz::Result>("a");
+  ASSERT_TRUE(found);
+  EXPECT_EQ(found->absorbed_plasma, expected.absorbed_plasma);
+  EXPECT_EQ(found->absorbed_plasma3, expected.absorbed_plasma3);
+  EXPECT_EQ(found->absorbed_quartz, expected.absorbed_quartz);
+  EXPECT_EQ(found->absorbed_quartz3, expected.absorbed_quartz3);
+  EXPECT_EQ(found->absorbed_mirror, expected.absorbed_mirror);
+  EXPECT_EQ(found->intensity_all, expected.intensity_all);
+  EXPECT_EQ(found->balance.absorbed_plasma, expected.balance.absorbed_plasma);
+  EXPECT_EQ(found->balance.residual, expected.balance.residual);
+  EXPECT_EQ(found->timings.transport, 0);
+
+  EXPECT_FALSE(cache.Find<CylinderPlasmaQuartz::Result>("b"));
+  // Тот же файл не читается как результат другой модели.
+  EXPECT_FALSE(cache.Find<CylinderPlasma::Result>("a"));
+}
+
+TEST_F(ResultCacheTest, CorruptFileIsMiss) {
+  ResultCache cache{dir_};
+  ASSERT_TRUE(cache.Store("a", QuartzResult(1)));
+  const auto path = cache.PathFor("a");
+  {
+    std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+    file.seekp(40);
+    file.put('\x7f');
+  }
+  EXPECT_FALSE(cache.Find<CylinderPlasmaQuartz::Result>("a"));
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST_F(ResultCacheTest, EvictsLeastRecentlyUsed) {
+  std::uintmax_t size{};
+  {
+    ResultCache probe{dir_};
+    ASSERT_TRUE(probe.Store("a", QuartzResult(1)));
+    size = std::filesystem::file_size(probe.PathFor("a"));
+  }
+
+  ResultCache cache{dir_, 2 * size};
+  ASSERT_TRUE(cache.Store("b", QuartzResult(2)));
+  // "a" использован позже "b".
+  ASSERT_TRUE(cache.Find<CylinderPlasmaQuartz::Result>("a"));
+  ASSERT_TRUE(cache.Store("c", QuartzResult(3)));
+
+  EXPECT_TRUE(std::filesystem::exists(cache.PathFor("a")));
+  EXPECT_FALSE(std::filesystem::exists(cache.PathFor("b")));
+  EXPECT_TRUE(std::filesystem::exists(cache.PathFor("c")));
+}
+
+TEST(CacheKeyTest, IgnoresThreadsAndTolerance) {
+  CylinderPlasmaQuartz::Params params;
+  const auto key = CacheKey(params);
+  params.n_threads = 7;
+  params.energy_tolerance = 1e-3_F;
+  EXPECT_EQ(CacheKey(params), key);
+  params.t1 = 701;
+  EXPECT_NE(CacheKey(params), key);
+
+  EXPECT_NE(CacheKey(CylinderPlasma::Params{}),
+            CacheKey(CylinderPlasmaQuartz::Params{}));
+}
+
+TEST_F(ResultCacheTest, SolveCachedComputesOnce) {
+  ResultCache cache{dir_};
+  const CylinderPlasma::Params params{.n_meridian = 10, .n_latitude = 10};
+  std::size_t computed{};
+  const auto solve = [&] {
+    ++computed;
+    return CylinderPlasma{params}.Solve();
+  };
+
+  const auto first = SolveCached(&cache, params, solve);
+  const auto second = SolveCached(&cache, params, solve);
+  EXPECT_EQ(computed, 1);
+  EXPECT_EQ(second.absorbed_plasma, first.absorbed_plasma);
+  EXPECT_EQ(second.intensity_all, first.intensity_all);
+  EXPECT_EQ(second.balance.residual, first.balance.residual);
+}
+
+}  // namespace
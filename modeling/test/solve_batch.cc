@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "band_params.h"
+#include "base/config/float.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/solve_batch.h"
+#include "modeling/thread_pool.h"
+
+namespace {
+
+template <typename Params>
+[[nodiscard]] Params Small(std::size_t band) {
+  auto params = BandParams<Params>(band, 12);
+  params.n_plasma = 10;
+  return params;
+}
+
+template <typename Result>
+void ExpectSame(const Result& expected, const Result& actual) {
+  EXPECT_EQ(expected.absorbed_plasma, actual.absorbed_plasma);
+  EXPECT_EQ(expected.absorbed_plasma3, actual.absorbed_plasma3);
+  EXPECT_EQ(expected.absorbed_mirror, actual.absorbed_mirror);
+  EXPECT_EQ(expected.intensity_all, actual.intensity_all);
+  EXPECT_EQ(expected.balance.residual, actual.balance.residual);
+  if constexpr (requires { expected.absorbed_quartz; }) {
+    EXPECT_EQ(expected.absorbed_quartz, actual.absorbed_quartz);
+    EXPECT_EQ(expected.absorbed_quartz3, actual.absorbed_quartz3);
+  }
+}
+
+TEST(SolveBatchTest, PlasmaMatchesSolve) {
+  using Params = CylinderPlasma::Params;
+  std::vector<Params> params;
+  for (const auto rho : {0.5_F, 0.95_F}) {
+    for (const auto band : {150UZ, 169UZ}) {
+      auto p = Small<Params>(band);
+      p.rho = rho;
+      params.push_back(p);
+    }
+  }
+  params.push_back(params.front());
+  params.back().i_crit = 1e-4_F;
+  params.push_back(params.front());
+  params.back().m = 8;
+  params.push_back(params.front());
+  params.back().n_meridian = 16;
+
+  // Излучение каждой стороны сравнения считается заново.
+  EmissionCache::Default().Clear();
+  const auto results = CylinderPlasma::SolveBatch(params);
+  ASSERT_EQ(results.size(), params.size());
+  for (std::size_t i = 0; i < params.size(); ++i) {
+    SCOPED_TRACE(i);
+    EmissionCache::Default().Clear();
+    ExpectSame(CylinderPlasma{params[i]}.Solve(), results[i]);
+  }
+
+  // Варианты с одинаковым EmissionKey делят один проход излучения.
+  EXPECT_EQ(results[0].timings.emission, results[2].timings.emission);
+  EXPECT_EQ(results[0].timings.emission, results[4].timings.emission);
+}
+
+TEST(SolveBatchTest, PlasmaQuartzMatchesSolve) {
+  using Params = CylinderPlasmaQuartz::Params;
+  std::vector<Params> params(3, Small<Params>(169));
+  params[0].n_quartz = 4;
+  params[1].n_quartz = 6;
+  params[1].delta = 0.2_F;
+  params[2].n_quartz = 4;
+  params[2].rho = 0.5_F;
+
+  ThreadPool pool{3};
+  EmissionCache::Default().Clear();
+  const auto results = CylinderPlasmaQuartz::SolveBatch(params, pool);
+  ASSERT_EQ(results.size(), params.size());
+  for (std::size_t i = 0; i < params.size(); ++i) {
+    SCOPED_TRACE(i);
+    EmissionCache::Default().Clear();
+    ExpectSame(CylinderPlasmaQuartz{params[i]}.Solve(), results[i]);
+  }
+}
+
+TEST(SolveBatchTest, Empty) {
+  EXPECT_TRUE(CylinderPlasma::SolveBatch({}).empty());
+}
+
+TEST(EmissionCacheTest, ResolveStartsFromTransport) {
+  auto& cache = EmissionCache::Default();
+  cache.Clear();
+  auto params = Small<CylinderPlasmaQuartz::Params>(169);
+  EXPECT_GT(CylinderPlasmaQuartz{params}.Solve().timings.emission, 0);
+
+  // rho, i_crit и кварц излучения не меняют.
+  params.rho = 0.5_F;
+  params.i_crit = 1e-5_F;
+  params.eta_quartz = 1.5_F;
+  params.n_quartz = 6;
+  const auto r = CylinderPlasmaQuartz{params}.Solve();
+  EXPECT_EQ(r.timings.emission, 0);
+  cache.Clear();
+  ExpectSame(CylinderPlasmaQuartz{params}.Solve(), r);
+
+  // Столб плазмы у решателей один, излучение тоже.
+  auto plasma = Small<CylinderPlasma::Params>(169);
+  EXPECT_EQ(CylinderPlasma{plasma}.Solve().timings.emission, 0);
+  plasma.t0 = 9000;
+  EXPECT_GT(CylinderPlasma{plasma}.Solve().timings.emission, 0);
+}
+
+TEST(EmissionCacheTest, EvictsLeastRecentlyUsed) {
+  EmissionCache cache;
+  const auto key = [](std::size_t n) {
+    return EmissionKey(Small<CylinderPlasma::Params>(n));
+  };
+  for (std::size_t i = 0; i <= EmissionCache::kCapacity; ++i) {
+    cache.Store(key(i), {.is = {static_cast<Float>(i)}, .seconds = 1});
+    if (i == 0) {
+      continue;
+    }
+    ASSERT_TRUE(cache.Find(key(0)));
+  }
+  EXPECT_FALSE(cache.Find(key(1)));
+  const auto e = cache.Find(key(0));
+  ASSERT_TRUE(e);
+  EXPECT_EQ(e->is, std::vector<Float>{0});
+  EXPECT_EQ(e->seconds, 0);
+}
+
+}  // namespace
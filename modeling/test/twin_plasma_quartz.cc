@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "band_params.h"
+#include "base/config/float.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/solve_monitor.h"
+#include "modeling/twin_plasma_quartz.h"
+
+namespace {
+
+[[nodiscard]] Float Sum(const std::vector<Float>& v) {
+  return std::accumulate(v.begin(), v.end(), kZero);
+}
+
+TEST(TwinPlasmaQuartzTest, BalancesEnergyOfBothColumns) {
+  auto params = Band169<TwinPlasmaQuartz::Params>(40);
+  params.energy_tolerance = 1e-3_F;
+  const auto r = TwinPlasmaQuartz{params}.Solve();
+
+  // Излучение каждого столба — как у одиночного того же радиуса.
+  const auto single =
+      CylinderPlasmaQuartz{Band169<CylinderPlasmaQuartz::Params>(40)}.Solve();
+  EXPECT_EQ(r.intensity_all, 2 * single.intensity_all);
+
+  EXPECT_EQ(r.absorbed_plasma.size(), params.n_plasma);
+  ASSERT_EQ(r.absorbed_quartz.size(), params.n_quartz + 1);
+  EXPECT_EQ(r.absorbed_quartz.front(), 0);
+  EXPECT_GT(Sum(r.absorbed_plasma), 0);
+  EXPECT_GT(Sum(r.absorbed_quartz), 0);
+  EXPECT_GT(r.absorbed_mirror, 0);
+  EXPECT_NEAR(Sum(r.absorbed_plasma) + Sum(r.absorbed_quartz) +
+                  r.absorbed_mirror,
+              r.intensity_all, 1e-3_F * r.intensity_all);
+}
+
+TEST(TwinPlasmaQuartzTest, MonitoredSolveMatchesSolve) {
+  const auto params = Band169<TwinPlasmaQuartz::Params>(16);
+  SolveMonitor monitor;
+  const auto r = TwinPlasmaQuartz{params}.Solve(monitor);
+  const auto expected = TwinPlasmaQuartz{params}.Solve();
+  EXPECT_EQ(r.absorbed_plasma, expected.absorbed_plasma);
+  EXPECT_EQ(r.absorbed_quartz, expected.absorbed_quartz);
+  EXPECT_EQ(r.absorbed_mirror, expected.absorbed_mirror);
+  EXPECT_EQ(monitor.progress().stage, SolveStage::kDone);
+}
+
+TEST(TwinPlasmaQuartzTest, RejectsColumnsOutsideTube) {
+  TwinPlasmaQuartz::Params params;
+  params.a = 0.7_F;  // 2 r + gap / 2 = 0.75.
+  EXPECT_THROW(TwinPlasmaQuartz{params}, std::invalid_argument);
+
+  params = {};
+  params.b = 0.3_F;
+  EXPECT_THROW(TwinPlasmaQuartz{params}, std::invalid_argument);
+
+  params = {};
+  params.gap = -0.01_F;
+  EXPECT_THROW(TwinPlasmaQuartz{params}, std::invalid_argument);
+}
+
+}  // namespace
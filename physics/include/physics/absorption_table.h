@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "base/config/float.h"
+#include "io/mapped_file.h"
+
+/// Заголовок двоичной таблицы коэффициента поглощения. За ним массивы
+/// double (little-endian):
+///   frequency[n_bands + 1]           — границы полос, Гц, по возрастанию;
+///   temperature[n_temperatures]      — К, по возрастанию;
+///   ln_temperature[n_temperatures];
+///   k[n_temperatures][n_bands]       — см^-1, > 0;
+///   ln_k[n_temperatures][n_bands].
+struct AbsorptionTableHeader {
+  static constexpr std::array<char, 8> kMagic = {'M', 'T', 'A', 'B',
+                                                 'S', 'O', 'R', 'B'};
+  static constexpr std::uint32_t kVersion = 1;
+
+  std::array<char, 8> magic = kMagic;
+  std::uint32_t version = kVersion;
+  std::uint32_t header_size = sizeof(AbsorptionTableHeader);
+  std::uint32_t n_temperatures{};
+  std::uint32_t n_bands{};
+  std::uint64_t reserved{};
+};
+static_assert(sizeof(AbsorptionTableHeader) == 32);
+
+/// Полоса частот таблицы, Гц.
+struct AbsorptionBand {
+  double nu{};    ///< Середина.
+  double d_nu{};  ///< Ширина.
+};
+
+/// Таблица коэффициента поглощения k(nu, T), постоянного внутри полосы
+/// частот и интерполируемого по температуре линейно в координатах
+/// (ln T, ln k). Сетки произвольные; логарифмы посчитаны заранее.
+class AbsorptionTable {
+ public:
+  /// Встроенная таблица ксенона p=15 ат (xenon_absorption_coefficient.h).
+  [[nodiscard]] static const AbsorptionTable& Xenon();
+
+  /// Таблица, которую использует params::plasma: файл из переменной
+  /// окружения MT_ABSORPTION_TABLE, если она задана, иначе Xenon().
+  /// Загружается при первом вызове.
+  /// @throws std::runtime_error, если файл не загрузился.
+  [[nodiscard]] static const AbsorptionTable& Default();
+
+  /// Отображает файл в память.
+  /// @throws std::runtime_error, если файл не открыт или повреждён.
+  [[nodiscard]] static AbsorptionTable Load(const std::filesystem::path& path);
+
+  /// Строит таблицу по сеткам; k — по строке на температуру.
+  /// @throws std::invalid_argument, если размеры не согласованы, сетки не
+  /// возрастают или k <= 0.
+  [[nodiscard]] static AbsorptionTable FromGrids(
+      std::span<const double> frequency,
+      std::span<const double> temperature,
+      std::span<const double> k);
+
+  /// Читает текстовый формат docs/коэффициент_поглощения_Xe.txt: секции
+  /// с заголовками-строками на кириллице — частоты (в 1e15 Гц), число
+  /// температур (не используется), температуры и k построчно.
+  /// @throws std::invalid_argument
+  [[nodiscard]] static AbsorptionTable FromText(std::istream& in);
+
+  /// Двоичное представление для записи в файл.
+  [[nodiscard]] std::string Serialize() const;
+
+  /// Отпечаток содержимого: FNV-1a двоичного представления.
+  [[nodiscard]] std::uint64_t Hash() const noexcept { return hash_; }
+
+  [[nodiscard]] std::size_t n_bands() const noexcept { return n_bands_; }
+  [[nodiscard]] std::span<const double> frequency() const noexcept {
+    return frequency_;
+  }
+  [[nodiscard]] std::span<const double> temperature() const noexcept {
+    return temperature_;
+  }
+  /// @returns k[t][band].
+  [[nodiscard]] double k(std::size_t t, std::size_t band) const noexcept {
+    return k_[t * n_bands_ + band];
+  }
+
+  /// @returns Полоса (f[i], f[i + 1]], содержащая nu, если nu внутри
+  /// таблицы.
+  [[nodiscard]] std::optional<std::size_t> Band(Float nu) const noexcept;
+
+  /// Середина и ширина полосы band — одни и те же во всех интерфейсах;
+  /// в Float приводятся уже готовые значения.
+  /// @throws std::out_of_range при band >= n_bands()
+  [[nodiscard]] AbsorptionBand BandCenter(std::size_t band) const;
+
+  /// Коэффициент поглощения; nu и t должны лежать внутри таблицы.
+  [[nodiscard]] Float operator()(Float nu, Float t) const noexcept;
+
+ private:
+  AbsorptionTable() = default;
+
+  /// Разбирает и проверяет двоичное представление в bytes.
+  /// @throws std::runtime_error
+  void Parse(std::span<const std::byte> bytes);
+
+  std::optional<MappedFile> file_;
+  std::vector<double> owned_;
+
+  std::uint64_t hash_{};
+  std::size_t n_bands_{};
+  std::span<const double> frequency_;
+  std::span<const double> temperature_;
+  std::span<const double> ln_temperature_;
+  std::span<const double> k_;
+  std::span<const double> ln_k_;
+};
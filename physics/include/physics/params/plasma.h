@@ -8,8 +8,12 @@ namespace params::plasma {
 inline constexpr auto kEta = 1.0_F;
 
 /// Коэффициент поглощения плазмы.
-[[nodiscard]] Float AbsorptionCoefficient(Float nu, Float t) noexcept;
+/// @throws std::runtime_error, как AbsorptionTable::Default().
+[[nodiscard]] Float AbsorptionCoefficient(Float nu, Float t);
 
-[[nodiscard]] Float AbsorptionCoefficientFromTable(Float nu, Float t) noexcept;
+/// Коэффициент поглощения по AbsorptionTable::Default().
+/// @throws std::runtime_error, если таблица MT_ABSORPTION_TABLE не
+/// загрузилась.
+[[nodiscard]] Float AbsorptionCoefficientFromTable(Float nu, Float t);
 
 }  // namespace params::plasma
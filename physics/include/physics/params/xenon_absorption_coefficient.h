@@ -7,6 +7,10 @@
 
 inline constexpr std::size_t kXenonTableRanges = 193;
 
+// Таблица задана в double; для float округление значений ожидаемо.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+
 inline constexpr std::array<Float, kXenonTableRanges + 1> kXenonFrequency = {
     0.02000E+15, 0.10000E+15, 0.19000E+15, 0.19400E+15, 0.19453E+15,
     0.19463E+15, 0.19500E+15, 0.20300E+15, 0.20358E+15, 0.20368E+15,
@@ -448,3 +452,5 @@ inline constexpr std::array<std::array<Float, kXenonTableRanges>,
             .204E+3, .113E+3, .252E+2, .390E+4,
         },
     }};
+
+#pragma GCC diagnostic pop
@@ -23,11 +23,12 @@ namespace func {
 /// @param t  Абсолютная температура [К].
 /// @returns  Спектральная плотность излучения [Дж * с / см^3].
 [[nodiscard]] constexpr Float UNu(Float nu, Float t) noexcept {
-  return 8 * consts::kPi * consts::kPlanckConstant * Cube(nu) /
-         (Cube(consts::kSpeedOfLightSm) *
-          (std::exp(consts::kPlanckConstant * nu /
-                    (consts::kBolzmannConstant * t)) -
-           1));
+  // nu^3 ~ 1e45 не помещается во float, поэтому считаем через nu / c.
+  return 8 * consts::kPi * consts::kPlanckConstant * nu *
+         Sqr(nu / consts::kSpeedOfLightSm) / consts::kSpeedOfLightSm /
+         (std::exp(consts::kPlanckConstant * nu /
+                   (consts::kBolzmannConstant * t)) -
+          1);
 }
 
 /// Интенсивность.
@@ -36,11 +37,12 @@ namespace func {
 /// I = u_nu * c (* d_nu) / 4π
 /// [Вт / см^2]
 [[nodiscard]] constexpr Float I(Float nu, Float d_nu, Float t) noexcept {
-  return 2 * consts::kPlanckConstant * Cube(nu) * d_nu /
-         (Sqr(consts::kSpeedOfLightSm) *
-          (std::exp(consts::kPlanckConstant * nu /
-                    (consts::kBolzmannConstant * t)) -
-           1));
+  // nu^3 ~ 1e45 не помещается во float, поэтому считаем через nu / c.
+  return 2 * consts::kPlanckConstant * nu * Sqr(nu / consts::kSpeedOfLightSm) *
+         d_nu /
+         (std::exp(consts::kPlanckConstant * nu /
+                   (consts::kBolzmannConstant * t)) -
+          1);
 }
 
 }  // namespace func
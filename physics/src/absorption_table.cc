@@ -0,0 +1,256 @@
+#include "physics/absorption_table.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "base/fnv1a.h"
+#include "physics/params/xenon_absorption_coefficient.h"
+
+static_assert(std::endian::native == std::endian::little,
+              "AbsorptionTable files are little-endian");
+
+namespace {
+
+constexpr auto kTextFrequencyUnit = 1e15;
+
+[[nodiscard]] bool IsIncreasing(std::span<const double> values) {
+  return std::ranges::adjacent_find(values, std::greater_equal<>{}) ==
+         values.end();
+}
+
+[[nodiscard]] std::vector<double> Ln(std::span<const double> values) {
+  std::vector<double> ln(values.size());
+  std::ranges::transform(values, ln.begin(),
+                         [](double value) { return std::log(value); });
+  return ln;
+}
+
+/// Секция текстового формата: строки чисел после строки-заголовка.
+[[nodiscard]] std::vector<std::vector<double>> ReadSections(std::istream& in) {
+  std::vector<std::vector<double>> sections;
+  std::string line;
+  while (std::getline(in, line)) {
+    // Заголовок — строка, начинающаяся не с числа.
+    const auto first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+      continue;
+    }
+    const auto c = line[first];
+    if (!(std::isdigit(static_cast<unsigned char>(c)) != 0 || c == '.' ||
+          c == '-' || c == '+')) {
+      sections.emplace_back();
+      continue;
+    }
+    if (sections.empty()) {
+      throw std::invalid_argument("Numbers before the first section title");
+    }
+    std::istringstream numbers{line};
+    for (double value{}; numbers >> value;) {
+      sections.back().push_back(value);
+    }
+    if (!numbers.eof()) {
+      throw std::invalid_argument(std::format("Bad number in '{}'", line));
+    }
+  }
+  return sections;
+}
+
+}  // namespace
+
+const AbsorptionTable& AbsorptionTable::Xenon() {
+  static const auto table = [] {
+    const std::vector<double> frequency(kXenonFrequency.begin(),
+                                        kXenonFrequency.end());
+    const std::vector<double> temperature(kXenonTemperature.begin(),
+                                          kXenonTemperature.end());
+    std::vector<double> k;
+    for (const auto& row : kXenonAbsorptionCoefficient) {
+      k.insert(k.end(), row.begin(), row.end());
+    }
+    return FromGrids(frequency, temperature, k);
+  }();
+  return table;
+}
+
+const AbsorptionTable& AbsorptionTable::Default() {
+  static const auto loaded = []() -> std::optional<AbsorptionTable> {
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    if (const auto* path = std::getenv("MT_ABSORPTION_TABLE")) {
+      return Load(path);
+    }
+    return std::nullopt;
+  }();
+  return loaded ? *loaded : Xenon();
+}
+
+AbsorptionTable AbsorptionTable::Load(const std::filesystem::path& path) {
+  AbsorptionTable table;
+  table.file_.emplace(path);
+  try {
+    table.Parse(table.file_->bytes());
+  } catch (const std::runtime_error& e) {
+    throw std::runtime_error(std::format("{}: {}", path.string(), e.what()));
+  }
+  return table;
+}
+
+AbsorptionTable AbsorptionTable::FromGrids(std::span<const double> frequency,
+                                           std::span<const double> temperature,
+                                           std::span<const double> k) {
+  if (frequency.size() < 2 || temperature.size() < 2 ||
+      k.size() != temperature.size() * (frequency.size() - 1)) {
+    throw std::invalid_argument(std::format(
+        "Expected k of {} temperatures x {} bands, got {} values",
+        temperature.size(), frequency.size() - 1, k.size()));
+  }
+  if (!IsIncreasing(frequency) || !IsIncreasing(temperature)) {
+    throw std::invalid_argument("Grids must be strictly increasing");
+  }
+  if (temperature.front() <= 0 ||
+      !std::ranges::all_of(k, [](double value) { return value > 0; })) {
+    throw std::invalid_argument("Temperatures and k must be positive");
+  }
+
+  const AbsorptionTableHeader header{
+      .n_temperatures = static_cast<std::uint32_t>(temperature.size()),
+      .n_bands = static_cast<std::uint32_t>(frequency.size() - 1),
+  };
+  const auto ln_temperature = Ln(temperature);
+  const auto ln_k = Ln(k);
+
+  AbsorptionTable table;
+  auto& data = table.owned_;
+  data.resize(sizeof header / sizeof(double));
+  std::memcpy(data.data(), &header, sizeof header);
+  for (const auto values : {frequency, temperature,
+                            std::span<const double>{ln_temperature}, k,
+                            std::span<const double>{ln_k}}) {
+    data.insert(data.end(), values.begin(), values.end());
+  }
+  table.Parse(std::as_bytes(std::span{data}));
+  return table;
+}
+
+AbsorptionTable AbsorptionTable::FromText(std::istream& in) {
+  const auto sections = ReadSections(in);
+  if (sections.size() != 4) {
+    throw std::invalid_argument(std::format(
+        "Expected 4 sections (frequencies, count, temperatures, k), got {}",
+        sections.size()));
+  }
+  auto frequency = sections[0];
+  for (auto& nu : frequency) {
+    nu *= kTextFrequencyUnit;
+  }
+  return FromGrids(frequency, sections[2], sections[3]);
+}
+
+std::string AbsorptionTable::Serialize() const {
+  const AbsorptionTableHeader header{
+      .n_temperatures = static_cast<std::uint32_t>(temperature_.size()),
+      .n_bands = static_cast<std::uint32_t>(n_bands_),
+  };
+  std::string out(sizeof header, '\0');
+  std::memcpy(out.data(), &header, sizeof header);
+  for (const auto values :
+       {frequency_, temperature_, ln_temperature_, k_, ln_k_}) {
+    const auto bytes = std::as_bytes(values);
+    out.append(reinterpret_cast<const char*>(bytes.data()),  // NOLINT
+               bytes.size());
+  }
+  return out;
+}
+
+void AbsorptionTable::Parse(std::span<const std::byte> bytes) {
+  AbsorptionTableHeader header;
+  if (bytes.size() < sizeof header) {
+    throw std::runtime_error("too short for a header");
+  }
+  std::memcpy(&header, bytes.data(), sizeof header);
+  if (header.magic != AbsorptionTableHeader::kMagic) {
+    throw std::runtime_error("not an absorption table");
+  }
+  if (header.version != AbsorptionTableHeader::kVersion ||
+      header.header_size != sizeof header) {
+    throw std::runtime_error(
+        std::format("unsupported version {}", header.version));
+  }
+
+  const std::size_t n_t = header.n_temperatures;
+  const std::size_t n_bands = header.n_bands;
+  const auto n_values = (n_bands + 1) + 2 * n_t + 2 * n_t * n_bands;
+  if (n_t < 2 || n_bands < 1 ||
+      bytes.size() != sizeof header + n_values * sizeof(double)) {
+    throw std::runtime_error(std::format(
+        "size {} doesn't match {} temperatures x {} bands", bytes.size(),
+        n_t, n_bands));
+  }
+
+  // Массивы выровнены на 8 байт: заголовок 32 байта, mmap — на страницу.
+  const std::span values{
+      reinterpret_cast<const double*>(bytes.data() + sizeof header),  // NOLINT
+      n_values};
+  n_bands_ = n_bands;
+  frequency_ = values.subspan(0, n_bands + 1);
+  temperature_ = values.subspan(n_bands + 1, n_t);
+  ln_temperature_ = values.subspan(n_bands + 1 + n_t, n_t);
+  k_ = values.subspan(n_bands + 1 + 2 * n_t, n_t * n_bands);
+  ln_k_ = values.subspan(n_bands + 1 + 2 * n_t + n_t * n_bands);
+
+  if (!IsIncreasing(frequency_) || !IsIncreasing(temperature_)) {
+    throw std::runtime_error("grids are not increasing");
+  }
+  hash_ = Fnv1a({reinterpret_cast<const char*>(bytes.data()),  // NOLINT
+                 bytes.size()});
+}
+
+std::optional<std::size_t> AbsorptionTable::Band(Float nu) const noexcept {
+  const auto lower = std::ranges::lower_bound(frequency_, nu);
+  if (lower == frequency_.begin() || lower == frequency_.end()) {
+    return std::nullopt;
+  }
+  return static_cast<std::size_t>(std::distance(frequency_.begin(), lower) -
+                                  1);
+}
+
+AbsorptionBand AbsorptionTable::BandCenter(std::size_t band) const {
+  if (band >= n_bands_) {
+    throw std::out_of_range(
+        std::format("band {} is out of range [0, {})", band, n_bands_));
+  }
+  const auto d_nu = frequency_[band + 1] - frequency_[band];
+  return {.nu = frequency_[band] + d_nu / 2, .d_nu = d_nu};
+}
+
+Float AbsorptionTable::operator()(Float nu, Float t) const noexcept {
+  assert(temperature_.front() <= t && t <= temperature_.back());
+  const auto band_idx = Band(nu);
+  assert(band_idx);
+  const auto band = *band_idx;  // NOLINT(bugprone-unchecked-optional-access)
+
+  const auto upper = std::ranges::upper_bound(temperature_, t);
+  const auto t_idx = std::min(
+      static_cast<std::size_t>(
+          std::max<std::ptrdiff_t>(
+              std::distance(temperature_.begin(), upper) - 1, 0)),
+      temperature_.size() - 2);
+
+  const auto t_ln = std::log(t);
+  const auto t0_ln = static_cast<Float>(ln_temperature_[t_idx]);
+  const auto t1_ln = static_cast<Float>(ln_temperature_[t_idx + 1]);
+  const auto f0_ln = static_cast<Float>(ln_k_[t_idx * n_bands_ + band]);
+  const auto f1_ln = static_cast<Float>(ln_k_[(t_idx + 1) * n_bands_ + band]);
+
+  const auto f_ln = f0_ln + (t_ln - t0_ln) * (f1_ln - f0_ln) / (t1_ln - t0_ln);
+  return std::exp(f_ln);
+}
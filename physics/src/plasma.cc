@@ -1,20 +1,8 @@
 #include "physics/params/plasma.h"
 
-#include <algorithm>
-#include <array>
-#include <cassert>
-#include <cmath>
-#include <cstddef>
-#include <iterator>
-
-#include "base/config/build_type.h"
 #include "base/ignore_unused.h"
 #include "math/fast_pow.h"
-#include "physics/params/xenon_absorption_coefficient.h"
-
-#ifdef MT_DEBUG
-#include "math/float/compare.h"
-#endif
+#include "physics/absorption_table.h"
 
 namespace {
 
@@ -41,49 +29,11 @@ MT_IGNORE_UNUSED_END
 
 namespace params::plasma {
 
-Float AbsorptionCoefficientFromTable(Float nu, Float t) noexcept {
-  static_assert(kXenonTemperature.size() == 13);
-  assert(IsEqual(kXenonTemperature[0], 2000.0_F));
-  assert(IsEqual(kXenonTemperature[1], 3000.0_F));
-  assert(IsEqual(kXenonTemperature[2], 4000.0_F));
-  assert(IsEqual(kXenonTemperature[3], 5000.0_F));
-  assert(IsEqual(kXenonTemperature[4], 6000.0_F));
-  assert(IsEqual(kXenonTemperature[5], 7000.0_F));
-  assert(IsEqual(kXenonTemperature[6], 8000.0_F));
-  assert(IsEqual(kXenonTemperature[7], 9000.0_F));
-  assert(IsEqual(kXenonTemperature[8], 10000.0_F));
-  assert(IsEqual(kXenonTemperature[9], 11000.0_F));
-  assert(IsEqual(kXenonTemperature[10], 12000.0_F));
-  assert(IsEqual(kXenonTemperature[11], 13000.0_F));
-  assert(IsEqual(kXenonTemperature[12], 14000.0_F));
-
-  assert(kXenonTemperature.front() <= t && t <= kXenonTemperature.back());
-  const auto t_idx = static_cast<size_t>(t) / 1000 - 2;
-  assert(t_idx <= 12);
-
-  const auto* lower = std::ranges::lower_bound(kXenonFrequency, nu);
-  assert(lower != kXenonFrequency.end());
-  const auto nu_idx_p = std::distance(kXenonFrequency.begin(), lower);
-  assert(1 <= nu_idx_p);
-  const auto nu_idx = static_cast<size_t>(nu_idx_p - 1);
-  assert(nu_idx + 1 < kXenonFrequency.size());
-
-  // TODO(a.kerimov): Cache?
-  const auto t_ln = std::log(t);
-  const auto t0_ln = std::log(kXenonTemperature[t_idx]);
-  const auto t1_ln = std::log(kXenonTemperature[t_idx + 1]);
-
-  const auto f0 = kXenonAbsorptionCoefficient[t_idx][nu_idx];
-  const auto f1 = kXenonAbsorptionCoefficient[t_idx + 1][nu_idx];
-  const auto f0_ln = std::log(f0);
-  const auto f1_ln = std::log(f1);
-
-  const auto f_ln = f0_ln + (t_ln - t0_ln) * (f1_ln - f0_ln) / (t1_ln - t0_ln);
-  const auto f = std::exp(f_ln);
-  return f;
+Float AbsorptionCoefficientFromTable(Float nu, Float t) {
+  return AbsorptionTable::Default()(nu, t);
 }
 
-Float AbsorptionCoefficient(Float nu, Float t) noexcept {
+Float AbsorptionCoefficient(Float nu, Float t) {
 #if defined(CONSTANT_TEMPERATURE)
   return AbsorptionCoefficientFromConstant(nu, t);
 #elif defined(XENON_TABLE_COEFFICIENT)
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "base/config/float.h"
+#include "physics/absorption_table.h"
+#include "physics/params/xenon_absorption_coefficient.h"
+
+namespace {
+
+/// Прежняя реализация AbsorptionCoefficientFromTable на сетке 2000..14000 К.
+[[nodiscard]] Float Reference(Float nu, Float t) {
+  const auto t_idx = static_cast<std::size_t>(t) / 1000 - 2;
+  const auto* lower = std::ranges::lower_bound(kXenonFrequency, nu);
+  const auto nu_idx = static_cast<std::size_t>(
+      std::distance(kXenonFrequency.begin(), lower) - 1);
+
+  const auto t_ln = std::log(t);
+  const auto t0_ln = std::log(kXenonTemperature[t_idx]);
+  const auto t1_ln = std::log(kXenonTemperature[t_idx + 1]);
+  const auto f0_ln = std::log(kXenonAbsorptionCoefficient[t_idx][nu_idx]);
+  const auto f1_ln = std::log(kXenonAbsorptionCoefficient[t_idx + 1][nu_idx]);
+  return std::exp(f0_ln + (t_ln - t0_ln) * (f1_ln - f0_ln) / (t1_ln - t0_ln));
+}
+
+TEST(AbsorptionTableTest, XenonMatchesReference) {
+  const auto& table = AbsorptionTable::Xenon();
+  ASSERT_EQ(table.n_bands(), kXenonTableRanges);
+  for (std::size_t band = 0; band < kXenonTableRanges; band += 7) {
+    const auto nu = (kXenonFrequency[band] + kXenonFrequency[band + 1]) / 2;
+    EXPECT_EQ(table.Band(nu), band);
+    for (const auto t : {2000.0_F, 2500.5_F, 3000.0_F, 7777.0_F, 13999.0_F}) {
+#if defined(MT_USE_DOUBLE)
+      EXPECT_EQ(table(nu, t), Reference(nu, t)) << band << ' ' << t;
+#else
+      EXPECT_NEAR(table(nu, t), Reference(nu, t), 1e-4_F * Reference(nu, t))
+          << band << ' ' << t;
+#endif
+    }
+  }
+}
+
+TEST(AbsorptionTableTest, TextMatchesHeader) {
+  std::ifstream in{MT_XENON_TEXT};
+  ASSERT_TRUE(in) << MT_XENON_TEXT;
+  const auto text = AbsorptionTable::FromText(in);
+  const auto& xenon = AbsorptionTable::Xenon();
+
+  ASSERT_EQ(text.n_bands(), xenon.n_bands());
+  ASSERT_EQ(text.temperature().size(), xenon.temperature().size());
+  // Встроенная таблица хранит частоты во Float.
+  constexpr auto kEps = 4 * std::numeric_limits<Float>::epsilon();
+  for (std::size_t i = 0; i <= text.n_bands(); ++i) {
+    EXPECT_NEAR(text.frequency()[i], xenon.frequency()[i],
+                kEps * xenon.frequency()[i]);
+  }
+  for (std::size_t t = 0; t < text.temperature().size(); ++t) {
+    for (std::size_t band = 0; band < text.n_bands(); ++band) {
+      EXPECT_NEAR(text.k(t, band), xenon.k(t, band), 1e-6 * xenon.k(t, band))
+          << t << ' ' << band;
+    }
+  }
+}
+
+TEST(AbsorptionTableTest, SerializeLoadRoundTrip) {
+  const auto path =
+      std::filesystem::temp_directory_path() / "mt_absorption_table_test.bin";
+  std::ofstream{path, std::ios::binary} << AbsorptionTable::Xenon().Serialize();
+
+  {
+    const auto loaded = AbsorptionTable::Load(path);
+    const auto& xenon = AbsorptionTable::Xenon();
+    EXPECT_EQ(loaded.Serialize(), xenon.Serialize());
+    EXPECT_EQ(loaded.Hash(), xenon.Hash());
+    const auto nu = (kXenonFrequency[169] + kXenonFrequency[170]) / 2;
+    EXPECT_EQ(loaded(nu, 5432.1_F), xenon(nu, 5432.1_F));
+  }
+
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+  EXPECT_THROW(static_cast<void>(AbsorptionTable::Load(path)),
+               std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(AbsorptionTableTest, ArbitraryGrid) {
+  const std::vector<double> frequency = {1, 2, 4};
+  const std::vector<double> temperature = {1000, 1500, 10000};
+  // k = T^2 в первой полосе, 5 во второй.
+  const std::vector<double> k = {1e6, 5, 2.25e6, 5, 1e8, 5};
+  const auto table = AbsorptionTable::FromGrids(frequency, temperature, k);
+
+  EXPECT_EQ(table.Band(0.5_F), std::nullopt);
+  EXPECT_EQ(table.Band(1.5_F), 0);
+  EXPECT_EQ(table.Band(2.0_F), 0);
+  EXPECT_EQ(table.Band(3.0_F), 1);
+  EXPECT_EQ(table.Band(5.0_F), std::nullopt);
+
+  EXPECT_EQ(table.BandCenter(1).nu, 3);
+  EXPECT_EQ(table.BandCenter(1).d_nu, 2);
+  EXPECT_THROW(static_cast<void>(table.BandCenter(2)), std::out_of_range);
+
+  // Степенной закон точно воспроизводится интерполяцией в ln-ln.
+  for (const auto t : {1000.0_F, 1200.0_F, 3000.0_F, 10000.0_F}) {
+    EXPECT_NEAR(table(1.5_F, t), t * t, 1e-4_F * t * t) << t;
+    EXPECT_NEAR(table(3.0_F, t), 5, 1e-5_F) << t;
+  }
+}
+
+TEST(AbsorptionTableTest, RejectsBadGrids) {
+  const auto from_grids = [](std::vector<double> temperature,
+                             std::vector<double> k) {
+    const std::vector<double> frequency = {1, 2};
+    static_cast<void>(AbsorptionTable::FromGrids(frequency, temperature, k));
+  };
+  EXPECT_THROW(from_grids({1000, 2000}, {1}), std::invalid_argument);
+  EXPECT_THROW(from_grids({2000, 1000}, {1, 1}), std::invalid_argument);
+  EXPECT_THROW(from_grids({1000, 2000}, {1, 0}), std::invalid_argument);
+
+  std::istringstream text{"Частоты\n1 2\nТемпературы\n1000 2000\n"};
+  EXPECT_THROW(static_cast<void>(AbsorptionTable::FromText(text)),
+               std::invalid_argument);
+}
+
+}  // namespace
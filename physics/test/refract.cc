@@ -13,7 +13,7 @@ TEST(RefractTest, AirToGlass) {
   constexpr auto kEtaI = 1.0_F;
   constexpr auto kEtaT = 1.5_F;
   constexpr auto kMu = kEtaI / kEtaT;
-  const auto z = std::sqrt(19) / 3;
+  const auto z = std::sqrt(19.0_F) / 3;
   const auto expected = Vec3{kMu, kMu, -z}.Normalized();
 
   const auto refracted = Refract(incident, normal, kEtaI, kEtaT);
@@ -26,7 +26,7 @@ TEST(RefractTest, GlassToAir) {
   constexpr auto kEtaI = 1.0_F;
   constexpr auto kEtaT = 1.5_F;
   constexpr auto kMu = kEtaI / kEtaT;
-  const auto z = std::sqrt(19) / 3;
+  const auto z = std::sqrt(19.0_F) / 3;
   const auto incident = Vec3{kMu, kMu, -z}.Normalized();
 
   // NOLINTNEXTLINE(readability-suspicious-call-argument)
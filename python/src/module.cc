@@ -0,0 +1,170 @@
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "base/config/float.h"
+#include "modeling/cylinder_plasma.h"
+#include "modeling/cylinder_plasma_quartz.h"
+#include "modeling/energy_balance.h"
+#include "modeling/solve_timings.h"
+#include "physics/absorption_table.h"
+
+namespace py = pybind11;
+
+namespace {
+
+/// Params(**kwargs): поля по имени, band=I задаёт nu и d_nu (IndexError
+/// за пределами таблицы).
+template <typename Params>
+[[nodiscard]] Params MakeParams(const py::kwargs& kwargs) {
+  Params params;
+  const auto self = py::cast(&params, py::return_value_policy::reference);
+  for (const auto& [key, value] : kwargs) {
+    if (key.cast<std::string>() == "band") {
+      const auto band =
+          AbsorptionTable::Default().BandCenter(value.cast<std::size_t>());
+      params.nu = static_cast<Float>(band.nu);
+      params.d_nu = static_cast<Float>(band.d_nu);
+    } else {
+      py::setattr(self, key, value);
+    }
+  }
+  return params;
+}
+
+/// Массив NumPy только для чтения поверх вектора результата, без
+/// копирования. owner — Python-объект Result: массив держит его живым.
+[[nodiscard]] py::array_t<Float> View(const std::vector<Float>& values,
+                                      py::handle owner) {
+  py::array_t<Float> array{static_cast<py::ssize_t>(values.size()),
+                           values.data(), owner};
+  array.attr("setflags")(py::arg("write") = false);
+  return array;
+}
+
+template <typename Result>
+void DefArray(py::class_<Result>& cls,
+              const char* name,
+              std::vector<Float> Result::*member) {
+  cls.def_property_readonly(name, [member](const py::object& self) {
+    return View(self.cast<const Result&>().*member, self);
+  });
+}
+
+/// Решатель Name с вложенными Name.Params и Name.Result и функция
+/// solve(params); def_fields(py::class_<Params>&) описывает поля Params.
+template <typename Solver, typename DefFields>
+void BindSolver(py::module_& m, const char* name, DefFields&& def_fields) {
+  using Params = typename Solver::Params;
+  using Result = typename Solver::Result;
+
+  py::class_<Solver> solver{m, name};
+  solver.def(py::init<const Params&>(), py::arg("params"))
+      .def(
+          "solve", [](Solver& self) { return self.Solve(); },
+          py::call_guard<py::gil_scoped_release>(),
+          "Решает задачу; GIL отпущен на всё время расчёта.");
+
+  py::class_<Params> params{solver, "Params"};
+  params.def(py::init(&MakeParams<Params>));
+  def_fields(params);
+
+  py::class_<Result> result{solver, "Result"};
+  DefArray(result, "absorbed_plasma", &Result::absorbed_plasma);
+  DefArray(result, "absorbed_plasma3", &Result::absorbed_plasma3);
+  if constexpr (requires { &Result::absorbed_quartz; }) {
+    DefArray(result, "absorbed_quartz", &Result::absorbed_quartz);
+    DefArray(result, "absorbed_quartz3", &Result::absorbed_quartz3);
+  }
+  result.def_readonly("absorbed_mirror", &Result::absorbed_mirror)
+      .def_readonly("intensity_all", &Result::intensity_all)
+      .def_readonly("balance", &Result::balance)
+      .def_readonly("timings", &Result::timings);
+
+  m.def(
+      "solve",
+      [](const Params& p) { return Solver{p}.Solve(); },
+      py::arg("params"), py::call_guard<py::gil_scoped_release>());
+  m.def(
+      "solve_batch",
+      [](const std::vector<Params>& p) { return Solver::SolveBatch(p); },
+      py::arg("params"), py::call_guard<py::gil_scoped_release>(),
+      "Результаты в порядке params; общее для вариантов считается один "
+      "раз.");
+}
+
+}  // namespace
+
+PYBIND11_MODULE(mt, m) {
+  m.doc() = "Перенос излучения в цилиндрической плазме Xe (modeling).";
+  // Плохой MT_ABSORPTION_TABLE — ImportError здесь, а не исключение из
+  // потока трассировки посреди решения.
+  static_cast<void>(AbsorptionTable::Default());
+
+  m.attr("float_size") = sizeof(Float);
+  m.def("n_bands", [] { return AbsorptionTable::Default().n_bands(); });
+  m.def("band", &Band, py::arg("band"), "(nu, d_nu) полосы band.");
+
+  py::class_<EnergyBalance>(m, "EnergyBalance")
+      .def_readonly("absorbed_plasma", &EnergyBalance::absorbed_plasma)
+      .def_readonly("absorbed_quartz", &EnergyBalance::absorbed_quartz)
+      .def_readonly("absorbed_mirror", &EnergyBalance::absorbed_mirror)
+      .def_readonly("truncated_plasma", &EnergyBalance::truncated_plasma)
+      .def_readonly("truncated_quartz", &EnergyBalance::truncated_quartz)
+      .def_readonly("truncated_mirror", &EnergyBalance::truncated_mirror)
+      .def_readonly("residual", &EnergyBalance::residual);
+
+  py::class_<SolveTimings>(m, "SolveTimings")
+      .def_readonly("emission", &SolveTimings::emission)
+      .def_readonly("transport", &SolveTimings::transport)
+      .def_readonly("post", &SolveTimings::post);
+
+  BindSolver<CylinderPlasma>(m, "CylinderPlasma", [](auto& params) {
+    using P = CylinderPlasma::Params;
+    params.def_readwrite("r", &P::r)
+        .def_readwrite("n_plasma", &P::n_plasma)
+        .def_readwrite("plasma_grading", &P::plasma_grading)
+        .def_readwrite("adaptive_plasma", &P::adaptive_plasma)
+        .def_readwrite("t0", &P::t0)
+        .def_readwrite("tw", &P::tw)
+        .def_readwrite("m", &P::m)
+        .def_readwrite("rho", &P::rho)
+        .def_readwrite("nu", &P::nu)
+        .def_readwrite("d_nu", &P::d_nu)
+        .def_readwrite("n_meridian", &P::n_meridian)
+        .def_readwrite("n_latitude", &P::n_latitude)
+        .def_readwrite("n_threads", &P::n_threads)
+        .def_readwrite("i_crit", &P::i_crit)
+        .def_readwrite("energy_tolerance", &P::energy_tolerance);
+  });
+
+  BindSolver<CylinderPlasmaQuartz>(
+      m, "CylinderPlasmaQuartz", [](auto& params) {
+        using P = CylinderPlasmaQuartz::Params;
+        params.def_readwrite("r", &P::r)
+            .def_readwrite("n_plasma", &P::n_plasma)
+            .def_readwrite("delta", &P::delta)
+            .def_readwrite("n_quartz", &P::n_quartz)
+            .def_readwrite("plasma_grading", &P::plasma_grading)
+            .def_readwrite("adaptive_plasma", &P::adaptive_plasma)
+            .def_readwrite("quartz_grading", &P::quartz_grading)
+            .def_readwrite("t0", &P::t0)
+            .def_readwrite("tw", &P::tw)
+            .def_readwrite("m", &P::m)
+            .def_readwrite("t1", &P::t1)
+            .def_readwrite("eta_plasma", &P::eta_plasma)
+            .def_readwrite("eta_quartz", &P::eta_quartz)
+            .def_readwrite("rho", &P::rho)
+            .def_readwrite("nu", &P::nu)
+            .def_readwrite("d_nu", &P::d_nu)
+            .def_readwrite("n_meridian", &P::n_meridian)
+            .def_readwrite("n_latitude", &P::n_latitude)
+            .def_readwrite("n_threads", &P::n_threads)
+            .def_readwrite("i_crit", &P::i_crit)
+            .def_readwrite("energy_tolerance", &P::energy_tolerance);
+      });
+}
@@ -0,0 +1,74 @@
+import sys
+import threading
+import unittest
+
+import numpy as np
+
+import mt
+
+
+def params(**kwargs):
+    return mt.CylinderPlasmaQuartz.Params(
+        band=169, n_meridian=10, n_latitude=10, **kwargs)
+
+
+class ModuleTest(unittest.TestCase):
+    def test_params(self):
+        p = params(r=0.5)
+        self.assertEqual(p.r, 0.5)
+        self.assertEqual(p.n_meridian, 10)
+        self.assertEqual((p.nu, p.d_nu), mt.band(169))
+        with self.assertRaises(AttributeError):
+            params(no_such_field=1)
+        with self.assertRaises(IndexError):
+            mt.band(mt.n_bands())
+
+    def test_arrays_are_views(self):
+        r = mt.solve(params())
+        a = r.absorbed_quartz
+        self.assertIsInstance(a, np.ndarray)
+        self.assertEqual(a.size, params().n_quartz + 1)
+        self.assertFalse(a.flags.writeable)
+        self.assertFalse(a.flags.owndata)
+        # Один и тот же буфер результата при каждом обращении.
+        self.assertEqual(a.ctypes.data, r.absorbed_quartz.ctypes.data)
+        # Массив держит результат живым.
+        refs = sys.getrefcount(r)
+        b = r.absorbed_plasma
+        self.assertGreater(sys.getrefcount(r), refs)
+        del r
+        self.assertTrue(np.all(np.isfinite(b)))
+
+    def test_same_as_solver(self):
+        a = mt.solve(params())
+        b = mt.CylinderPlasmaQuartz(params()).solve()
+        np.testing.assert_array_equal(a.absorbed_plasma, b.absorbed_plasma)
+        self.assertEqual(a.intensity_all, b.intensity_all)
+        self.assertEqual(a.balance.residual, b.balance.residual)
+
+    def test_solve_batch(self):
+        ps = [params(rho=rho) for rho in (0.5, 0.95)] + [params(m=8)]
+        results = mt.solve_batch(ps)
+        self.assertEqual(len(results), len(ps))
+        for p, r in zip(ps, results):
+            np.testing.assert_array_equal(r.absorbed_quartz,
+                                          mt.solve(p).absorbed_quartz)
+
+    def test_threads(self):
+        expected = mt.solve(params(m=8)).absorbed_plasma.copy()
+        results = [None] * 4
+
+        def run(i):
+            results[i] = mt.solve(params(m=8, n_threads=1))
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        for r in results:
+            np.testing.assert_array_equal(r.absorbed_plasma, expected)
+
+
+if __name__ == '__main__':
+    unittest.main()
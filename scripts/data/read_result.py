@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+
+# Читает двоичный файл результатов MT (--output, см. io/result_file.h)
+# без копирования и печатает его как CSV. С numpy то же самое:
+#   np.memmap(path, '<f8', 'r', offset=32).reshape(-1, width)
+
+import argparse
+import mmap
+import struct
+
+HEADER = struct.Struct('<8s6I')
+MAGIC = b'MTRESULT'
+VERSION = 1
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser()
+    parser.add_argument('filename')
+
+    args = parser.parse_args()
+
+    with open(args.filename, 'rb') as file:
+        data = mmap.mmap(file.fileno(), 0, access=mmap.ACCESS_READ)
+
+    magic, version, header_size, n_scalars, n_plasma, n_quartz, _ = \
+        HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION:
+        raise SystemExit(f'{args.filename}: not a version {VERSION} result')
+
+    width = n_scalars + 2 * (n_plasma + n_quartz)
+    rows = (len(data) - header_size) // (8 * width)
+    values = memoryview(data)[header_size:header_size + rows * width * 8]
+    values = values.cast('d')
+
+    columns = ['band', 'nu', 'd_nu', 'intensity_all', 'absorbed_mirror',
+               'residual']
+    for name, n in (('plasma', n_plasma), ('plasma3', n_plasma),
+                    ('quartz', n_quartz), ('quartz3', n_quartz)):
+        columns += [f'{name}_{i}' for i in range(n)]
+    print(','.join(columns))
+
+    for row in range(rows):
+        line = values[row * width:(row + 1) * width].tolist()
+        print(','.join([str(int(line[0]))] + [repr(v) for v in line[1:]]))
+
+    values.release()
+    data.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+
+# Клиент демона MT serve (протокол — cli/include/cli/protocol.h).
+#
+#   with Client('/tmp/mt.sock') as mt:
+#       r = mt.solve('xe-sio2', band=169, n_meridian=50)
+#       rs = mt.solve_many('xe', [{'band': b} for b in range(100, 200)])
+#
+# solve_many отправляет все запросы сразу и не ждёт ответа на каждый.
+# Из командной строки: mt_client.py SOCKET MODEL key=value ...
+
+import argparse
+import array
+import socket
+import struct
+
+MODELS = {'xe': 0, 'xe-sio2': 1}
+
+LENGTH = struct.Struct('<I')
+REQUEST = struct.Struct('<IB')
+REPLY = struct.Struct('<IB')
+SCALARS = struct.Struct('<3d2I')
+
+
+class Error(Exception):
+    pass
+
+
+def _array(data: bytes, offset: int, n: int) -> tuple[array.array, int]:
+    values = array.array('d')
+    values.frombytes(data[offset:offset + 8 * n])
+    return values, offset + 8 * n
+
+
+def _parse_reply(data: bytes) -> tuple[int, dict]:
+    request_id, status = REPLY.unpack_from(data)
+    if status != 0:
+        return request_id, {'error': data[REPLY.size:].decode()}
+    intensity_all, absorbed_mirror, residual, n_plasma, n_quartz = \
+        SCALARS.unpack_from(data, REPLY.size)
+    result = {
+        'intensity_all': intensity_all,
+        'absorbed_mirror': absorbed_mirror,
+        'residual': residual,
+    }
+    offset = REPLY.size + SCALARS.size
+    for name, n in (('absorbed_plasma', n_plasma),
+                    ('absorbed_plasma3', n_plasma),
+                    ('absorbed_quartz', n_quartz),
+                    ('absorbed_quartz3', n_quartz)):
+        result[name], offset = _array(data, offset, n)
+    return request_id, result
+
+
+class Client:
+    def __init__(self, path: str) -> None:
+        self._socket = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self._socket.connect(path)
+        self._file = self._socket.makefile('rb')
+        self._next_id = 0
+
+    def __enter__(self) -> 'Client':
+        return self
+
+    def __exit__(self, *args) -> None:
+        self.close()
+
+    def close(self) -> None:
+        self._file.close()
+        self._socket.close()
+
+    def solve(self, model: str, **params) -> dict:
+        return self.solve_many(model, [params])[0]
+
+    def solve_many(self, model: str, jobs: list[dict]) -> list[dict]:
+        """Результаты в порядке jobs; ошибка сервера — исключение Error."""
+        ids = []
+        frames = bytearray()
+        for params in jobs:
+            settings = ' '.join(f'{k}={v}' for k, v in params.items())
+            body = REQUEST.pack(self._next_id, MODELS[model]) + \
+                settings.encode()
+            frames += LENGTH.pack(len(body)) + body
+            ids.append(self._next_id)
+            self._next_id = (self._next_id + 1) % 2**32
+        self._socket.sendall(frames)
+
+        results = {}
+        for _ in ids:
+            header = self._file.read(LENGTH.size)
+            if len(header) < LENGTH.size:
+                raise Error('connection closed')
+            (size,) = LENGTH.unpack(header)
+            request_id, result = _parse_reply(self._file.read(size))
+            results[request_id] = result
+
+        for request_id in ids:
+            if 'error' in results[request_id]:
+                raise Error(results[request_id]['error'])
+        return [results[request_id] for request_id in ids]
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser()
+    parser.add_argument('socket')
+    parser.add_argument('model', choices=MODELS)
+    parser.add_argument('params', nargs='*', help='key=value')
+
+    args = parser.parse_args()
+
+    params = dict(param.split('=', 1) for param in args.params)
+    with Client(args.socket) as mt:
+        result = mt.solve(args.model, **params)
+    for key, value in result.items():
+        if isinstance(value, array.array):
+            value = ' '.join(repr(v) for v in value)
+        print(key, value)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,46 @@
+#include <exception>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <span>
+
+#include "io/atomic_file.h"
+#include "physics/absorption_table.h"
+
+// Usage: absorption_table <out.bin> [table.txt]
+//
+// Записывает таблицу коэффициента поглощения в двоичном формате
+// AbsorptionTable (для MT_ABSORPTION_TABLE): из текстового файла формата
+// docs/коэффициент_поглощения_Xe.txt или, без него, встроенную таблицу
+// ксенона.
+int main(int argc, char* argv[]) {
+  const std::span args{argv, static_cast<std::size_t>(argc)};
+  if (args.size() < 2 || args.size() > 3) {
+    std::cerr << "Usage: " << args[0] << " <out.bin> [table.txt]\n";
+    return 1;
+  }
+
+  try {
+    const auto write = [&](const AbsorptionTable& table) {
+      WriteFileAtomically(args[1], table.Serialize());
+      std::cout << std::format("{}: {} temperatures [{}, {}] K, {} bands\n",
+                               args[1], table.temperature().size(),
+                               table.temperature().front(),
+                               table.temperature().back(), table.n_bands());
+    };
+
+    if (args.size() == 3) {
+      std::ifstream in{args[2]};
+      if (!in) {
+        std::cerr << "Can't open " << args[2] << '\n';
+        return 1;
+      }
+      write(AbsorptionTable::FromText(in));
+    } else {
+      write(AbsorptionTable::Xenon());
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/config/float.h"
+#include "geogebra/api.h"
+#include "math/linalg/vector.h"
+#include "modeling/ray_path.h"
+
+namespace {
+
+[[nodiscard]] std::string_view EventName(RayPathEvent event) {
+  switch (event) {
+    case RayPathEvent::kStart:
+      return "start";
+    case RayPathEvent::kStep:
+      return "step";
+    case RayPathEvent::kReflect:
+      return "reflect";
+    case RayPathEvent::kRelease:
+      return "release";
+    case RayPathEvent::kEnd:
+      return "end";
+  }
+  return "?";
+}
+
+[[nodiscard]] Vec3 Pos(const RayPathRecord& record) {
+  return {record.pos[0], record.pos[1], record.pos[2]};
+}
+
+}  // namespace
+
+// Usage: ray_path_to_geogebra <MT_RAY_PATH file> [ray...]
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <ray path file> [ray...]\n";
+    return 1;
+  }
+
+  try {
+    const auto path = ReadRayPath(argv[1]);
+
+    std::vector<std::uint32_t> rays;
+    for (int i = 2; i < argc; ++i) {
+      rays.push_back(static_cast<std::uint32_t>(std::stoul(argv[i])));
+    }
+
+    for (std::size_t i = 0; i < path.plasma_radii.size(); ++i) {
+      std::cout << geogebra::CylinderInfiniteZ(std::format("c{}", i),
+                                               path.plasma_radii[i]);
+    }
+    for (std::size_t i = 0; i < path.quartz_radii.size(); ++i) {
+      std::cout << geogebra::CylinderInfiniteZ(std::format("q{}", i),
+                                               path.quartz_radii[i]);
+    }
+
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < path.records.size(); ++i) {
+      const auto& record = path.records[i];
+      if (!rays.empty() && std::ranges::find(rays, record.ray) == rays.end()) {
+        continue;
+      }
+
+      const auto first = i == 0 || path.records[i - 1].ray != record.ray;
+      k = first ? 0 : k + 1;
+      // Подлуч начинается с kStart: с концом предыдущего его не соединять.
+      const auto joined = !first && record.event != RayPathEvent::kStart;
+
+      const auto point = std::format("P{}n{}", record.ray, k);
+      std::cout << std::format(
+          "<!-- ray={} {} {} shell={} I={} -->\n", record.ray,
+          EventName(record.event),
+          record.body == RayPathBody::kPlasma ? "plasma" : "quartz",
+          record.shell, record.intensity);
+      std::cout << geogebra::Point3D(point, Pos(record));
+
+      if (joined) {
+        const auto& prev = path.records[i - 1];
+        const auto prev_point = std::format("P{}n{}", record.ray, k - 1);
+        const auto dir = std::format("D{}n{}", record.ray, k - 1);
+        std::cout << geogebra::Point3D(dir, Pos(record) - Pos(prev));
+        std::cout << geogebra::Ray3D(std::format("r{}n{}", record.ray, k),
+                                     prev_point, dir);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+}